@@ -11,5 +11,11 @@ public class ClimbingSystemTarget : TargetRules
 		DefaultBuildSettings = BuildSettingsVersion.V2;
 		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_1;
 		ExtraModuleNames.Add("ClimbingSystem");
+
+		// The Gauntlet soak stays out of shipping builds
+		if (Target.Configuration != UnrealTargetConfiguration.Shipping)
+		{
+			ExtraModuleNames.Add("ClimbingSystemSoak");
+		}
 	}
 }
@@ -0,0 +1,21 @@
+#include "ClimbingDiagnostics.h"
+#include "HAL/IConsoleManager.h"
+
+#if CLIMB_DIAGNOSTICS
+
+int32 ClimbDiagnostics::GLogEnabled = 0;
+int32 ClimbDiagnostics::GVisualLogEnabled = 0;
+
+static FAutoConsoleVariableRef CVarClimbDiagnosticsLog(
+	TEXT("Climbing.Diagnostics.Log"),
+	ClimbDiagnostics::GLogEnabled,
+	TEXT("Log climb decisions and transitions to LogClimbing."),
+	ECVF_Cheat);
+
+static FAutoConsoleVariableRef CVarClimbDiagnosticsVisualLog(
+	TEXT("Climbing.Diagnostics.VisualLog"),
+	ClimbDiagnostics::GVisualLogEnabled,
+	TEXT("Record climb probes, surface normals and transitions in the Visual Logger."),
+	ECVF_Cheat);
+
+#endif
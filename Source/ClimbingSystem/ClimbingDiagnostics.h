@@ -0,0 +1,45 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ClimbingSystem.h"
+#include "VisualLogger/VisualLogger.h"
+
+/* Climb logging and visual logging, compiled out entirely in Test and Shipping */
+#define CLIMB_DIAGNOSTICS !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
+
+#if CLIMB_DIAGNOSTICS
+
+namespace ClimbDiagnostics
+{
+	/* Climbing.Diagnostics.Log */
+	extern CLIMBINGSYSTEM_API int32 GLogEnabled;
+
+	/* Climbing.Diagnostics.VisualLog */
+	extern CLIMBINGSYSTEM_API int32 GVisualLogEnabled;
+}
+
+/* Arguments are only evaluated while the matching cvar is on */
+#define CLIMB_LOG(Verbosity, Format, ...) \
+	do { if(ClimbDiagnostics::GLogEnabled) { UE_LOG(LogClimbing, Verbosity, Format, ##__VA_ARGS__); } } while(0)
+
+#define CLIMB_VLOG(Owner, Format, ...) \
+	do { if(ClimbDiagnostics::GVisualLogEnabled) { UE_VLOG(Owner, LogClimbing, Log, Format, ##__VA_ARGS__); } } while(0)
+
+#define CLIMB_VLOG_LOCATION(Owner, Location, Radius, Color, Format, ...) \
+	do { if(ClimbDiagnostics::GVisualLogEnabled) { UE_VLOG_LOCATION(Owner, LogClimbing, Log, Location, Radius, Color, Format, ##__VA_ARGS__); } } while(0)
+
+#define CLIMB_VLOG_ARROW(Owner, Start, End, Color, Format, ...) \
+	do { if(ClimbDiagnostics::GVisualLogEnabled) { UE_VLOG_ARROW(Owner, LogClimbing, Log, Start, End, Color, Format, ##__VA_ARGS__); } } while(0)
+
+#define CLIMB_VLOG_SEGMENT(Owner, Start, End, Color, Format, ...) \
+	do { if(ClimbDiagnostics::GVisualLogEnabled) { UE_VLOG_SEGMENT(Owner, LogClimbing, Log, Start, End, Color, Format, ##__VA_ARGS__); } } while(0)
+
+#else
+
+#define CLIMB_LOG(Verbosity, Format, ...)
+#define CLIMB_VLOG(Owner, Format, ...)
+#define CLIMB_VLOG_LOCATION(Owner, Location, Radius, Color, Format, ...)
+#define CLIMB_VLOG_ARROW(Owner, Start, End, Color, Format, ...)
+#define CLIMB_VLOG_SEGMENT(Owner, Start, End, Color, Format, ...)
+
+#endif
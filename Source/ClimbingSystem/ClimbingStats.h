@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Trace/Trace.h"
+#include "HAL/LowLevelMemTracker.h"
+
+DECLARE_STATS_GROUP(TEXT("Climbing"), STATGROUP_Climbing, STATCAT_Advanced);
+
+/* Insights channel, enable with -trace=cpu,climbing */
+UE_TRACE_CHANNEL_EXTERN(ClimbingChannel, CLIMBINGSYSTEM_API);
+
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(CLIMBINGSYSTEM_API, Climbing);
+
+/* Low level memory tracker tag for everything the climb allocates, see it with -llm and stat LLMFULL */
+LLM_DECLARE_TAG_API(Climbing, CLIMBINGSYSTEM_API);
+
+/* Time a scope in the stat group, the CSV profiler and on the Insights climbing channel at once */
+#define CLIMB_SCOPE_CYCLE_COUNTER(Stat) \
+	SCOPE_CYCLE_COUNTER(Stat); \
+	CSV_SCOPED_TIMING_STAT(Climbing, Stat); \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(Stat, ClimbingChannel)
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Climbers Active"), STAT_ClimbersActive, STATGROUP_Climbing, CLIMBINGSYSTEM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Climb Traces Issued"), STAT_ClimbTracesIssued, STATGROUP_Climbing, CLIMBINGSYSTEM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Climb Trace Hits"), STAT_ClimbTraceHits, STATGROUP_Climbing, CLIMBINGSYSTEM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Climbers Sleeping"), STAT_ClimbersSleeping, STATGROUP_Climbing, CLIMBINGSYSTEM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Climbers Batched"), STAT_ClimbersBatched, STATGROUP_Climbing, CLIMBINGSYSTEM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Characters Holding Climb Montages"), STAT_ClimbMontageHolders, STATGROUP_Climbing, CLIMBINGSYSTEM_API);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Climb Simulation Serial"), STAT_ClimbSimSerial, STATGROUP_Climbing, CLIMBINGSYSTEM_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Climb Simulation Parallel"), STAT_ClimbSimParallel, STATGROUP_Climbing, CLIMBINGSYSTEM_API);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Climbers Reduced LOD"), STAT_ClimbersReducedLOD, STATGROUP_Climbing, CLIMBINGSYSTEM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Climbers Surface Locked LOD"), STAT_ClimbersSurfaceLockedLOD, STATGROUP_Climbing, CLIMBINGSYSTEM_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Climbers Frozen LOD"), STAT_ClimbersFrozenLOD, STATGROUP_Climbing, CLIMBINGSYSTEM_API);
@@ -15,6 +15,14 @@ public class ClimbingSystem : ModuleRules
 			"InputCore", 
 			"HeadMountedDisplay", 
 			"EnhancedInput",
-			"MotionWarping" });
+			"MotionWarping",
+			"MassEntity",
+			"MassCommon",
+			"MassSpawner",
+			"SignificanceManager",
+			"AnimationBudgetAllocator",
+			"DeveloperSettings",
+			"PhysicsCore",
+			"Json" });
 	}
 }
@@ -1,7 +1,26 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "ClimbingSystem.h"
+#include "ClimbingStats.h"
 #include "Modules/ModuleManager.h"
 
+DEFINE_LOG_CATEGORY(LogClimbing);
+
+UE_TRACE_CHANNEL_DEFINE(ClimbingChannel);
+CSV_DEFINE_CATEGORY_MODULE(CLIMBINGSYSTEM_API, Climbing, true);
+LLM_DEFINE_TAG(Climbing);
+
+DEFINE_STAT(STAT_ClimbersActive);
+DEFINE_STAT(STAT_ClimbTracesIssued);
+DEFINE_STAT(STAT_ClimbTraceHits);
+DEFINE_STAT(STAT_ClimbersSleeping);
+DEFINE_STAT(STAT_ClimbersBatched);
+DEFINE_STAT(STAT_ClimbMontageHolders);
+DEFINE_STAT(STAT_ClimbSimSerial);
+DEFINE_STAT(STAT_ClimbSimParallel);
+DEFINE_STAT(STAT_ClimbersReducedLOD);
+DEFINE_STAT(STAT_ClimbersSurfaceLockedLOD);
+DEFINE_STAT(STAT_ClimbersFrozenLOD);
+
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, ClimbingSystem, "ClimbingSystem" );
  
\ No newline at end of file
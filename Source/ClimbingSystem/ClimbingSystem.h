@@ -3,3 +3,8 @@
 #pragma once
 
 #include "CoreMinimal.h"
+
+CLIMBINGSYSTEM_API DECLARE_LOG_CATEGORY_EXTERN(LogClimbing, Log, All);
+
+/** Trace channel only geometry that opted in to climbing responds to, with an overlap so multi traces return every surface, see Config/DefaultEngine.ini */
+#define ECC_Climbable ECC_GameTraceChannel1
@@ -10,16 +10,18 @@
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
 #include "MotionWarpingComponent.h"
-
-#include "DebugHelper.h"
-#include "debugging.h"
+#include "Components/ClimbSessionRecorderComponent.h"
+#include "Components/ClimbingMeshComponent.h"
+#include "Net/UnrealNetwork.h"
 
 
 //////////////////////////////////////////////////////////////////////////
 // AClimbingSystemCharacter
 
 AClimbingSystemCharacter::AClimbingSystemCharacter(const FObjectInitializer &ObjectInitializer) 
-	: Super(ObjectInitializer.SetDefaultSubobjectClass<UCustomMovementComponent>(ACharacter::CharacterMovementComponentName))
+	: Super(ObjectInitializer
+		.SetDefaultSubobjectClass<UCustomMovementComponent>(ACharacter::CharacterMovementComponentName)
+		.SetDefaultSubobjectClass<UClimbingMeshComponent>(ACharacter::MeshComponentName))
 {	
 	
 	// Set size for collision capsule
@@ -55,6 +57,14 @@ AClimbingSystemCharacter::AClimbingSystemCharacter(const FObjectInitializer &Obj
 	FollowCamera->bUsePawnControlRotation = false; // Camera does not rotate relative to arm
 
 	MotionWarpingComponent = CreateDefaultSubobject<UMotionWarpingComponent>(TEXT("Motion Wraping Component"));
+
+	ClimbSessionRecorder = CreateDefaultSubobject<UClimbSessionRecorderComponent>(TEXT("Climb Session Recorder"));
+
+	// The movement component knows what the climber is doing and sets the mesh's significance itself
+	if(USkeletalMeshComponentBudgeted* BudgetedMesh = Cast<USkeletalMeshComponentBudgeted>(GetMesh()))
+	{
+		BudgetedMesh->SetAutoCalculateSignificance(false);
+	}
 }
 
 void AClimbingSystemCharacter::BeginPlay()
@@ -73,6 +83,30 @@ void AClimbingSystemCharacter::BeginPlay()
 
 }
 
+void AClimbingSystemCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	// Owners predict their own climb, only proxies need it
+	DOREPLIFETIME_CONDITION(AClimbingSystemCharacter, ReplicatedClimbState, COND_SimulatedOnly);
+}
+
+void AClimbingSystemCharacter::SetReplicatedClimbState(const FClimbReplicatedState& NewState)
+{
+	if(ReplicatedClimbState != NewState)
+	{
+		ReplicatedClimbState = NewState;
+	}
+}
+
+void AClimbingSystemCharacter::OnRep_ReplicatedClimbState()
+{
+	if(CustomMovementComponent)
+	{
+		CustomMovementComponent->ApplyReplicatedClimbState(ReplicatedClimbState);
+	}
+}
+
 void AClimbingSystemCharacter::AddInputMappingContext(UInputMappingContext *ContyextToAdd, int32 IntPriority)
 {
 	if(!ContyextToAdd) return;
@@ -109,7 +143,7 @@ void AClimbingSystemCharacter::SetupPlayerInputComponent(class UInputComponent *
 	if (UEnhancedInputComponent* EnhancedInputComponent = CastChecked<UEnhancedInputComponent>(PlayerInputComponent)) {
 		
 		//Jumping
-		EnhancedInputComponent->BindAction(JumpAction, ETriggerEvent::Triggered, this, &ACharacter::Jump);
+		EnhancedInputComponent->BindAction(JumpAction, ETriggerEvent::Triggered, this, &AClimbingSystemCharacter::OnJumpActionTriggered);
 		EnhancedInputComponent->BindAction(JumpAction, ETriggerEvent::Completed, this, &ACharacter::StopJumping);
 
 		//Moving
@@ -137,6 +171,11 @@ void AClimbingSystemCharacter::HandleGroundMovementInput(const FInputActionValue
 	// input is a Vector2D
 	const FVector2D MovementVector = Value.Get<FVector2D>();
 
+	if (ClimbSessionRecorder)
+	{
+		ClimbSessionRecorder->CaptureMoveInput(MovementVector);
+	}
+
 	if (Controller != nullptr)
 	{
 		// find out which way is forward
@@ -159,6 +198,11 @@ void AClimbingSystemCharacter::HandleClimbMovementInput(const FInputActionValue
 {
 	// input is a Vector2D
 	const FVector2D MovementVector = Value.Get<FVector2D>();
+
+	if (ClimbSessionRecorder)
+	{
+		ClimbSessionRecorder->CaptureClimbMoveInput(MovementVector);
+	}
 	
 	const FVector ForwardDirection = FVector::CrossProduct(
 		-CustomMovementComponent->GetClimbableSurfaceNormal(),
@@ -191,34 +235,93 @@ void AClimbingSystemCharacter::Look(const FInputActionValue& Value)
 void AClimbingSystemCharacter::onClimbActionStarted(const FInputActionValue &Value)
 {
 	if(!CustomMovementComponent)return ;
-	if(!CustomMovementComponent->IsClimbing())
+
+	if(ClimbSessionRecorder)
 	{
-		CustomMovementComponent->ToggleClimbing(true);
+		ClimbSessionRecorder->CaptureButton(EClimbSessionButton::Climb);
 	}
-	else
-	{
-		CustomMovementComponent->ToggleClimbing(false);
-	}	
+
+	// Starts or stops climbing inside the next move so it is predicted
+	CustomMovementComponent->RequestClimbToggle();
 }
 
 
 
 void AClimbingSystemCharacter::OnPlayerEnterClimbState()
 {	
-	// Debug::Print(TEXT("Entered Climb State"));
 	AddInputMappingContext(ClimbMappingContext,1);
 }
 
 void AClimbingSystemCharacter::OnPlayerExitClimbState()
 {	
-	// Debug::Print(TEXT("Exited Climb State"));
 	RemoveInputMappingContext(ClimbMappingContext);
 }
 
 void AClimbingSystemCharacter::onClimbHopActionStarted(const FInputActionValue &Value)
 {
+	if(ClimbSessionRecorder)
+	{
+		ClimbSessionRecorder->CaptureButton(EClimbSessionButton::Hop);
+	}
+
 	if(CustomMovementComponent)
 	{
-		CustomMovementComponent->RequestHopping();
+		CustomMovementComponent->RequestClimbHop();
+	}
+}
+
+void AClimbingSystemCharacter::OnJumpActionTriggered(const FInputActionValue& Value)
+{
+	// Triggered every frame the button is held, which is what a recorded frame's Jump means
+	if (ClimbSessionRecorder)
+	{
+		ClimbSessionRecorder->CaptureButton(EClimbSessionButton::Jump);
+	}
+
+	Jump();
+}
+
+void AClimbingSystemCharacter::NotifyControllerChanged()
+{
+	Super::NotifyControllerChanged();
+
+	if (ClimbSessionRecorder)
+	{
+		ClimbSessionRecorder->OnCharacterControllerChanged();
+	}
+}
+
+void AClimbingSystemCharacter::ApplyClimbSessionInput(const FClimbSessionFrame& Frame)
+{
+	if (Controller != nullptr)
+	{
+		Controller->SetControlRotation(FRotator(Frame.ControlRotation));
+	}
+
+	if (!Frame.MoveInput.IsZero())
+	{
+		HandleGroundMovementInput(FInputActionValue(FVector2D(Frame.MoveInput)));
+	}
+	if (!Frame.ClimbMoveInput.IsZero())
+	{
+		HandleClimbMovementInput(FInputActionValue(FVector2D(Frame.ClimbMoveInput)));
+	}
+
+	if (EnumHasAnyFlags(Frame.Buttons, EClimbSessionButton::Climb))
+	{
+		onClimbActionStarted(FInputActionValue());
+	}
+	if (EnumHasAnyFlags(Frame.Buttons, EClimbSessionButton::Hop))
+	{
+		onClimbHopActionStarted(FInputActionValue());
+	}
+
+	if (EnumHasAnyFlags(Frame.Buttons, EClimbSessionButton::Jump))
+	{
+		Jump();
+	}
+	else
+	{
+		StopJumping();
 	}
 }
\ No newline at end of file
@@ -5,11 +5,14 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
 #include "InputActionValue.h"
+#include "Climbing/ClimbReplicatedState.h"
+#include "Climbing/ClimbSession.h"
 #include "ClimbingSystemCharacter.generated.h"
 
 class UCustomMovementComponent;
 class USpringArmComponent;
 class UMotionWarpingComponent;
+class UClimbSessionRecorderComponent;
 class UCameraComponent;
 class UInputMappingContext;
 class UInputAction;
@@ -38,8 +41,21 @@ private:
 	
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Movement, meta = (AllowPrivateAccess = "true"))
 	UCustomMovementComponent* CustomMovementComponent;
+
+	/** Records and replays climb sessions, idle unless asked to */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Movement, meta = (AllowPrivateAccess = "true"))
+	UClimbSessionRecorderComponent* ClimbSessionRecorder;
 #pragma endregion
 	
+#pragma region Replication
+	/** Climb state for simulated proxies, written by the movement component on the server */
+	UPROPERTY(ReplicatedUsing = OnRep_ReplicatedClimbState)
+	FClimbReplicatedState ReplicatedClimbState;
+
+	UFUNCTION()
+	void OnRep_ReplicatedClimbState();
+#pragma endregion
+
 #pragma region InputActions
 
 	void OnPlayerEnterClimbState();
@@ -91,15 +107,27 @@ private:
 	void onClimbActionStarted(const FInputActionValue& Value);
 
 	void onClimbHopActionStarted(const FInputActionValue& Value);
+
+	void OnJumpActionTriggered(const FInputActionValue& Value);
 #pragma endregion
 	
 protected:
 	// APawn interface
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
+
+	virtual void NotifyControllerChanged() override;
 	
 	// To add mapping context
 	virtual void BeginPlay();
 
+public:
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	void SetReplicatedClimbState(const FClimbReplicatedState& NewState);
+
+	/** Feed one recorded frame of input through the same handlers the input actions call */
+	void ApplyClimbSessionInput(const FClimbSessionFrame& Frame);
+
 public:
 	/** Returns CameraBoom subobject **/
 	FORCEINLINE class USpringArmComponent* GetCameraBoom() const { return CameraBoom; }
@@ -109,4 +137,6 @@ public:
 	FORCEINLINE class UCustomMovementComponent* GetCustomeMovementComponent() const { return CustomMovementComponent; }
 	
 	FORCEINLINE class UMotionWarpingComponent* GetMotionWarpingComponent() const {return MotionWarpingComponent; }
+
+	FORCEINLINE class UClimbSessionRecorderComponent* GetClimbSessionRecorder() const {return ClimbSessionRecorder; }
 };
\ No newline at end of file
@@ -2,14 +2,63 @@
 
 #include "ClimbingSystemGameMode.h"
 #include "ClimbingSystemCharacter.h"
-#include "UObject/ConstructorHelpers.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "SignificanceManager.h"
 
 AClimbingSystemGameMode::AClimbingSystemGameMode()
 {
-	// set default pawn class to our Blueprinted character
-	static ConstructorHelpers::FClassFinder<APawn> PlayerPawnBPClass(TEXT("/Game/ThirdPerson/Blueprints/BP_ThirdPersonCharacter"));
-	if (PlayerPawnBPClass.Class != NULL)
+	// default pawn class to our Blueprinted character comes from DefaultGame.ini, see InitGame
+
+	// climb LOD needs the player views every frame
+	PrimaryActorTick.bCanEverTick = true;
+}
+
+void AClimbingSystemGameMode::InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage)
+{
+	// set default pawn class to our Blueprinted character before anything spawns, unless a subclass already picked one
+	const bool bDefaultPawnClassUnset = !DefaultPawnClass || DefaultPawnClass == GetDefault<AGameModeBase>()->DefaultPawnClass;
+	if (bDefaultPawnClassUnset && !DefaultPawnClassPath.IsNull())
+	{
+		if (UClass* PawnClass = DefaultPawnClassPath.LoadSynchronous())
+		{
+			DefaultPawnClass = PawnClass;
+		}
+	}
+
+	Super::InitGame(MapName, Options, ErrorMessage);
+}
+
+void AClimbingSystemGameMode::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld());
+	if (!SignificanceManager)
+	{
+		return;
+	}
+
+	// Every player's view, on a server that includes remote players so their surroundings stay at full rate
+	// Clients have no game mode, but their climbers are either their own or simulated proxies, neither uses a LOD tier
+	SignificanceViewpoints.Reset();
+	for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		const APlayerController* PlayerController = Iterator->Get();
+		if (!PlayerController)
+		{
+			continue;
+		}
+
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		SignificanceViewpoints.Emplace(ViewRotation, ViewLocation);
+	}
+
+	// Without a viewpoint climbers keep the tier they had
+	if (SignificanceViewpoints.Num() > 0)
 	{
-		DefaultPawnClass = PlayerPawnBPClass.Class;
+		SignificanceManager->Update(SignificanceViewpoints);
 	}
 }
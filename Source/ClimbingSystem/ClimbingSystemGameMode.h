@@ -6,13 +6,27 @@
 #include "GameFramework/GameModeBase.h"
 #include "ClimbingSystemGameMode.generated.h"
 
-UCLASS(minimalapi)
+UCLASS(minimalapi, config = Game)
 class AClimbingSystemGameMode : public AGameModeBase
 {
 	GENERATED_BODY()
 
 public:
 	AClimbingSystemGameMode();
+
+	virtual void InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage) override;
+
+	/* Feeds the significance manager every player's view, which picks the LOD tier of each climber */
+	virtual void Tick(float DeltaSeconds) override;
+
+protected:
+	/* Loaded when a game starts instead of with the class, so the editor and other game modes never pull the character in */
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Classes")
+	TSoftClassPtr<APawn> DefaultPawnClassPath;
+
+private:
+	/* Kept between frames so the update does not reallocate */
+	TArray<FTransform> SignificanceViewpoints;
 };
 
 
@@ -2,53 +2,38 @@
 
 
 #include "AnimInstance/CharacterAnimInstance.h"
-#include "ClimbingSystem/Public/AnimInstance/CharacterAnimInstance.h"
-#include "Components/CustomMovementComponent.h"
-#include "ClimbingSystem/ClimbingSystemCharacter.h"
-#include "Kismet/KismetMathLibrary.h"
 
 
-void UCharacterAnimInstance::NativeInitializeAnimation()
+// Usually runs on a worker thread, only the proxy is read here
+void UCharacterAnimInstance::NativeThreadSafeUpdateAnimation(float DeltaSeconds)
 {
-    Super::NativeInitializeAnimation();
-    ClimbingSystemCharacter = Cast<AClimbingSystemCharacter>(TryGetPawnOwner());
-
-    if(ClimbingSystemCharacter)
-    {
-        CustomMovementComponent = ClimbingSystemCharacter->GetCustomeMovementComponent();
-    }
-}
-
-void UCharacterAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
-{
-    Super::NativeUpdateAnimation(DeltaSeconds);
-
-    if(!ClimbingSystemCharacter || !CustomMovementComponent) return;
+    Super::NativeThreadSafeUpdateAnimation(DeltaSeconds);
 
     GetGroundSpeed();
     GetAirSpeed();
-    GetShouldMove();
     GetIsFalling();
+    GetShouldMove();
     GetIsClimbing();
     GetClimbVelocity();
+    GetLimbIKTargets();
 
 }
 // Calculates the ground speed by taking the 2D magnitude of the character's velocity.
 void UCharacterAnimInstance::GetGroundSpeed()
 {
-    GroundSpeed = UKismetMathLibrary::VSizeXY(ClimbingSystemCharacter->GetVelocity());
+    GroundSpeed = ClimbAnimProxy.Velocity.Size2D();
 }
 
 // Retrieves the vertical component of the character's velocity as the air speed.
 void UCharacterAnimInstance::GetAirSpeed()
 {
-    AirSpeed = ClimbingSystemCharacter->GetVelocity().Z;
+    AirSpeed = ClimbAnimProxy.Velocity.Z;
 }
 
 // Determines if the character should move based on acceleration, ground speed, and falling status.
 void UCharacterAnimInstance::GetShouldMove()
 {
-    bShouldMove =  CustomMovementComponent->GetCurrentAcceleration().Size() > 0 &&
+    bShouldMove =  ClimbAnimProxy.Acceleration.Size() > 0 &&
                    GroundSpeed > 5.f &&
                    !bIsFalling;
 }
@@ -56,13 +41,25 @@ void UCharacterAnimInstance::GetShouldMove()
 // Checks if the character is currently in a falling state.
 void UCharacterAnimInstance::GetIsFalling()
 {
-    bIsFalling = CustomMovementComponent->IsFalling();
+    bIsFalling = ClimbAnimProxy.bIsFalling;
 }
 void UCharacterAnimInstance::GetIsClimbing()
 {
-    bIsClimbing = CustomMovementComponent->IsClimbing();
+    bIsClimbing = ClimbAnimProxy.bIsClimbing;
 }
 void UCharacterAnimInstance::GetClimbVelocity()
 {
-    ClimbVelocity = CustomMovementComponent->GetUnrotatedClimbVelocity();
+    ClimbVelocity = ClimbAnimProxy.UnrotatedClimbVelocity;
+}
+// Limb targets of the climb, the alpha drops to zero whenever there are none
+void UCharacterAnimInstance::GetLimbIKTargets()
+{
+    const FClimbLimbTargets& Targets = ClimbAnimProxy.LimbTargets;
+    LimbIKAlpha = Targets.bValid ? 1.f : 0.f;
+    if(!Targets.bValid) return;
+
+    LeftHandIKTarget = Targets.Locations[static_cast<int32>(EClimbLimb::LeftHand)];
+    RightHandIKTarget = Targets.Locations[static_cast<int32>(EClimbLimb::RightHand)];
+    LeftFootIKTarget = Targets.Locations[static_cast<int32>(EClimbLimb::LeftFoot)];
+    RightFootIKTarget = Targets.Locations[static_cast<int32>(EClimbLimb::RightFoot)];
 }
@@ -0,0 +1,39 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Climbing/ClimbLimbs.h"
+#include "Climbing/ClimbMath.h"
+#include "Engine/HitResult.h"
+
+bool ClimbMath::FitSurfacePatch(TConstArrayView<FHitResult> Hits, float MinNormalDot, float MaxPlaneDistance, FPlane& OutPlane)
+{
+    FVector SurfaceLocation;
+    FVector SurfaceNormal;
+    ReduceClimbableSurface(Hits, SurfaceLocation, SurfaceNormal);
+    if(SurfaceNormal.IsZero())
+    {
+        OutPlane = FPlane(ForceInit);
+        return false;
+    }
+
+    OutPlane = FPlane(SurfaceLocation, SurfaceNormal);
+
+    for(const FHitResult& Hit : Hits)
+    {
+        if(FVector::DotProduct(Hit.ImpactNormal, SurfaceNormal) < MinNormalDot) return false;
+        if(FMath::Abs(OutPlane.PlaneDot(Hit.ImpactPoint)) > MaxPlaneDistance) return false;
+    }
+    return true;
+}
+
+void ClimbMath::PlaceLimbsOnPatch(TConstArrayView<FVector> RestPoints, const FPlane& Plane, FClimbLimbTargets& OutTargets)
+{
+    const FVector Normal = Plane.GetNormal();
+    const int32 NumLimbs = FMath::Min(RestPoints.Num(), static_cast<int32>(EClimbLimb::Num));
+    for(int32 Index = 0; Index < NumLimbs; ++Index)
+    {
+        OutTargets.Locations[Index] = RestPoints[Index] - Normal * Plane.PlaneDot(RestPoints[Index]);
+        OutTargets.Normals[Index] = Normal;
+    }
+    OutTargets.bValid = true;
+}
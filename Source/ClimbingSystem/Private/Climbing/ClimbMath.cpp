@@ -0,0 +1,118 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Climbing/ClimbMath.h"
+
+bool ClimbMath::FindEdgeAhead(const FVector& Location, const FVector& Forward, const FVector& EdgeStart, const FVector& EdgeEnd, const FVector& FacingNormal, float MaxDistance, FVector& OutEdgePoint, float& OutDistance)
+{
+    const FVector2D Forward2D = FVector2D(Forward).GetSafeNormal();
+    const FVector2D Normal2D = FVector2D(FacingNormal).GetSafeNormal();
+
+    // Must be facing into the edge, at most ~60 degrees off
+    const double Denominator = FVector2D::DotProduct(Forward2D, Normal2D);
+    if(Denominator > -0.5) return false;
+
+    const FVector2D Start2D(EdgeStart);
+    const double Distance = FVector2D::DotProduct(Start2D - FVector2D(Location), Normal2D) / Denominator;
+    if(Distance < 0.0 || Distance > MaxDistance) return false;
+
+    // Where the ray crosses the edge line, in [0, 1] when inside the segment
+    const FVector2D Hit = FVector2D(Location) + Forward2D * Distance;
+    const FVector2D Segment = FVector2D(EdgeEnd) - Start2D;
+    const double LengthSquared = Segment.SizeSquared();
+    if(LengthSquared < KINDA_SMALL_NUMBER) return false;
+
+    const double Alpha = FVector2D::DotProduct(Hit - Start2D, Segment) / LengthSquared;
+    if(Alpha < 0.0 || Alpha > 1.0) return false;
+
+    OutEdgePoint = FVector(Hit.X, Hit.Y, FMath::Lerp(EdgeStart.Z, EdgeEnd.Z, Alpha));
+    OutDistance = static_cast<float>(Distance);
+    return true;
+}
+
+void ClimbMath::ReduceClimbableSurface(TConstArrayView<FHitResult> Hits, FVector& OutSurfaceLocation, FVector& OutSurfaceNormal)
+{
+    OutSurfaceLocation = FVector::ZeroVector;
+    OutSurfaceNormal = FVector::ZeroVector;
+
+    if(Hits.IsEmpty()) return;
+
+    for(const FHitResult& Hit : Hits)
+    {
+        OutSurfaceLocation += Hit.ImpactPoint;
+        OutSurfaceNormal += Hit.ImpactNormal;
+    }
+
+    OutSurfaceLocation /= Hits.Num();
+    OutSurfaceNormal = OutSurfaceNormal.GetSafeNormal();
+}
+
+double ClimbMath::GetClimbContactWeight(const FVector& ImpactPoint, const FVector& ImpactNormal, const FVector& ClimberLocation, const FVector& ClimberForward)
+{
+    // Back faces point away from whoever is climbing the front
+    if(FVector::DotProduct(ImpactNormal, ClimberLocation - ImpactPoint) <= 0.0) return 0.0;
+
+    return FMath::Max(FVector::DotProduct(ImpactNormal, -ClimberForward), MinClimbContactWeight);
+}
+
+void ClimbMath::ReduceClimbableSurface(TConstArrayView<FHitResult> Hits, TConstArrayView<float> Grips, const FVector& ClimberLocation, const FVector& ClimberForward, FVector& OutSurfaceLocation, FVector& OutSurfaceNormal)
+{
+    OutSurfaceLocation = FVector::ZeroVector;
+    OutSurfaceNormal = FVector::ZeroVector;
+
+    double WeightSum = 0.0;
+    for(int32 Index = 0; Index < Hits.Num(); ++Index)
+    {
+        const FHitResult& Hit = Hits[Index];
+        const double Grip = Grips.IsEmpty() ? 1.0 : Grips[Index];
+        const double Weight = GetClimbContactWeight(Hit.ImpactPoint, Hit.ImpactNormal, ClimberLocation, ClimberForward) * Grip;
+        OutSurfaceLocation += Hit.ImpactPoint * Weight;
+        OutSurfaceNormal += Hit.ImpactNormal * Weight;
+        WeightSum += Weight;
+    }
+
+    if(WeightSum <= UE_DOUBLE_KINDA_SMALL_NUMBER)
+    {
+        OutSurfaceLocation = FVector::ZeroVector;
+        OutSurfaceNormal = FVector::ZeroVector;
+        return;
+    }
+
+    OutSurfaceLocation /= WeightSum;
+    OutSurfaceNormal = OutSurfaceNormal.GetSafeNormal();
+}
+
+bool ClimbMath::IsSurfaceTooFlat(const FVector& SurfaceNormal, float TooFlatUpDot)
+{
+    // Cosine falls as the angle grows, so a small angle from up is a large dot
+    return SurfaceNormal.Z >= TooFlatUpDot;
+}
+
+bool ClimbMath::IsFloorReached(const FVector& FloorNormal, const FVector& UnrotatedVelocity, float MinVerticalSpeed)
+{
+    return FVector::Parallel(-FloorNormal, FVector::UpVector) && UnrotatedVelocity.Z < -MinVerticalSpeed;
+}
+
+bool ClimbMath::IsLedgeTop(const FVector& TopNormal)
+{
+    return FVector::Parallel(-TopNormal, FVector::UpVector);
+}
+
+bool ClimbMath::IsLedgeReached(float LedgeHeight, float ReachHeight, const FVector& UnrotatedVelocity, float MinVerticalSpeed)
+{
+    return LedgeHeight <= ReachHeight && UnrotatedVelocity.Z > MinVerticalSpeed;
+}
+
+FQuat ClimbMath::GetClimbRotation(const FQuat& Current, const FVector& SurfaceNormal, float DeltaTime, float InterpSpeed)
+{
+    // Face against the surface normal
+    const FQuat TargetQuat = FRotationMatrix::MakeFromX(-SurfaceNormal).ToQuat();
+    return FMath::QInterpTo(Current, TargetQuat, DeltaTime, InterpSpeed);
+}
+
+FVector ClimbMath::GetSnapVector(const FVector& Location, const FVector& Forward, const FVector& SurfaceLocation, const FVector& SurfaceNormal)
+{
+    // Distance to the surface along the facing direction, applied against the surface normal
+    const double DistanceAlongForward = FMath::Abs(FVector::DotProduct(SurfaceLocation - Location, Forward));
+    return -SurfaceNormal * DistanceAlongForward;
+}
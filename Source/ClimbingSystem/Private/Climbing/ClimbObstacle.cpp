@@ -0,0 +1,83 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Climbing/ClimbObstacle.h"
+
+void ClimbMath::BuildObstacleProfile(TConstArrayView<FClimbObstacleSample> Samples, float ScanHeight, float CeilingDistance, float MinObstacleHeight, FClimbObstacleProfile& OutProfile)
+{
+    OutProfile = FClimbObstacleProfile();
+
+    const auto IsObstacle = [CeilingDistance, MinObstacleHeight](const FClimbObstacleSample& Sample)
+    {
+        return Sample.Distance >= CeilingDistance || (Sample.bHit && Sample.Height > MinObstacleHeight);
+    };
+
+    // Walk the level ground up to the obstacle, a column finding nothing first means the ground drops away
+    int32 Index = 0;
+    for(; Index < Samples.Num() && !IsObstacle(Samples[Index]); ++Index)
+    {
+        if(!Samples[Index].bHit)
+        {
+            // The edge lies somewhere between the last ground column and this one
+            const float PreviousDistance = Index > 0 ? Samples[Index - 1].Distance : 0.f;
+            OutProfile.bHasDrop = true;
+            OutProfile.DropDistance = (PreviousDistance + Samples[Index].Distance) * 0.5f;
+            return;
+        }
+    }
+    if(Index == Samples.Num()) return;
+
+    OutProfile.bHasObstacle = true;
+    OutProfile.Distance = Samples[Index].Distance;
+    OutProfile.TopPoint = Samples[Index].ImpactPoint;
+
+    // Run along the top of the obstacle
+    float LastObstacleDistance = OutProfile.Distance;
+    bool bBlockedOverhead = false;
+    for(; Index < Samples.Num() && IsObstacle(Samples[Index]); ++Index)
+    {
+        const FClimbObstacleSample& Sample = Samples[Index];
+        const bool bUnderCeiling = Sample.Distance >= CeilingDistance;
+        bBlockedOverhead |= bUnderCeiling;
+        OutProfile.Height = FMath::Max(OutProfile.Height, bUnderCeiling ? ScanHeight : Sample.Height);
+        LastObstacleDistance = Sample.Distance;
+    }
+    OutProfile.Depth = LastObstacleDistance - OutProfile.Distance;
+    OutProfile.Clearance = bBlockedOverhead ? 0.f : FMath::Max(ScanHeight - OutProfile.Height, 0.f);
+
+    // Land at the far end of the scan short of anything overhead, a gap between it and the obstacle is cleared in the same move
+    int32 LandingIndex = Samples.Num() - 1;
+    while(LandingIndex >= Index && Samples[LandingIndex].Distance >= CeilingDistance)
+    {
+        --LandingIndex;
+    }
+    if(LandingIndex >= Index && Samples[LandingIndex].bHit)
+    {
+        OutProfile.bHasLanding = true;
+        OutProfile.LandingHeight = Samples[LandingIndex].Height;
+        OutProfile.LandingPoint = Samples[LandingIndex].ImpactPoint;
+    }
+}
+
+EClimbObstacleAction ClimbMath::ChooseObstacleAction(const FClimbObstacleProfile& Profile, const FClimbObstacleRules& Rules)
+{
+    if(!Profile.bHasObstacle)
+    {
+        const bool bDropInReach = Profile.bHasDrop && Profile.DropDistance >= Rules.MinClimbDownDistance && Profile.DropDistance <= Rules.MaxClimbDownDistance;
+        return bDropInReach ? EClimbObstacleAction::ClimbDown : EClimbObstacleAction::None;
+    }
+
+    if(Profile.Clearance < Rules.MinClearance) return EClimbObstacleAction::None;
+
+    // Low and long is just a step up the walk mode takes care of
+    const bool bCanClearObstacle = Profile.bHasLanding && Profile.Depth <= Rules.MaxVaultDepth;
+    if(Profile.Height <= Rules.MaxStepOverHeight)
+    {
+        return bCanClearObstacle ? EClimbObstacleAction::StepOver : EClimbObstacleAction::None;
+    }
+    if(bCanClearObstacle && Profile.Height <= Rules.MaxVaultHeight)
+    {
+        return EClimbObstacleAction::Vault;
+    }
+    return Profile.Height <= Rules.MaxMantleHeight ? EClimbObstacleAction::Mantle : EClimbObstacleAction::None;
+}
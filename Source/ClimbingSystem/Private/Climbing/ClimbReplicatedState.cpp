@@ -0,0 +1,94 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Climbing/ClimbReplicatedState.h"
+
+namespace
+{
+    // Tenths of cm/s, keeps +-3276 cm/s in an int16
+    constexpr float ClimbVelocityScale = 10.f;
+
+    uint8 QuantizeSignedUnit(float Value)
+    {
+        return static_cast<uint8>(FMath::RoundToInt((FMath::Clamp(Value, -1.f, 1.f) * 0.5f + 0.5f) * 255.f));
+    }
+
+    float DequantizeSignedUnit(uint8 Value)
+    {
+        return (static_cast<float>(Value) / 255.f) * 2.f - 1.f;
+    }
+
+    int16 QuantizeClimbVelocity(double Value)
+    {
+        return static_cast<int16>(FMath::Clamp(FMath::RoundToInt(Value * ClimbVelocityScale), static_cast<int32>(MIN_int16), static_cast<int32>(MAX_int16)));
+    }
+}
+
+void FClimbReplicatedState::SetSurfaceNormal(const FVector& SurfaceNormal)
+{
+    const FVector3f Normal = FVector3f(SurfaceNormal.GetSafeNormal());
+    const float L1Norm = FMath::Abs(Normal.X) + FMath::Abs(Normal.Y) + FMath::Abs(Normal.Z);
+    if(L1Norm < KINDA_SMALL_NUMBER)
+    {
+        PackedNormal = 0;
+        return;
+    }
+
+    // Project onto the octahedron, then fold the lower half over the upper one
+    float OctX = Normal.X / L1Norm;
+    float OctY = Normal.Y / L1Norm;
+    if(Normal.Z < 0.f)
+    {
+        const float FoldedX = (1.f - FMath::Abs(OctY)) * (OctX >= 0.f ? 1.f : -1.f);
+        const float FoldedY = (1.f - FMath::Abs(OctX)) * (OctY >= 0.f ? 1.f : -1.f);
+        OctX = FoldedX;
+        OctY = FoldedY;
+    }
+
+    PackedNormal = static_cast<uint16>(QuantizeSignedUnit(OctX)) << 8 | QuantizeSignedUnit(OctY);
+}
+
+FVector FClimbReplicatedState::GetSurfaceNormal() const
+{
+    if(PackedNormal == 0) return FVector::ZeroVector;
+
+    const float OctX = DequantizeSignedUnit(static_cast<uint8>(PackedNormal >> 8));
+    const float OctY = DequantizeSignedUnit(static_cast<uint8>(PackedNormal & 0xFF));
+
+    // Unfold, the corners of the octahedron map back onto the lower half
+    FVector3f Normal(OctX, OctY, 1.f - FMath::Abs(OctX) - FMath::Abs(OctY));
+    const float Fold = FMath::Max(-Normal.Z, 0.f);
+    Normal.X += Normal.X >= 0.f ? -Fold : Fold;
+    Normal.Y += Normal.Y >= 0.f ? -Fold : Fold;
+
+    return FVector(Normal.GetSafeNormal());
+}
+
+void FClimbReplicatedState::SetUnrotatedClimbVelocity(const FVector& UnrotatedClimbVelocity)
+{
+    // Into the wall is always close to zero while climbing, only the surface axes are sent
+    SurfaceVelocityRight = QuantizeClimbVelocity(UnrotatedClimbVelocity.Y);
+    SurfaceVelocityUp = QuantizeClimbVelocity(UnrotatedClimbVelocity.Z);
+}
+
+FVector FClimbReplicatedState::GetUnrotatedClimbVelocity() const
+{
+    return FVector(0.f, SurfaceVelocityRight / ClimbVelocityScale, SurfaceVelocityUp / ClimbVelocityScale);
+}
+
+bool FClimbReplicatedState::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+    Ar << PackedNormal;
+    Ar << SurfaceVelocityRight;
+    Ar << SurfaceVelocityUp;
+
+    uint8 SubStateByte = static_cast<uint8>(SubState);
+    Ar << SubStateByte;
+    if(Ar.IsLoading())
+    {
+        SubState = static_cast<EClimbSubState>(SubStateByte);
+    }
+
+    bOutSuccess = true;
+    return true;
+}
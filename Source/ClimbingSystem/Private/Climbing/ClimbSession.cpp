@@ -0,0 +1,53 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Climbing/ClimbSession.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+FArchive& operator<<(FArchive& Ar, FClimbSessionFrame& Frame)
+{
+    Ar << Frame.DeltaTime;
+    Ar << Frame.MoveInput << Frame.ClimbMoveInput;
+    Ar << Frame.ControlRotation;
+
+    uint8 Buttons = static_cast<uint8>(Frame.Buttons);
+    Ar << Buttons;
+    Frame.Buttons = static_cast<EClimbSessionButton>(Buttons);
+
+    Ar << Frame.Location << Frame.Velocity << Frame.Rotation;
+    Ar << Frame.MovementMode << Frame.CustomMovementMode << Frame.ClimbSubState;
+    return Ar;
+}
+
+bool FClimbSession::Serialize(FArchive& Ar)
+{
+    uint32 FileMagic = Magic;
+    uint32 FileVersion = Version;
+    Ar << FileMagic << FileVersion;
+    if(FileMagic != Magic || FileVersion != Version) return false;
+
+    Ar << MapName;
+    Ar << StartLocation << StartRotation << StartControlRotation;
+    Ar << StartMovementMode << StartCustomMovementMode;
+    Ar << Frames;
+    return !Ar.IsError();
+}
+
+bool FClimbSession::SaveToFile(const FString& FileName) const
+{
+    TArray<uint8> Bytes;
+    FMemoryWriter Writer(Bytes);
+    const_cast<FClimbSession*>(this)->Serialize(Writer);
+    return FFileHelper::SaveArrayToFile(Bytes, *FileName);
+}
+
+bool FClimbSession::LoadFromFile(const FString& FileName)
+{
+    TArray<uint8> Bytes;
+    if(!FFileHelper::LoadFileToArray(Bytes, *FileName)) return false;
+
+    FMemoryReader Reader(Bytes);
+    return Serialize(Reader);
+}
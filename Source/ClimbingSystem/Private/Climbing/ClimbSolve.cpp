@@ -0,0 +1,159 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Climbing/ClimbSolve.h"
+#include "Climbing/ClimbMath.h"
+#include "Data/ClimbProfile.h"
+#include "Math/VectorRegister.h"
+
+namespace
+{
+    /* Climbers reduced together, one per lane of a register */
+    constexpr int32 ClimbReduceLanes = 4;
+
+    /* A vector of each lane's climber, one register per axis */
+    struct FClimbLaneVectors
+    {
+        VectorRegister4Double X;
+        VectorRegister4Double Y;
+        VectorRegister4Double Z;
+
+        FClimbLaneVectors(const VectorRegister4Double& InX, const VectorRegister4Double& InY, const VectorRegister4Double& InZ)
+            : X(InX)
+            , Y(InY)
+            , Z(InZ)
+        {
+        }
+
+        FClimbLaneVectors(const FVector (&Vectors)[ClimbReduceLanes])
+        {
+            double Lanes[3][ClimbReduceLanes];
+            for(int32 Lane = 0; Lane < ClimbReduceLanes; ++Lane)
+            {
+                Lanes[0][Lane] = Vectors[Lane].X;
+                Lanes[1][Lane] = Vectors[Lane].Y;
+                Lanes[2][Lane] = Vectors[Lane].Z;
+            }
+            X = VectorLoad(Lanes[0]);
+            Y = VectorLoad(Lanes[1]);
+            Z = VectorLoad(Lanes[2]);
+        }
+
+        VectorRegister4Double Dot(const FClimbLaneVectors& Other) const
+        {
+            return VectorMultiplyAdd(X, Other.X, VectorMultiplyAdd(Y, Other.Y, VectorMultiply(Z, Other.Z)));
+        }
+    };
+}
+
+void ClimbMath::ReduceClimbableSurfaces(const FClimbSolveBatch& Batch, int32 First, int32 Num, TArrayView<FClimbSolveOutput> OutResults)
+{
+    const VectorRegister4Double Zero = VectorZeroDouble();
+    const VectorRegister4Double MinWeight = VectorSetFloat1(MinClimbContactWeight);
+
+    for(int32 GroupStart = First; GroupStart < First + Num; GroupStart += ClimbReduceLanes)
+    {
+        const int32 NumLanes = FMath::Min(ClimbReduceLanes, First + Num - GroupStart);
+
+        // Lanes past the end get zero vectors and no contacts, so they weigh nothing
+        FVector Locations[ClimbReduceLanes];
+        FVector Facings[ClimbReduceLanes];
+        int32 MaxContacts = 0;
+        for(int32 Lane = 0; Lane < ClimbReduceLanes; ++Lane)
+        {
+            Locations[Lane] = FVector::ZeroVector;
+            Facings[Lane] = FVector::ZeroVector;
+            if(Lane >= NumLanes) continue;
+
+            const FClimbSolveInput& Input = Batch.Inputs[GroupStart + Lane];
+            Locations[Lane] = Input.Location;
+            Facings[Lane] = -Input.Rotation.GetForwardVector();
+            MaxContacts = FMath::Max(MaxContacts, Input.ContactNum);
+        }
+        const FClimbLaneVectors ClimberLocation(Locations);
+        const FClimbLaneVectors Facing(Facings);
+
+        VectorRegister4Double PointSumX = Zero, PointSumY = Zero, PointSumZ = Zero;
+        VectorRegister4Double NormalSumX = Zero, NormalSumY = Zero, NormalSumZ = Zero;
+        VectorRegister4Double WeightSum = Zero;
+
+        for(int32 Contact = 0; Contact < MaxContacts; ++Contact)
+        {
+            // Contact of each lane's climber, a zero grip for climbers that have run out of them
+            FVector Points[ClimbReduceLanes];
+            FVector Normals[ClimbReduceLanes];
+            double Grips[ClimbReduceLanes];
+            for(int32 Lane = 0; Lane < ClimbReduceLanes; ++Lane)
+            {
+                Points[Lane] = FVector::ZeroVector;
+                Normals[Lane] = FVector::ZeroVector;
+                Grips[Lane] = 0.0;
+                if(Lane >= NumLanes || Contact >= Batch.Inputs[GroupStart + Lane].ContactNum) continue;
+
+                const int32 ContactIndex = Batch.Inputs[GroupStart + Lane].ContactStart + Contact;
+                Points[Lane] = Batch.ContactPoints[ContactIndex];
+                Normals[Lane] = Batch.ContactNormals[ContactIndex];
+                Grips[Lane] = Batch.ContactGrips[ContactIndex];
+            }
+            const FClimbLaneVectors Point(Points);
+            const FClimbLaneVectors Normal(Normals);
+
+            // Same as GetClimbContactWeight, masked to zero instead of branching on back faces
+            const FClimbLaneVectors ToClimber(VectorSubtract(ClimberLocation.X, Point.X), VectorSubtract(ClimberLocation.Y, Point.Y), VectorSubtract(ClimberLocation.Z, Point.Z));
+            const VectorRegister4Double FacesClimber = VectorCompareGT(Normal.Dot(ToClimber), Zero);
+            const VectorRegister4Double Facingness = VectorSelect(FacesClimber, VectorMax(Normal.Dot(Facing), MinWeight), Zero);
+            const VectorRegister4Double Weight = VectorMultiply(Facingness, VectorLoad(Grips));
+
+            PointSumX = VectorMultiplyAdd(Point.X, Weight, PointSumX);
+            PointSumY = VectorMultiplyAdd(Point.Y, Weight, PointSumY);
+            PointSumZ = VectorMultiplyAdd(Point.Z, Weight, PointSumZ);
+            NormalSumX = VectorMultiplyAdd(Normal.X, Weight, NormalSumX);
+            NormalSumY = VectorMultiplyAdd(Normal.Y, Weight, NormalSumY);
+            NormalSumZ = VectorMultiplyAdd(Normal.Z, Weight, NormalSumZ);
+            WeightSum = VectorAdd(WeightSum, Weight);
+        }
+
+        double Sums[7][ClimbReduceLanes];
+        VectorStore(PointSumX, Sums[0]);
+        VectorStore(PointSumY, Sums[1]);
+        VectorStore(PointSumZ, Sums[2]);
+        VectorStore(NormalSumX, Sums[3]);
+        VectorStore(NormalSumY, Sums[4]);
+        VectorStore(NormalSumZ, Sums[5]);
+        VectorStore(WeightSum, Sums[6]);
+
+        for(int32 Lane = 0; Lane < NumLanes; ++Lane)
+        {
+            FClimbSolveOutput& OutResult = OutResults[GroupStart + Lane];
+            const double SummedWeight = Sums[6][Lane];
+            if(SummedWeight <= UE_DOUBLE_KINDA_SMALL_NUMBER)
+            {
+                OutResult.SurfaceLocation = FVector::ZeroVector;
+                OutResult.SurfaceNormal = FVector::ZeroVector;
+                continue;
+            }
+
+            OutResult.SurfaceLocation = FVector(Sums[0][Lane], Sums[1][Lane], Sums[2][Lane]) / SummedWeight;
+            OutResult.SurfaceNormal = FVector(Sums[3][Lane], Sums[4][Lane], Sums[5][Lane]).GetSafeNormal();
+        }
+    }
+}
+
+void ClimbMath::SolveClimb(const FClimbSolveBatch& Batch, int32 Index, FClimbSolveOutput& OutResult)
+{
+    const FClimbSolveInput& Input = Batch.Inputs[Index];
+    const FClimbProfileConstants& Profile = *Input.Profile;
+
+    // Same rules as CheckShouldStopClimbing and CheckHasReahedFloor
+    bool bReachedFloor = false;
+    for(int32 FloorIndex = Input.FloorStart; FloorIndex < Input.FloorStart + Input.FloorNum && !bReachedFloor; ++FloorIndex)
+    {
+        bReachedFloor = IsFloorReached(Batch.FloorNormals[FloorIndex], Input.UnrotatedVelocity, Profile.MinVerticalClimbSpeed);
+    }
+    OutResult.bShouldStop = OutResult.SurfaceNormal.IsZero() || IsSurfaceTooFlat(OutResult.SurfaceNormal, Profile.TooFlatSurfaceUpDot) || bReachedFloor;
+
+    OutResult.bReachedLedge = Input.bLedgeReached;
+
+    // Rotation from the pose we were gathered in, the snap needs the location after the move and is left to PhysClimb
+    OutResult.ClimbRotation = GetClimbRotation(Input.Rotation, OutResult.SurfaceNormal, Input.DeltaTime, Profile.RotationInterpSpeed);
+}
@@ -0,0 +1,398 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Components/ClimbSessionRecorderComponent.h"
+#include "Components/CustomMovementComponent.h"
+#include "ClimbingSystem/ClimbingSystem.h"
+#include "ClimbingSystem/ClimbingStats.h"
+#include "ClimbingSystem/ClimbingSystemCharacter.h"
+#include "EngineUtils.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+
+UClimbSessionRecorderComponent::UClimbSessionRecorderComponent()
+{
+    // After the character movement, so a frame's state is the one its input led to
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.bStartWithTickEnabled = false;
+    PrimaryComponentTick.TickGroup = TG_PostPhysics;
+}
+
+void UClimbSessionRecorderComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    ClimbingCharacter = Cast<AClimbingSystemCharacter>(GetOwner());
+
+    FParse::Value(FCommandLine::Get(), TEXT("ClimbReplay="), CommandLineReplayFile);
+    UpdateCommandLineReplayTick();
+}
+
+void UClimbSessionRecorderComponent::OnCharacterControllerChanged()
+{
+    if(HasBegunPlay())
+    {
+        UpdateCommandLineReplayTick();
+    }
+}
+
+// Every character has a recorder, only the one the local player possesses ticks to run the command line replay
+void UClimbSessionRecorderComponent::UpdateCommandLineReplayTick()
+{
+    if(CommandLineReplayFile.IsEmpty() || bRecording || bReplaying) return;
+
+    SetComponentTickEnabled(ClimbingCharacter && ClimbingCharacter->IsLocallyControlled());
+}
+
+void UClimbSessionRecorderComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if(bRecording)
+    {
+        StopRecording();
+    }
+    if(bReplaying)
+    {
+        FinishReplay();
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void UClimbSessionRecorderComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    LLM_SCOPE_BYTAG(Climbing);
+
+    // Possession can still change on the frame it ticked, check again before starting
+    if(!CommandLineReplayFile.IsEmpty())
+    {
+        if(!ClimbingCharacter || !ClimbingCharacter->IsLocallyControlled()) return;
+
+        const FString FileName = MoveTemp(CommandLineReplayFile);
+        CommandLineReplayFile.Reset();
+        bExitAfterReplay = true;
+        if(!StartReplay(FileName))
+        {
+            FPlatformMisc::RequestExit(false);
+        }
+        return;
+    }
+
+    if(bRecording)
+    {
+        RecordFrame(DeltaTime);
+    }
+    else if(bReplaying)
+    {
+        AdvanceReplay();
+    }
+}
+
+void UClimbSessionRecorderComponent::StartRecording()
+{
+    if(bRecording || bReplaying || !ClimbingCharacter) return;
+
+    const UCustomMovementComponent* Movement = ClimbingCharacter->GetCustomeMovementComponent();
+    if(!Movement) return;
+
+    Session = FClimbSession();
+    Session.MapName = GetWorld()->GetMapName();
+    Session.StartLocation = ClimbingCharacter->GetActorLocation();
+    Session.StartRotation = ClimbingCharacter->GetActorRotation();
+    Session.StartControlRotation = ClimbingCharacter->GetControlRotation();
+    Session.StartMovementMode = Movement->MovementMode;
+    Session.StartCustomMovementMode = Movement->CustomMovementMode;
+
+    PendingFrame = FClimbSessionFrame();
+    bRecording = true;
+    SetComponentTickEnabled(true);
+
+    UE_LOG(LogClimbing, Display, TEXT("Recording climb session of %s"), *GetNameSafe(ClimbingCharacter));
+}
+
+FString UClimbSessionRecorderComponent::StopRecording()
+{
+    if(!bRecording) return FString();
+
+    bRecording = false;
+    SetComponentTickEnabled(false);
+
+    const FString FileName = FPaths::ProjectSavedDir() / TEXT("ClimbSessions") / FString::Printf(TEXT("ClimbSession-%s.climbsession"), *FDateTime::Now().ToString());
+    if(!Session.SaveToFile(FileName))
+    {
+        UE_LOG(LogClimbing, Warning, TEXT("Could not write climb session %s"), *FileName);
+        return FString();
+    }
+
+    UE_LOG(LogClimbing, Display, TEXT("Climb session of %d frames written to %s"), Session.Frames.Num(), *FileName);
+    return FileName;
+}
+
+void UClimbSessionRecorderComponent::CaptureMoveInput(const FVector2D& Value)
+{
+    if(bRecording)
+    {
+        PendingFrame.MoveInput = FVector2f(Value);
+    }
+}
+
+void UClimbSessionRecorderComponent::CaptureClimbMoveInput(const FVector2D& Value)
+{
+    if(bRecording)
+    {
+        PendingFrame.ClimbMoveInput = FVector2f(Value);
+    }
+}
+
+void UClimbSessionRecorderComponent::CaptureButton(EClimbSessionButton Button)
+{
+    if(bRecording)
+    {
+        PendingFrame.Buttons |= Button;
+    }
+}
+
+// The input captured since the last frame plus the state the movement component ended this frame in
+void UClimbSessionRecorderComponent::RecordFrame(float DeltaTime)
+{
+    const UCustomMovementComponent* Movement = ClimbingCharacter->GetCustomeMovementComponent();
+    if(!Movement) return;
+
+    PendingFrame.DeltaTime = DeltaTime;
+    PendingFrame.ControlRotation = FRotator3f(ClimbingCharacter->GetControlRotation());
+
+    PendingFrame.Location = FVector3f(ClimbingCharacter->GetActorLocation());
+    PendingFrame.Velocity = FVector3f(Movement->Velocity);
+    PendingFrame.Rotation = FRotator3f(ClimbingCharacter->GetActorRotation());
+    PendingFrame.MovementMode = Movement->MovementMode;
+    PendingFrame.CustomMovementMode = Movement->CustomMovementMode;
+    PendingFrame.ClimbSubState = static_cast<uint8>(Movement->GetClimbSubState());
+
+    Session.Frames.Add(PendingFrame);
+    PendingFrame = FClimbSessionFrame();
+}
+
+bool UClimbSessionRecorderComponent::StartReplay(const FString& FileName)
+{
+    if(bRecording || bReplaying || !ClimbingCharacter) return false;
+
+    UCustomMovementComponent* Movement = ClimbingCharacter->GetCustomeMovementComponent();
+    if(!Movement) return false;
+
+    if(!Session.LoadFromFile(FileName) || Session.Frames.IsEmpty())
+    {
+        UE_LOG(LogClimbing, Warning, TEXT("%s is not a climb session"), *FileName);
+        return false;
+    }
+    if(Session.MapName != GetWorld()->GetMapName())
+    {
+        UE_LOG(LogClimbing, Warning, TEXT("Climb session was recorded on %s, replaying it on %s"), *Session.MapName, *GetWorld()->GetMapName());
+    }
+
+    // Same start pose, and no live input fighting the recorded one
+    ClimbingCharacter->TeleportTo(Session.StartLocation, Session.StartRotation, false, true);
+    if(AController* Controller = ClimbingCharacter->GetController())
+    {
+        Controller->SetControlRotation(Session.StartControlRotation);
+    }
+    ClimbingCharacter->DisableInput(Cast<APlayerController>(ClimbingCharacter->GetController()));
+    Movement->StopMovementImmediately();
+    Movement->SetMovementMode(static_cast<EMovementMode>(Session.StartMovementMode), Session.StartCustomMovementMode);
+
+    // Each frame runs at the time step it was recorded with
+    bWasUsingFixedTimeStep = FApp::UseFixedTimeStep();
+    PreviousFixedDeltaTime = FApp::GetFixedDeltaTime();
+    FApp::SetUseFixedTimeStep(true);
+
+    ReplayDivergence.Reset(Session.Frames.Num());
+    ReplayTickCycles.Reset(Session.Frames.Num());
+    ReplayModeMismatches = 0;
+
+    ReplayFrameIndex = 0;
+    ApplyReplayFrame(Session.Frames[0]);
+    bReplaying = true;
+    SetComponentTickEnabled(true);
+
+    UE_LOG(LogClimbing, Display, TEXT("Replaying climb session %s, %d frames"), *FileName, Session.Frames.Num());
+    return true;
+}
+
+// Compare the frame that just ran with its recording, then queue the input of the next one
+void UClimbSessionRecorderComponent::AdvanceReplay()
+{
+    const UCustomMovementComponent* Movement = ClimbingCharacter ? ClimbingCharacter->GetCustomeMovementComponent() : nullptr;
+    if(!Movement)
+    {
+        FinishReplay();
+        return;
+    }
+
+    const FClimbSessionFrame& Recorded = Session.Frames[ReplayFrameIndex];
+    ReplayDivergence.Add(FVector::Dist(ClimbingCharacter->GetActorLocation(), FVector(Recorded.Location)));
+    ReplayTickCycles.Add(Movement->GetLastTickCycles());
+    if(Movement->MovementMode != Recorded.MovementMode || Movement->CustomMovementMode != Recorded.CustomMovementMode)
+    {
+        ++ReplayModeMismatches;
+    }
+
+    if(++ReplayFrameIndex >= Session.Frames.Num())
+    {
+        FinishReplay();
+        return;
+    }
+    ApplyReplayFrame(Session.Frames[ReplayFrameIndex]);
+}
+
+// Runs after this frame's movement, so the time step and input both land on the next frame
+void UClimbSessionRecorderComponent::ApplyReplayFrame(const FClimbSessionFrame& Frame)
+{
+    FApp::SetFixedDeltaTime(Frame.DeltaTime);
+    ClimbingCharacter->ApplyClimbSessionInput(Frame);
+}
+
+void UClimbSessionRecorderComponent::FinishReplay()
+{
+    bReplaying = false;
+    SetComponentTickEnabled(false);
+
+    FApp::SetUseFixedTimeStep(bWasUsingFixedTimeStep);
+    FApp::SetFixedDeltaTime(PreviousFixedDeltaTime);
+    if(ClimbingCharacter)
+    {
+        ClimbingCharacter->EnableInput(Cast<APlayerController>(ClimbingCharacter->GetController()));
+    }
+
+    const int32 NumFrames = ReplayDivergence.Num();
+    float MaxDivergence = 0.f;
+    double TotalDivergence = 0.0;
+    int32 FirstDivergentFrame = INDEX_NONE;
+    for(int32 Index = 0; Index < NumFrames; ++Index)
+    {
+        MaxDivergence = FMath::Max(MaxDivergence, ReplayDivergence[Index]);
+        TotalDivergence += ReplayDivergence[Index];
+        if(FirstDivergentFrame == INDEX_NONE && ReplayDivergence[Index] > DivergenceTolerance)
+        {
+            FirstDivergentFrame = Index;
+        }
+    }
+
+    TArray<uint64> SortedCycles = ReplayTickCycles;
+    SortedCycles.Sort();
+    const auto CyclesToUs = [](uint64 Cycles) { return FPlatformTime::ToSeconds64(Cycles) * 1e6; };
+    const double MaxTickUs = SortedCycles.IsEmpty() ? 0.0 : CyclesToUs(SortedCycles.Last());
+    const double P95TickUs = SortedCycles.IsEmpty() ? 0.0 : CyclesToUs(SortedCycles[FMath::Min(FMath::FloorToInt(SortedCycles.Num() * 0.95f), SortedCycles.Num() - 1)]);
+    uint64 TotalCycles = 0;
+    for(const uint64 Cycles : SortedCycles)
+    {
+        TotalCycles += Cycles;
+    }
+    const double MeanTickUs = CyclesToUs(TotalCycles) / FMath::Max(NumFrames, 1);
+
+    FString Json;
+    TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Json);
+    Writer->WriteObjectStart();
+    Writer->WriteValue(TEXT("Map"), Session.MapName);
+    Writer->WriteValue(TEXT("Frames"), NumFrames);
+    Writer->WriteValue(TEXT("RecordedFrames"), Session.Frames.Num());
+    Writer->WriteValue(TEXT("MaxDivergence"), MaxDivergence);
+    Writer->WriteValue(TEXT("MeanDivergence"), TotalDivergence / FMath::Max(NumFrames, 1));
+    Writer->WriteValue(TEXT("FirstDivergentFrame"), FirstDivergentFrame);
+    Writer->WriteValue(TEXT("MovementModeMismatches"), ReplayModeMismatches);
+    Writer->WriteValue(TEXT("MeanClimbTickUs"), MeanTickUs);
+    Writer->WriteValue(TEXT("P95ClimbTickUs"), P95TickUs);
+    Writer->WriteValue(TEXT("MaxClimbTickUs"), MaxTickUs);
+    Writer->WriteArrayStart(TEXT("Divergence"));
+    for(const float Divergence : ReplayDivergence)
+    {
+        Writer->WriteValue(Divergence);
+    }
+    Writer->WriteArrayEnd();
+    Writer->WriteArrayStart(TEXT("ClimbTickUs"));
+    for(const uint64 Cycles : ReplayTickCycles)
+    {
+        Writer->WriteValue(CyclesToUs(Cycles));
+    }
+    Writer->WriteArrayEnd();
+    Writer->WriteObjectEnd();
+    Writer->Close();
+
+    const FString FileName = FPaths::ProfilingDir() / TEXT("ClimbReplay") / FString::Printf(TEXT("ClimbReplay-%s.json"), *FDateTime::Now().ToString());
+    FFileHelper::SaveStringToFile(Json, *FileName);
+
+    UE_LOG(LogClimbing, Display, TEXT("Climb replay of %d frames: max divergence %.2f cm (first over %.2f cm at frame %d), %d mode mismatches, climb tick mean %.1f us p95 %.1f us max %.1f us. Report written to %s"),
+        NumFrames, MaxDivergence, DivergenceTolerance, FirstDivergentFrame, ReplayModeMismatches, MeanTickUs, P95TickUs, MaxTickUs, *FileName);
+
+    if(bExitAfterReplay)
+    {
+        FPlatformMisc::RequestExit(false);
+    }
+}
+
+#if !UE_BUILD_SHIPPING
+
+namespace
+{
+    UClimbSessionRecorderComponent* FindLocalClimbSessionRecorder(UWorld* World)
+    {
+        for(TActorIterator<AClimbingSystemCharacter> It(World); It; ++It)
+        {
+            if(It->IsLocallyControlled() && It->GetClimbSessionRecorder())
+            {
+                return It->GetClimbSessionRecorder();
+            }
+        }
+        return nullptr;
+    }
+
+    void ToggleClimbRecording(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        UClimbSessionRecorderComponent* Recorder = World ? FindLocalClimbSessionRecorder(World) : nullptr;
+        if(!Recorder)
+        {
+            Ar.Logf(TEXT("No locally controlled climbing character to record"));
+            return;
+        }
+
+        if(Recorder->IsRecording())
+        {
+            Recorder->StopRecording();
+        }
+        else
+        {
+            Recorder->StartRecording();
+        }
+    }
+
+    void StartClimbReplay(const TArray<FString>& Args, UWorld* World, FOutputDevice& Ar)
+    {
+        UClimbSessionRecorderComponent* Recorder = World ? FindLocalClimbSessionRecorder(World) : nullptr;
+        if(!Recorder || Args.IsEmpty())
+        {
+            Ar.Logf(TEXT("Usage: Climb.Replay <File>, with a locally controlled climbing character in the world"));
+            return;
+        }
+
+        Recorder->StartReplay(Args[0]);
+    }
+}
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice ClimbRecordCommand(
+    TEXT("Climb.Record"),
+    TEXT("Starts recording the climb input and movement of the local character, or stops and writes the session to Saved/ClimbSessions"),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&ToggleClimbRecording));
+
+static FAutoConsoleCommandWithWorldArgsAndOutputDevice ClimbReplayCommand(
+    TEXT("Climb.Replay"),
+    TEXT("Replays a recorded climb session on the local character and writes divergence and per frame climb tick cost to Saved/Profiling/ClimbReplay. Climb.Replay <File>"),
+    FConsoleCommandWithWorldArgsAndOutputDeviceDelegate::CreateStatic(&StartClimbReplay));
+
+#endif
@@ -0,0 +1,30 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Components/ClimbingMeshComponent.h"
+
+// Timed around the budgeted tick, the same span it reports to the allocator
+void UClimbingMeshComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    LastTickFrame = GFrameCounter;
+    LastTickMs = static_cast<float>(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles));
+    LastCompletionMs = 0.f;
+}
+
+void UClimbingMeshComponent::CompleteParallelAnimationEvaluation(bool bDoPostAnimEvaluation)
+{
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+
+    Super::CompleteParallelAnimationEvaluation(bDoPostAnimEvaluation);
+
+    LastCompletionMs += static_cast<float>(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles));
+}
+
+float UClimbingMeshComponent::GetAnimationGameThreadMs() const
+{
+    return LastTickFrame == GFrameCounter ? LastTickMs + LastCompletionMs : 0.f;
+}
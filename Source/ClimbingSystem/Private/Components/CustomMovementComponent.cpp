@@ -2,13 +2,60 @@
 
 
 #include "Components/CustomMovementComponent.h"
-#include "Kismet/KismetSystemLibrary.h"
+#include "ClimbingSystem/ClimbingSystem.h"
+#include "ClimbingSystem/ClimbingStats.h"
 #include "ClimbingSystem/ClimbingSystemCharacter.h"
-#include "ClimbingSystem/DebugHelper.h"
+#include "DrawDebugHelpers.h"
+#include "ClimbingSystem/ClimbingDiagnostics.h"
 #include "Components/CapsuleComponent.h"
+#include "AnimInstance/CharacterAnimInstance.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "ClimbingSystem/ClimbingSystemCharacter.h"
 #include "MotionWarpingComponent.h"
+#include "Climbing/ClimbMath.h"
+#include "Climbing/ClimbObstacle.h"
+#include "Data/ClimbLedgeGraph.h"
+#include "Data/ClimbLedgeEdgeUserData.h"
+#include "Data/ClimbProfile.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/AssetManager.h"
+#include "Subsystems/ClimbLedgeGraphSubsystem.h"
+#include "Subsystems/ClimbingSimulationSubsystem.h"
+#include "Subsystems/ClimbSurfaceSubsystem.h"
+#include "SignificanceManager.h"
+#include "IAnimationBudgetAllocator.h"
+#include "SkeletalMeshComponentBudgeted.h"
+
+namespace
+{
+    const FName ClimbSignificanceTag(TEXT("Climber"));
+
+    // Motion warp targets the climb montages are authored with
+    const FName VaultStartWarpTarget(TEXT("VaultStartPos"));
+    const FName VaultEndWarpTarget(TEXT("VaultEndPos"));
+    const FName MantleTopWarpTarget(TEXT("MantleTopPos"));
+    const FName HopUpWarpTarget(TEXT("HopUpTargetPoint"));
+    const FName HopDownWarpTarget(TEXT("HopDownTargetPoint"));
+}
+
+DECLARE_CYCLE_STAT(TEXT("PhysClimb"), STAT_PhysClimb, STATGROUP_Climbing);
+DECLARE_CYCLE_STAT(TEXT("TraceClimableSurfaces"), STAT_TraceClimableSurfaces, STATGROUP_Climbing);
+DECLARE_CYCLE_STAT(TEXT("RunClimbProbes"), STAT_RunClimbProbes, STATGROUP_Climbing);
+DECLARE_CYCLE_STAT(TEXT("ProcessClimbableSurfaceInfo"), STAT_ProcessClimbableSurfaceInfo, STATGROUP_Climbing);
+DECLARE_CYCLE_STAT(TEXT("CheckHasReachedLedge"), STAT_CheckHasReachedLedge, STATGROUP_Climbing);
+DECLARE_CYCLE_STAT(TEXT("CheckHasReahedFloor"), STAT_CheckHasReahedFloor, STATGROUP_Climbing);
+DECLARE_CYCLE_STAT(TEXT("SnapMovementToClimableSurfaces"), STAT_SnapMovementToClimableSurfaces, STATGROUP_Climbing);
+DECLARE_CYCLE_STAT(TEXT("ScanObstacleProfile"), STAT_ScanObstacleProfile, STATGROUP_Climbing);
+DECLARE_CYCLE_STAT(TEXT("CheckCanHopUp"), STAT_CheckCanHopUp, STATGROUP_Climbing);
+DECLARE_CYCLE_STAT(TEXT("CheckCanHopDown"), STAT_CheckCanHopDown, STATGROUP_Climbing);
+
+void UCustomMovementComponent::PostLoad()
+{
+    Super::PostLoad();
+
+    MigrateDeprecatedClimbTuning();
+}
 
 // Called when the game starts or when spawned
 void UCustomMovementComponent::BeginPlay()
@@ -16,6 +63,8 @@ void UCustomMovementComponent::BeginPlay()
     // Call the parent class's BeginPlay function
     Super::BeginPlay();
 
+    LLM_SCOPE_BYTAG(Climbing);
+
     // Get the animation instance associated with the owning player's mesh
     OwningPlayerAnimInstance = CharacterOwner->GetMesh()->GetAnimInstance();
 
@@ -30,14 +79,112 @@ void UCustomMovementComponent::BeginPlay()
         OwningPlayerAnimInstance->OnMontageBlendingOut.AddDynamic(this, &UCustomMovementComponent::OnClimbMontageEnded);
     }
 
+    CharacterAnimInstance = Cast<UCharacterAnimInstance>(OwningPlayerAnimInstance);
     OwningPlayerCharacter = Cast<AClimbingSystemCharacter>(CharacterOwner);
+
+    LedgeGraphSubsystem = GetWorld()->GetSubsystem<UClimbLedgeGraphSubsystem>();
+    SimulationSubsystem = GetWorld()->GetSubsystem<UClimbingSimulationSubsystem>();
+    SurfaceSubsystem = GetWorld()->GetSubsystem<UClimbSurfaceSubsystem>();
+
+    InitClimbProfile();
+    BuildClimbQueryParams();
+
+    ClimbLODFrameOffset = GetUniqueID();
+    RegisterClimbSignificance();
+}
+
+void UCustomMovementComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if(SimulationSubsystem)
+    {
+        SimulationSubsystem->UnregisterClimber(this);
+    }
+    UnregisterClimbSignificance();
+    ReleaseClimbMontages();
+
+    Super::EndPlay(EndPlayReason);
 }
 
 
 void UCustomMovementComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction)
 {
+    LLM_SCOPE_BYTAG(Climbing);
+
+    const uint64 TickStartCycles = FPlatformTime::Cycles64();
+
     Super::TickComponent(DeltaTime,  TickType, ThisTickFunction);
-   
+
+    // Proxies rebuild the climb from the replicated state, the server publishes it for them
+    if(CharacterOwner->GetLocalRole() == ROLE_SimulatedProxy)
+    {
+        SmoothReplicatedClimbState(DeltaTime);
+    }
+    else
+    {
+        ClimbSubState = EvaluateClimbSubState();
+        if(CharacterOwner->HasAuthority() && GetNetMode() != NM_Standalone && OwningPlayerCharacter)
+        {
+            OwningPlayerCharacter->SetReplicatedClimbState(BuildReplicatedClimbState());
+        }
+    }
+
+    UpdateClimbLimbs();
+    UpdateClimbAnimProxy();
+    UpdateAnimBudgetSignificance();
+    UpdateClimbMontageStreaming(DeltaTime);
+    if(ClimbMontageHandle.IsValid())
+    {
+        INC_DWORD_STAT(STAT_ClimbMontageHolders);
+    }
+
+    LastTickCycles = FPlatformTime::Cycles64() - TickStartCycles;
+
+    if(!IsClimbing()) return;
+
+    INC_DWORD_STAT(STAT_ClimbersActive);
+    CSV_CUSTOM_STAT(Climbing, ClimbersActive, 1, ECsvCustomStatOp::Accumulate);
+
+    if(bHangSleeping)
+    {
+        INC_DWORD_STAT(STAT_ClimbersSleeping);
+    }
+
+    switch(ClimbLODTier)
+    {
+    case EClimbLODTier::Reduced:
+        INC_DWORD_STAT(STAT_ClimbersReducedLOD);
+        break;
+    case EClimbLODTier::SurfaceLocked:
+        INC_DWORD_STAT(STAT_ClimbersSurfaceLockedLOD);
+        break;
+    case EClimbLODTier::Frozen:
+        INC_DWORD_STAT(STAT_ClimbersFrozenLOD);
+        break;
+    default:
+        break;
+    }
+}
+
+// Root motion ticks the pose inside the move, before TickComponent writes the proxy, so it gets this frame's state first
+void UCustomMovementComponent::PerformMovement(float DeltaTime)
+{
+    if(CharacterOwner && CharacterOwner->IsPlayingRootMotion())
+    {
+        UpdateClimbAnimProxy();
+    }
+
+    Super::PerformMovement(DeltaTime);
+}
+
+// Same for simulated proxies playing a replicated root motion montage
+void UCustomMovementComponent::SimulatedTick(float DeltaSeconds)
+{
+    if(CharacterOwner && CharacterOwner->IsPlayingRootMotion())
+    {
+        UpdateClimbAnimProxy();
+    }
+
+    Super::SimulatedTick(DeltaSeconds);
 }
 
 // Called when the movement mode of the character changes
@@ -49,7 +196,22 @@ void UCustomMovementComponent::OnMovementModeChanged(EMovementMode PreviousMovem
         // Cannot rotate now
         bOrientRotationToMovement = false;
         // Half the Capsule Height
-        CharacterOwner->GetCapsuleComponent()->SetCapsuleHalfHeight(48.f);
+        CharacterOwner->GetCapsuleComponent()->SetCapsuleHalfHeight(GetClimbProfile()->ClimbingCapsuleHalfHeight);
+
+        // Probes submitted before entering the climb were aimed from a different pose
+        ResetAsyncClimbProbes();
+        WakeFromHangSleep();
+        LastClimbProbeFrame = 0;
+        LedgeTrack = FClimbLedgeTrack();
+        ClimbSurfaceSpeedMultiplier = 1.f;
+
+        if(bUseBatchedClimbSimulation && SimulationSubsystem)
+        {
+            SimulationSubsystem->RegisterClimber(this);
+        }
+
+        CLIMB_LOG(Log, TEXT("%s entered climb"), *GetNameSafe(CharacterOwner));
+        CLIMB_VLOG(CharacterOwner, TEXT("Enter climb"));
 
         OnEnterClimbStateDelegate.ExecuteIfBound();
     }
@@ -59,7 +221,7 @@ void UCustomMovementComponent::OnMovementModeChanged(EMovementMode PreviousMovem
     {
         // Restore properties when exiting climbing mode
         bOrientRotationToMovement = true;
-        CharacterOwner->GetCapsuleComponent()->SetCapsuleHalfHeight(96.f); // reset capsule size 
+        CharacterOwner->GetCapsuleComponent()->SetCapsuleHalfHeight(GetClimbProfile()->StandingCapsuleHalfHeight); // reset capsule size 
 
         // Reset rotation to a clean standing position
         const FRotator DirtyRotation = UpdatedComponent->GetComponentRotation();
@@ -68,7 +230,23 @@ void UCustomMovementComponent::OnMovementModeChanged(EMovementMode PreviousMovem
 
         // Stop movement immediately when exiting climbing mode
         StopMovementImmediately();
+        WakeFromHangSleep();
+
+        if(SimulationSubsystem)
+        {
+            SimulationSubsystem->UnregisterClimber(this);
+        }
+
+        // Proxies keep the surface only from replication, the next climb has to snap to its own surface instead of blending from this one
+        if(CharacterOwner->GetLocalRole() == ROLE_SimulatedProxy)
+        {
+            CurrentClimbableSurfaceNormal = FVector::ZeroVector;
+            ProxyTargetSurfaceNormal = FVector::ZeroVector;
+        }
  
+        CLIMB_LOG(Log, TEXT("%s exited climb"), *GetNameSafe(CharacterOwner));
+        CLIMB_VLOG(CharacterOwner, TEXT("Exit climb"));
+
         OnExitClimbStateDelegate.ExecuteIfBound();
     }
 
@@ -94,7 +272,7 @@ void UCustomMovementComponent::PhysCustom(float deltaTime, int32 Iterations)
 float UCustomMovementComponent::GetMaxSpeed() const
 {   
     if(IsClimbing()){
-        return MaxClimbSpeed;
+        return GetClimbProfile()->MaxClimbSpeed * ClimbSurfaceSpeedMultiplier;
     }
     else{
         return Super::GetMaxSpeed();
@@ -104,7 +282,7 @@ float UCustomMovementComponent::GetMaxSpeed() const
 float UCustomMovementComponent::GetMaxAcceleration() const
 {
     if(IsClimbing()){
-        return MaxClimbAcceleration;
+        return GetClimbProfile()->MaxClimbAcceleration;
     }
     else{
         return Super::GetMaxAcceleration();
@@ -129,44 +307,99 @@ FVector UCustomMovementComponent::ConstrainAnimRootMotionVelocity(const FVector
     }
 }
 
+// Unpack the climb requests of a move received by the server or replayed by the client
+void UCustomMovementComponent::UpdateFromCompressedFlags(uint8 Flags)
+{
+    Super::UpdateFromCompressedFlags(Flags);
 
-#pragma region ClimbTraces
+    bWantsToToggleClimb = (Flags & FSavedMove_Character::FLAG_Custom_0) != 0;
+    bWantsToHop = (Flags & FSavedMove_Character::FLAG_Custom_1) != 0;
+}
 
-// Perform a capsule trace for multiple objects and return the hit results
-TArray<FHitResult> UCustomMovementComponent::DoCapsuleTraceMultiByObject(const FVector &Start, const FVector &End, bool bShowDebugShape, bool bDrawPresistantShapes)
-{   
-    // Array to store the hit results from the capsule trace
-    TArray<FHitResult> OutCapsuleTraceHitResults; 
-
-    // Set the default debug trace type to none
-    EDrawDebugTrace::Type DebugTraceType = EDrawDebugTrace::None;
-
-    // Check if debug shapes should be shown
-    if(bShowDebugShape){
-        // Set debug trace type to one frame or persistent based on the flag
-        DebugTraceType = EDrawDebugTrace::ForOneFrame;
-        if(bDrawPresistantShapes){
-            DebugTraceType = EDrawDebugTrace::Persistent;
+// Run the climb requests inside the move so client prediction and server agree on when they happened
+void UCustomMovementComponent::UpdateCharacterStateBeforeMovement(float DeltaSeconds)
+{
+    // A replayed move after a correction must not start its montages a second time, stopping is safe to replay
+    const bool bReplayingMove = CharacterOwner->bClientUpdating;
+
+    // A traversal requested on an earlier frame acts on the scan it submitted
+    if(ObstacleScan.SubmitFrame != 0 && ObstacleScan.SubmitFrame != GFrameCounter && !bReplayingMove)
+    {
+        FinishObstacleTraversal();
+    }
+
+    if(bWantsToToggleClimb)
+    {
+        if(IsClimbing())
+        {
+            ToggleClimbing(false);
+        }
+        else if(!bReplayingMove)
+        {
+            ToggleClimbing(true);
         }
     }
 
-    // Perform capsule trace for multiple objects
-    UKismetSystemLibrary::CapsuleTraceMultiForObjects(
-        this,
-        Start,
-        End,
-        ClimbCapsuleTraceRadius,
-        ClimbCapsuleTraceHalfHeight,
-        ClimableSurfaceTraceTypes,
-        false,
-        TArray<AActor*>(),
-        DebugTraceType,
-        OutCapsuleTraceHitResults,
-        false
-    );
+    if(bWantsToHop && IsClimbing() && !bReplayingMove)
+    {
+        RequestHopping();
+    }
+
+    bWantsToToggleClimb = false;
+    bWantsToHop = false;
+
+    Super::UpdateCharacterStateBeforeMovement(DeltaSeconds);
+}
+
+FNetworkPredictionData_Client* UCustomMovementComponent::GetPredictionData_Client() const
+{
+    check(PawnOwner != nullptr);
+
+    if(!ClientPredictionData)
+    {
+        UCustomMovementComponent* MutableThis = const_cast<UCustomMovementComponent*>(this);
+        MutableThis->ClientPredictionData = new FNetworkPredictionData_Client_Climb(*this);
+    }
+
+    return ClientPredictionData;
+}
+
+
+#pragma region ClimbTraces
+
+// Perform a capsule trace for multiple objects into OutHits, reusing its buffer
+void UCustomMovementComponent::DoCapsuleTraceMultiByObject(const FVector &Start, const FVector &End, TArray<FHitResult>& OutCapsuleTraceHitResults, bool bShowDebugShape, bool bDrawPresistantShapes)
+{   
+    OutCapsuleTraceHitResults.Reset();
+
+    UWorld* World = GetWorld();
+    if(!World) return;
+
+    // Sweep with the params cached in BeginPlay
+    if(bTraceClimbableChannel)
+    {
+        World->SweepMultiByChannel(OutCapsuleTraceHitResults, Start, End, FQuat::Identity, ECC_Climbable, ClimbCapsuleShape, ClimbQueryParams);
+    }
+    else
+    {
+        World->SweepMultiByObjectType(OutCapsuleTraceHitResults, Start, End, FQuat::Identity, ClimbObjectQueryParams, ClimbCapsuleShape, ClimbQueryParams);
+    }
+    RecordClimbTraces(1, OutCapsuleTraceHitResults.Num());
 
-    // Return the array of hit results
-    return OutCapsuleTraceHitResults;
+#if ENABLE_DRAW_DEBUG
+    // Draw the start and end capsules plus every impact point
+    if(bShowDebugShape)
+    {
+        const FColor TraceColor = OutCapsuleTraceHitResults.IsEmpty() ? FColor::Red : FColor::Green;
+        const float LifeTime = bDrawPresistantShapes ? -1.f : 0.f;
+        DrawDebugCapsule(World, Start, ClimbCapsuleShape.GetCapsuleHalfHeight(), ClimbCapsuleShape.GetCapsuleRadius(), FQuat::Identity, TraceColor, bDrawPresistantShapes, LifeTime);
+        DrawDebugCapsule(World, End, ClimbCapsuleShape.GetCapsuleHalfHeight(), ClimbCapsuleShape.GetCapsuleRadius(), FQuat::Identity, TraceColor, bDrawPresistantShapes, LifeTime);
+        for(const FHitResult& Hit : OutCapsuleTraceHitResults)
+        {
+            DrawDebugPoint(World, Hit.ImpactPoint, 10.f, FColor::Red, bDrawPresistantShapes, LifeTime);
+        }
+    }
+#endif
 }
 
 
@@ -176,53 +409,251 @@ FHitResult UCustomMovementComponent::DoLineTraceSingleByObject(const FVector &St
     // Hit result structure to store information about the hit
     FHitResult OutHit;
 
-    // Set the default debug trace type to none
-    EDrawDebugTrace::Type DebugTraceType = EDrawDebugTrace::None;
+    UWorld* World = GetWorld();
+    if(!World) return OutHit;
 
-    // Check if debug shapes should be shown
-    if(bShowDebugShape){
-        // Set debug trace type to one frame or persistent based on the flag
-        DebugTraceType = EDrawDebugTrace::ForOneFrame;
-        if(bDrawPresistantShapes){
-            DebugTraceType = EDrawDebugTrace::Persistent;
+    // Trace with the params cached in BeginPlay. Climbable geometry only overlaps its channel, so the nearest overlap is the hit
+    if(bTraceClimbableChannel)
+    {
+        World->LineTraceMultiByChannel(ClimbLineTraceHits, Start, End, ECC_Climbable, ClimbQueryParams);
+        if(!ClimbLineTraceHits.IsEmpty())
+        {
+            OutHit = ClimbLineTraceHits[0];
+            OutHit.bBlockingHit = true;
         }
     }
+    else
+    {
+        World->LineTraceSingleByObjectType(OutHit, Start, End, ClimbObjectQueryParams, ClimbQueryParams);
+    }
+    RecordClimbTraces(1, OutHit.bBlockingHit ? 1 : 0);
 
-    // Perform line trace for a single object
-    UKismetSystemLibrary::LineTraceSingleForObjects(
-        this,
-        Start,
-        End,
-        ClimableSurfaceTraceTypes,
-        false,
-        TArray<AActor*>(),
-        DebugTraceType,
-        OutHit,
-        false
-    );
+    // Match what callers used to get back from the kismet trace
+    if(!OutHit.bBlockingHit)
+    {
+        OutHit.TraceStart = Start;
+        OutHit.TraceEnd = End;
+    }
+
+#if ENABLE_DRAW_DEBUG
+    // Draw the trace and the impact point
+    if(bShowDebugShape)
+    {
+        const float LifeTime = bDrawPresistantShapes ? -1.f : 0.f;
+        DrawDebugLine(World, Start, End, OutHit.bBlockingHit ? FColor::Green : FColor::Red, bDrawPresistantShapes, LifeTime);
+        if(OutHit.bBlockingHit)
+        {
+            DrawDebugPoint(World, OutHit.ImpactPoint, 10.f, FColor::Red, bDrawPresistantShapes, LifeTime);
+        }
+    }
+#endif
 
     // Return the hit result structure
     return OutHit;
 }
 
+// Every climb trace lands here, for the perf tests, stat Climbing and the CSV profiler
+void UCustomMovementComponent::RecordClimbTraces(int32 NumTraces, int32 NumHits)
+{
+    ClimbTracesIssued += NumTraces;
+    ClimbTraceHitsReturned += NumHits;
+
+    INC_DWORD_STAT_BY(STAT_ClimbTracesIssued, NumTraces);
+    INC_DWORD_STAT_BY(STAT_ClimbTraceHits, NumHits);
+    CSV_CUSTOM_STAT(Climbing, TracesIssued, NumTraces, ECsvCustomStatOp::Accumulate);
+    CSV_CUSTOM_STAT(Climbing, TraceHits, NumHits, ECsvCustomStatOp::Accumulate);
+}
+
+// Components saved before UClimbProfile kept their tuning on themselves, move what they changed into a profile of their own
+void UCustomMovementComponent::MigrateDeprecatedClimbTuning()
+{
+    const UClimbProfile* Defaults = GetDefault<UClimbProfile>();
+    const bool bHasOverrides = ClimbCapsuleTraceRadius_DEPRECATED != Defaults->ClimbCapsuleTraceRadius
+        || ClimbCapsuleTraceHalfHeight_DEPRECATED != Defaults->ClimbCapsuleTraceHalfHeight
+        || MaxBreakClimbDeceleration_DEPRECATED != Defaults->MaxBreakClimbDeceleration
+        || MaxClimbSpeed_DEPRECATED != Defaults->MaxClimbSpeed
+        || MaxClimbAcceleration_DEPRECATED != Defaults->MaxClimbAcceleration
+        || ClimbDownWalkableSurfaceTraceOffset_DEPRECATED != Defaults->ClimbDownWalkableSurfaceTraceOffset
+        || ClimbDownLedgeTraceOffset_DEPRECATED != Defaults->ClimbDownLedgeTraceOffset;
+
+    // A profile that was set already overrode these, same as before
+    if(ClimbProfile || !bHasOverrides) return;
+
+    // Outered to the component so it saves with it, instances of a template share the template's
+    ClimbProfile = NewObject<UClimbProfile>(this, TEXT("MigratedClimbProfile"), GetMaskedFlags(RF_PropagateToSubObjects));
+    ClimbProfile->ClimbCapsuleTraceRadius = ClimbCapsuleTraceRadius_DEPRECATED;
+    ClimbProfile->ClimbCapsuleTraceHalfHeight = ClimbCapsuleTraceHalfHeight_DEPRECATED;
+    ClimbProfile->MaxBreakClimbDeceleration = MaxBreakClimbDeceleration_DEPRECATED;
+    ClimbProfile->MaxClimbSpeed = MaxClimbSpeed_DEPRECATED;
+    ClimbProfile->MaxClimbAcceleration = MaxClimbAcceleration_DEPRECATED;
+    ClimbProfile->ClimbDownWalkableSurfaceTraceOffset = ClimbDownWalkableSurfaceTraceOffset_DEPRECATED;
+    ClimbProfile->ClimbDownLedgeTraceOffset = ClimbDownLedgeTraceOffset_DEPRECATED;
+    ClimbProfile->BakeConstants();
+
+    UE_LOG(LogClimbing, Log, TEXT("%s: moved its climb tuning into %s, resave it or point ClimbProfile at a shared profile"), *GetPathName(), *ClimbProfile->GetName());
+}
+
+// Components without a shared profile read the class defaults, which bake their constants like any other profile
+void UCustomMovementComponent::InitClimbProfile()
+{
+    ActiveClimbProfile = ClimbProfile ? ClimbProfile : GetDefault<UClimbProfile>();
+}
+
+const UClimbProfile* UCustomMovementComponent::GetClimbProfile() const
+{
+    // Before BeginPlay the class defaults stand in
+    return ActiveClimbProfile ? ActiveClimbProfile : GetDefault<UClimbProfile>();
+}
+
+// Drop the surface hits the rules say cannot be climbed, the rest keep their grip and speed. One cached lookup per hit, the hits keep their sweep order
+void UCustomMovementComponent::ApplyClimbSurfaceRules()
+{
+    ClimbableSurfaceGrips.Reset();
+    if(!SurfaceSubsystem) return;
+
+    float SpeedMultiplierSum = 0.f;
+    for(int32 Index = 0; Index < ClimbableSurfacesTracedResults.Num();)
+    {
+        const FClimbSurfaceRule Rule = SurfaceSubsystem->GetSurfaceRule(ClimbableSurfacesTracedResults[Index]);
+        if(Rule.SurfaceClass == EClimbSurfaceClass::NotClimbable)
+        {
+            ClimbableSurfacesTracedResults.RemoveAt(Index, 1, false);
+            continue;
+        }
+
+        ClimbableSurfaceGrips.Add(Rule.GripMultiplier);
+        SpeedMultiplierSum += Rule.SpeedMultiplier;
+        ++Index;
+    }
+
+    // Nothing left to climb keeps the last speed, the climb is about to stop anyway
+    if(!ClimbableSurfaceGrips.IsEmpty())
+    {
+        ClimbSurfaceSpeedMultiplier = SpeedMultiplierSum / ClimbableSurfaceGrips.Num();
+    }
+}
+
+// Build the collision query once so traces do not rebuild it every call
+void UCustomMovementComponent::BuildClimbQueryParams()
+{
+    ClimbQueryParams = FCollisionQueryParams(SCENE_QUERY_STAT(ClimbTrace), false, CharacterOwner);
+    // Face materials are only worth returning when there are rules to look them up in
+    ClimbQueryParams.bReturnPhysicalMaterial = !GetDefault<UClimbSurfaceSettings>()->PhysicalMaterialRules.IsEmpty();
+
+    ClimbObjectQueryParams = FCollisionObjectQueryParams();
+    for(const TEnumAsByte<EObjectTypeQuery>& ObjectType : ClimableSurfaceTraceTypes)
+    {
+        ClimbObjectQueryParams.AddObjectTypesToQuery(UEngineTypes::ConvertToCollisionChannel(ObjectType));
+    }
+
+    ClimbCapsuleShape = FCollisionShape::MakeCapsule(GetClimbProfile()->ClimbCapsuleTraceRadius, GetClimbProfile()->ClimbCapsuleTraceHalfHeight);
+}
+
+FTraceHandle UCustomMovementComponent::SubmitAsyncClimbSweep(UWorld* World, const FVector& Start, const FVector& End) const
+{
+    if(bTraceClimbableChannel)
+    {
+        return World->AsyncSweepByChannel(EAsyncTraceType::Multi, Start, End, FQuat::Identity, ECC_Climbable, ClimbCapsuleShape, ClimbQueryParams);
+    }
+    return World->AsyncSweepByObjectType(EAsyncTraceType::Multi, Start, End, FQuat::Identity, ClimbObjectQueryParams, ClimbCapsuleShape, ClimbQueryParams);
+}
+
+FTraceHandle UCustomMovementComponent::SubmitAsyncClimbLineTrace(UWorld* World, const FVector& Start, const FVector& End) const
+{
+    // Multi for the same reason as DoLineTraceSingleByObject, the hits come back nearest first
+    if(bTraceClimbableChannel)
+    {
+        return World->AsyncLineTraceByChannel(EAsyncTraceType::Multi, Start, End, ECC_Climbable, ClimbQueryParams);
+    }
+    return World->AsyncLineTraceByObjectType(EAsyncTraceType::Single, Start, End, ClimbObjectQueryParams, ClimbQueryParams);
+}
+
+// Queue this frame's climb probes, they are read back by ConsumeAsyncClimbProbes on the next frame
+void UCustomMovementComponent::SubmitAsyncClimbProbes()
+{
+    UWorld* World = GetWorld();
+    if(!World) return;
+
+    // Only one probe set per frame, extra movement iterations reuse it
+    FClimbProbeFrame& ProbeFrame = AsyncProbeFrames[GFrameCounter % 2];
+    if(ProbeFrame.SubmitFrame == GFrameCounter) return;
+
+    const FClimbProfileConstants& Constants = GetClimbProfile()->GetConstants();
+    const FVector ComponentLocation = UpdatedComponent->GetComponentLocation();
+    const FQuat ComponentQuat = UpdatedComponent->GetComponentQuat();
+
+    // Same shapes as TraceClimableSurfaces
+    ProbeFrame.SurfaceHandle = SubmitAsyncClimbSweep(World, ComponentLocation + ComponentQuat.RotateVector(Constants.SurfaceSweepStart), ComponentLocation + ComponentQuat.RotateVector(Constants.SurfaceSweepEnd));
+
+    // Same shapes as TraceClimbFloor
+    ProbeFrame.FloorHandle = SubmitAsyncClimbSweep(World, ComponentLocation + ComponentQuat.RotateVector(Constants.FloorSweepStart), ComponentLocation + ComponentQuat.RotateVector(Constants.FloorSweepEnd));
+
+    // The ledge is tracked instead, its rare lookahead is traced right away
+
+    ProbeFrame.SubmitFrame = GFrameCounter;
+    RecordClimbTraces(2, 0);
+}
+
+// Read back the probes submitted last frame, returns false if they are not available
+bool UCustomMovementComponent::ConsumeAsyncClimbProbes()
+{
+    UWorld* World = GetWorld();
+    if(!World) return false;
+
+    const FClimbProbeFrame& ProbeFrame = AsyncProbeFrames[(GFrameCounter + 1) % 2];
+    if(ProbeFrame.SubmitFrame == 0 || ProbeFrame.SubmitFrame + 1 != GFrameCounter) return false;
+
+    if(!World->QueryTraceData(ProbeFrame.SurfaceHandle, SurfaceTraceDatum) ||
+       !World->QueryTraceData(ProbeFrame.FloorHandle, FloorTraceDatum))
+    {
+        return false;
+    }
+
+    RecordClimbTraces(0, SurfaceTraceDatum.OutHits.Num() + FloorTraceDatum.OutHits.Num());
+
+    // Copy rather than move, so both sides keep the buffers they already have
+    ClimbableSurfacesTracedResults.Reset();
+    ClimbableSurfacesTracedResults.Append(SurfaceTraceDatum.OutHits);
+    FloorTracedResults.Reset();
+    FloorTracedResults.Append(FloorTraceDatum.OutHits);
+    ApplyClimbSurfaceRules();
+
+    return true;
+}
+
+void UCustomMovementComponent::ResetAsyncClimbProbes()
+{
+    AsyncProbeFrames[0] = FClimbProbeFrame();
+    AsyncProbeFrames[1] = FClimbProbeFrame();
+    bHasAsyncProbeResults = false;
+}
+
 #pragma endregion
 
 #pragma region ClimbCore
+void UCustomMovementComponent::RequestClimbToggle()
+{
+    bWantsToToggleClimb = true;
+}
+
+void UCustomMovementComponent::RequestClimbHop()
+{
+    bWantsToHop = true;
+}
+
 void UCustomMovementComponent::ToggleClimbing(bool bEnableClimb)
 {
+    WakeFromHangSleep();
+
     if(bEnableClimb)
     {   
         if(CanStartClimbing()){
             //enter climb state   
-            // Debug::Print(TEXT("Can Start Climbing"));
             PlayClimbMontage(IdleToClimbMontage);
         }
-        else if(CanClimbDownLedge())
-        {
-            PlayClimbMontage(ClimbDownLedgeMontage);
-        }
         else{
-            TryStartVaulting();
+            // Climb down, vault, step over or mantle, whatever the obstacle ahead allows
+            TryStartObstacleTraversal();
         }
     }
     if(!bEnableClimb){
@@ -236,52 +667,21 @@ bool UCustomMovementComponent::CanStartClimbing()
 {
     // if(IsFalling())return false;
     if(!TraceClimableSurfaces()) return false;
-    if(!TraceFromEyeHeight(100.f).bBlockingHit) return false;
+    if(!TraceFromEyeHeight(GetClimbProfile()->EyeTraceDistance).bBlockingHit) return false;
 
     return true;
 }
 
-bool UCustomMovementComponent::CanClimbDownLedge()
-{   
-    // Check if the character is currently falling
-    if(IsFalling()) return false;
-
-    // Get the current location, forward vector, and downward vector of the character
-    const FVector ComponentLocation = UpdatedComponent->GetComponentLocation();
-    const FVector ComponentForward = UpdatedComponent->GetForwardVector();
-    const FVector DownVector = -UpdatedComponent->GetUpVector();
-
-    // Define the starting point for the walkable surface trace
-    const FVector WalkableSurfaceTraceStart = ComponentLocation +  ComponentForward * ClimbDownWalkableSurfaceTraceOffset;
-    // Define the ending point for the walkable surface trace
-    const FVector WalkableSurfaceTraceEnd = WalkableSurfaceTraceStart + DownVector * 100.f;
-
-    // Perform a line trace to detect a walkable surface below the character
-    FHitResult WalkableSurfaceHit = DoLineTraceSingleByObject(WalkableSurfaceTraceStart, WalkableSurfaceTraceEnd);
-
-    // Define the starting point for the ledge trace after finding a walkable surface
-    const FVector LedgeTraceStart = WalkableSurfaceHit.TraceStart + ComponentForward * ClimbDownLedgeTraceOffset;
-    // Define the ending point for the ledge trace
-    const FVector LedgeTraceEnd = LedgeTraceStart + DownVector * 200.f ;
-
-    // Perform another line trace to check for a ledge below the walkable surface
-    FHitResult LedgeTraceHit = DoLineTraceSingleByObject(LedgeTraceStart, LedgeTraceEnd);
-
-    // If there is a walkable surface hit but no ledge hit, return true (indicating the ability to climb down)
-    if(WalkableSurfaceHit.bBlockingHit && !LedgeTraceHit.bBlockingHit)
-    {
-        return true;
-    }
-    
-    // Otherwise, return false
-    return false;
-}
-
-
 void UCustomMovementComponent::StartClimbing()
 {   
     SetMovementMode(MOVE_Custom,ECustomMovementMode::MOVE_Climb);
 }
+void UCustomMovementComponent::ForceStartClimbing()
+{
+    StartClimbing();
+    StopMovementImmediately();
+}
+
 void UCustomMovementComponent::StopClimbing()
 {   
     SetMovementMode(MOVE_Falling);
@@ -290,24 +690,74 @@ void UCustomMovementComponent::StopClimbing()
 // Custom physics handling for climbing movement mode
 void UCustomMovementComponent::PhysClimb(float deltaTime, int32 Iterations)
 {   
+    CLIMB_SCOPE_CYCLE_COUNTER(STAT_PhysClimb);
+    // Server moves run from RPCs, outside the component tick
+    LLM_SCOPE_BYTAG(Climbing);
+
     // Ensure deltaTime is above a minimum threshold to avoid division by zero
     if (deltaTime < MIN_TICK_TIME)
 	{
 		return;
 	}
 
+    // Unseen climbers hold still until someone looks at them again
+    if(ClimbLODTier == EClimbLODTier::Frozen)
+    {
+        Velocity = FVector::ZeroVector;
+        return;
+    }
+
+    // While anchored asleep skip every probe and move until something wakes us
+    if(bHangSleeping)
+    {
+        if(!ShouldWakeFromHangSleep(deltaTime))
+        {
+            Velocity = FVector::ZeroVector;
+            return;
+        }
+
+        // A timeout only revalidates, so go straight back to sleep if this tick finds nothing changed
+        const bool bRevalidating = HangSleepElapsed >= HangSleepRevalidateInterval;
+        WakeFromHangSleep();
+        if(bRevalidating)
+        {
+            HangStillTime = HangSleepDelay;
+        }
+    }
+
 	/* Process all climbable surfaces information */
-    TraceClimableSurfaces();
-    ProcessClimbableSurfaceInfo();
+    // The batched simulation already probed and decided for this frame, otherwise do it here.
+    // Reduced LOD frames without probes keep going along the last surface
+    bool bShouldStopClimbing = false;
+    bool bReachedLedge = false;
+    if(HasClimbSolve())
+    {
+        CurrentClimbableSurfaceLocation = ClimbSolve.SurfaceLocation;
+        CurrentClimbableSurfaceNormal = ClimbSolve.SurfaceNormal;
+        bShouldStopClimbing = ClimbSolve.bShouldStop;
+        bReachedLedge = ClimbSolve.bReachedLedge;
+    }
+    else if(ShouldProbeThisFrame())
+    {
+        RunClimbProbes();
+        ProcessClimbableSurfaceInfo();
+        bShouldStopClimbing = CheckShouldStopClimbing() || CheckHasReahedFloor();
+        bReachedLedge = CheckHasReachedLedge();
+    }
+    else if(!bLedgeAnsweredByBakedData)
+    {
+        // The tracked ledge is only a height compare, so it is still checked on frames without probes
+        bReachedLedge = CheckHasReachedLedge();
+    }
 
 	/* Check if we should stop climbing */
-    if(CheckShouldStopClimbing() || CheckHasReahedFloor())
+    if(bShouldStopClimbing)
     {
         StopClimbing();
     }
 
     // Check if the character has reached a ledge during climbing
-    if(CheckHasReachedLedge())
+    if(bReachedLedge)
     {
         // Play the climb to top montage
         PlayClimbMontage(ClimbToTopMontage);
@@ -323,12 +773,29 @@ void UCustomMovementComponent::PhysClimb(float deltaTime, int32 Iterations)
     if( !HasAnimRootMotion() && !CurrentRootMotion.HasOverrideVelocity() )
     {
         // Calculate velocity based on max climb speed and acceleration
-        CalcVelocity(deltaTime, 0.f, true, MaxBreakClimbDeceleration);
+        CalcVelocity(deltaTime, 0.f, true, GetClimbProfile()->MaxBreakClimbDeceleration);
     }
 
     // Apply root motion to velocity
     ApplyRootMotionToVelocity(deltaTime);
 
+    // Far away climbers only slide along the last surface plane, no probes, rotation or snap, but still swept so they never pass through anything
+    if(ClimbLODTier == EClimbLODTier::SurfaceLocked && !HasAnimRootMotion() && !CurrentRootMotion.HasOverrideVelocity())
+    {
+        Velocity = FVector::VectorPlaneProject(Velocity, CurrentClimbableSurfaceNormal);
+        const FVector LockedDelta = Velocity * deltaTime;
+        FHitResult LockedHit(1.f);
+        SafeMoveUpdatedComponent(LockedDelta, UpdatedComponent->GetComponentQuat(), true, LockedHit);
+        if(LockedHit.Time < 1.f)
+        {
+            HandleImpact(LockedHit, deltaTime, LockedDelta);
+            SlideAlongSurface(LockedDelta, 1.f - LockedHit.Time, LockedHit.Normal, LockedHit, true);
+        }
+        UpdateHangSleep(deltaTime);
+        ClimbSolve.SolveFrame = 0;
+        return;
+    }
+
     // Save the current location
     FVector OldLocation = UpdatedComponent->GetComponentLocation();
     // Calculate adjusted movement based on velocity and time
@@ -355,70 +822,51 @@ void UCustomMovementComponent::PhysClimb(float deltaTime, int32 Iterations)
 
     /* Snap movement to climbable surfaces */
     SnapMovementToClimableSurfaces(deltaTime);
+
+    // The solve is only good for the first iteration, any further one this frame probes for itself
+    ClimbSolve.SolveFrame = 0;
+
+    // Go to sleep once we have been hanging still for long enough
+    UpdateHangSleep(deltaTime);
 }
 
 
 void UCustomMovementComponent::ProcessClimbableSurfaceInfo()
 {
-    CurrentClimbableSurfaceLocation = FVector::ZeroVector;
-
-    CurrentClimbableSurfaceNormal = FVector::ZeroVector;
-
-    if(ClimbableSurfacesTracedResults.IsEmpty()) return;
-
-    for(const FHitResult& TracedHitResult : ClimbableSurfacesTracedResults){
-        CurrentClimbableSurfaceLocation += TracedHitResult.ImpactPoint;
-        CurrentClimbableSurfaceNormal += TracedHitResult.ImpactNormal;
-    }
-
-    CurrentClimbableSurfaceLocation /= ClimbableSurfacesTracedResults.Num();
-    CurrentClimbableSurfaceNormal = CurrentClimbableSurfaceNormal.GetSafeNormal();
+    CLIMB_SCOPE_CYCLE_COUNTER(STAT_ProcessClimbableSurfaceInfo);
 
+    ClimbMath::ReduceClimbableSurface(ClimbableSurfacesTracedResults, ClimbableSurfaceGrips, UpdatedComponent->GetComponentLocation(), UpdatedComponent->GetForwardVector(),
+        CurrentClimbableSurfaceLocation, CurrentClimbableSurfaceNormal);
 }
 
 bool UCustomMovementComponent::CheckShouldStopClimbing()
 {   
-    if(ClimbableSurfacesTracedResults.IsEmpty()) return true;
-    const float DotResult = FVector::DotProduct(CurrentClimbableSurfaceNormal,FVector::UpVector);
-    const float DegreeDiff = FMath::RadiansToDegrees(FMath::Acos(DotResult));
+    // No contacts, only unclimbable ones, or only the back sides of thin geometry
+    if(CurrentClimbableSurfaceNormal.IsZero()) return true;
 
-    if(DegreeDiff<=60.f)
+    if(ClimbMath::IsSurfaceTooFlat(CurrentClimbableSurfaceNormal, GetClimbProfile()->GetConstants().TooFlatSurfaceUpDot))
     {
         return true;
     }
     
-    Debug::Print(TEXT("Degree Diff: ") + FString::SanitizeFloat(DegreeDiff),FColor::Cyan,1);
+    CLIMB_VLOG_ARROW(CharacterOwner, CurrentClimbableSurfaceLocation, CurrentClimbableSurfaceLocation + CurrentClimbableSurfaceNormal * 50.f, FColor::Cyan,
+        TEXT("Surface up dot %.2f"), CurrentClimbableSurfaceNormal.Z);
 
     return false;
 }
 
 bool UCustomMovementComponent::CheckHasReahedFloor()
 {
-    // Define a vector pointing downwards based on the component's up vector
-    const FVector DownVector = -UpdatedComponent->GetUpVector();
-
-    // Offset the start position by moving down 50 units
-    const FVector StartOffset = DownVector * 50.f;
-
-    // Calculate the start and end positions for the capsule trace
-    const FVector Start = UpdatedComponent->GetComponentLocation() + StartOffset;
-    const FVector End = Start + DownVector;
-
-    // Perform a capsule trace to detect the floor hits
-    TArray<FHitResult> PossibleFloorHits = DoCapsuleTraceMultiByObject(Start, End);
+    CLIMB_SCOPE_CYCLE_COUNTER(STAT_CheckHasReahedFloor);
 
-    // If no floor hits, return false
-    if (PossibleFloorHits.IsEmpty()) return false;
+    const FVector UnrotatedClimbVelocity = GetUnrotatedClimbVelocity();
+    const float MinVerticalClimbSpeed = GetClimbProfile()->GetConstants().MinVerticalClimbSpeed;
 
     // Iterate through the possible floor hits
-    for (const FHitResult& PossibleFloorHit : PossibleFloorHits)
+    for (const FHitResult& PossibleFloorHit : FloorTracedResults)
     {
         // Check if the floor is walkable based on certain conditions
-        const bool bFloorReached = FVector::Parallel(-PossibleFloorHit.ImpactNormal, FVector::UpVector) &&
-            GetUnrotatedClimbVelocity().Z < -10.f;
-
-        // If the floor is reached, return true
-        if (bFloorReached) return true;
+        if (ClimbMath::IsFloorReached(PossibleFloorHit.ImpactNormal, UnrotatedClimbVelocity, MinVerticalClimbSpeed)) return true;
     }
 
     // If no matching floor conditions found, return false
@@ -427,74 +875,315 @@ bool UCustomMovementComponent::CheckHasReahedFloor()
 
 bool UCustomMovementComponent::CheckHasReachedLedge()
 {
-    FHitResult LedgeHitResult = TraceFromEyeHeight(100.f,50.f);
-    if(!LedgeHitResult.bBlockingHit)
-    {
-        const FVector WalkableSurfaceTraceStart = LedgeHitResult.TraceEnd;
-        const FVector DownVector = -UpdatedComponent->GetUpVector();
-        const FVector WalkableSurfaceTraceEnd = WalkableSurfaceTraceStart + DownVector * 100.f;
+    CLIMB_SCOPE_CYCLE_COUNTER(STAT_CheckHasReachedLedge);
 
-        FHitResult WalkableSurfaceHitResult = DoLineTraceSingleByObject(WalkableSurfaceTraceStart,WalkableSurfaceTraceEnd);
+    if(bLedgeAnsweredByBakedData) return bBakedLedgeReached;
+    if(!LedgeTrack.bHasLedge) return false;
 
-        if(WalkableSurfaceHitResult.bBlockingHit)
-        {
-            const bool bLedgeReached = FVector::Parallel(-WalkableSurfaceHitResult.ImpactNormal, FVector::UpVector) &&
-            GetUnrotatedClimbVelocity().Z > 10.f;
+    // Reached as soon as the tracked top comes within reach above the eyes
+    const FClimbProfileConstants& Constants = GetClimbProfile()->GetConstants();
+    const FVector UpVector = UpdatedComponent->GetUpVector();
+    const FVector EyeLocation = UpdatedComponent->GetComponentLocation() + UpVector * CharacterOwner->BaseEyeHeight;
+    const float LedgeHeight = FVector::DotProduct(LedgeTrack.LedgePoint - EyeLocation, UpVector);
 
-            return bLedgeReached;
-        }
-    }
-    return false;
+    return ClimbMath::IsLedgeReached(LedgeHeight, Constants.LedgeReachHeight, GetUnrotatedClimbVelocity(), Constants.MinVerticalClimbSpeed);
 }
 
-void UCustomMovementComponent::TryStartVaulting()
-{   
-    FVector VaultStartPos;
-    FVector VaultEndPos;
-    if(CanStartVaulting(VaultStartPos,VaultEndPos)){
-        // start vaulting
-        // Debug::Print(TEXT("Start Position : ") + VaultStartPos.ToCompactString());
-        // Debug::Print(TEXT("End Position : ") + VaultEndPos.ToCompactString());
+// Primitive the climb sweep found in front of us, if any
+UPrimitiveComponent* UCustomMovementComponent::GetClimbedSurfaceComponent() const
+{
+    return ClimbableSurfacesTracedResults.IsEmpty() ? nullptr : ClimbableSurfacesTracedResults[0].GetComponent();
+}
 
-        SetMotionWarpTarget(FName("VaultStartPos"),VaultStartPos);
-        SetMotionWarpTarget(FName("VaultEndPos"),VaultEndPos);
+// The baked graph, but only when it was baked from this primitive
+const UClimbLedgeGraph* UCustomMovementComponent::GetLedgeGraphFor(const UPrimitiveComponent* Component) const
+{
+    if(!LedgeGraphSubsystem || !LedgeGraphSubsystem->IsComponentBaked(Component)) return nullptr;
+    return LedgeGraphSubsystem->GetLedgeGraph();
+}
 
-        StartClimbing();
-        PlayClimbMontage(VaultMontage);
+// Answer CheckHasReachedLedge from the baked graph, returns false if the graph has nothing here and traces are needed
+bool UCustomMovementComponent::QueryLedgeGraphForLedge(bool& bOutReachedLedge)
+{
+    const UClimbLedgeGraph* LedgeGraph = GetLedgeGraphFor(GetClimbedSurfaceComponent());
+    if(!LedgeGraph) return false;
+
+    // Same window the ledge lookahead ends in: the edge below the reach height and above the end of the lookahead
+    const FClimbProfileConstants& Constants = GetClimbProfile()->GetConstants();
+    const FVector EyeLocation = UpdatedComponent->GetComponentLocation() + UpdatedComponent->GetUpVector() * CharacterOwner->BaseEyeHeight;
+    FVector LedgePoint;
+    const bool bLedgeInReach = LedgeGraph->FindLedge(EyeLocation, UpdatedComponent->GetForwardVector(), Constants.LedgeLookaheadStart.X,
+        EyeLocation.Z + Constants.LedgeLookaheadEnd.Z, EyeLocation.Z + Constants.LedgeReachHeight, true, LedgePoint) != nullptr;
+
+    // No ledge is only an answer when the graph has the wall we are on, seams and odd shapes the bake skipped are traced
+    FVector WallPoint;
+    if(!bLedgeInReach && !LedgeGraph->FindWall(EyeLocation, UpdatedComponent->GetForwardVector(), GetClimbProfile()->EyeTraceDistance,
+        EyeLocation.Z, EyeLocation.Z, WallPoint))
+    {
+        return false;
+    }
+
+    bOutReachedLedge = bLedgeInReach && GetUnrotatedClimbVelocity().Z > Constants.MinVerticalClimbSpeed && ConfirmBakedLedge();
+    return true;
+}
+
+// Answer CheckHasReachedLedge from the ledge edges cached on the climbed static mesh, returns false if it has none
+bool UCustomMovementComponent::QueryMeshLedgeEdgesForLedge(bool& bOutReachedLedge)
+{
+    if(ClimbableSurfacesTracedResults.IsEmpty()) return false;
+    const FHitResult& SurfaceHit = ClimbableSurfacesTracedResults[0];
 
+    UStaticMeshComponent* StaticMeshComponent = Cast<UStaticMeshComponent>(SurfaceHit.GetComponent());
+    UStaticMesh* StaticMesh = StaticMeshComponent ? StaticMeshComponent->GetStaticMesh() : nullptr;
+    const UClimbLedgeEdgeUserData* LedgeEdges = StaticMesh ? StaticMesh->GetAssetUserData<UClimbLedgeEdgeUserData>() : nullptr;
+    if(!LedgeEdges) return false;
+
+    // Instances share the mesh's edges, only their transform differs
+    FTransform MeshToWorld = StaticMeshComponent->GetComponentTransform();
+    if(const UInstancedStaticMeshComponent* InstancedComponent = Cast<UInstancedStaticMeshComponent>(StaticMeshComponent))
+    {
+        if(!InstancedComponent->GetInstanceTransform(SurfaceHit.Item, MeshToWorld, true)) return false;
     }
-    else{
-        Debug::Print(TEXT("Unable to Vault"));
 
+    // Same window as QueryLedgeGraphForLedge
+    const FClimbProfileConstants& Constants = GetClimbProfile()->GetConstants();
+    const FVector EyeLocation = UpdatedComponent->GetComponentLocation() + UpdatedComponent->GetUpVector() * CharacterOwner->BaseEyeHeight;
+    FVector LedgePoint;
+    const bool bLedgeInReach = LedgeEdges->FindLedge(MeshToWorld, EyeLocation, UpdatedComponent->GetForwardVector(), Constants.LedgeLookaheadStart.X,
+        EyeLocation.Z + Constants.LedgeLookaheadEnd.Z, EyeLocation.Z + Constants.LedgeReachHeight, LedgePoint);
+
+    bOutReachedLedge = bLedgeInReach && GetUnrotatedClimbVelocity().Z > Constants.MinVerticalClimbSpeed && ConfirmBakedLedge();
+    return true;
+}
+
+// Baked edges do not know about geometry stacked on top of them, one eye height trace on the frame the edge is reached rules that out
+bool UCustomMovementComponent::ConfirmBakedLedge()
+{
+    return !TraceFromEyeHeight(GetClimbProfile()->EyeTraceDistance, GetClimbProfile()->LedgeTraceHeight).bBlockingHit;
+}
+
+// The baked graph answers right away, otherwise the scan goes out as one async batch and FinishObstacleTraversal acts on it
+void UCustomMovementComponent::TryStartObstacleTraversal()
+{
+    if(IsFalling()) return;
+
+    FClimbObstacleProfile Obstacle;
+    if(QueryLedgeGraphForObstacle(Obstacle))
+    {
+        StartObstacleTraversal(Obstacle);
+        return;
     }
+
+    SubmitObstacleScan();
 }
 
-bool UCustomMovementComponent::CanStartVaulting(FVector& OutVaultStartPos,FVector& OutVaultEndPos)
-{   
-    if(IsFalling()) return false;
+// Runs on the first move after the scan was submitted
+void UCustomMovementComponent::FinishObstacleTraversal()
+{
+    FClimbObstacleProfile Obstacle;
+    const bool bScanRead = ConsumeObstacleScan(Obstacle);
 
-    OutVaultStartPos = FVector::ZeroVector;
-    OutVaultEndPos = FVector::ZeroVector;
+    // Things may have moved on since the request
+    if(IsFalling() || IsClimbing()) return;
 
-    FVector ComponentLocation = UpdatedComponent->GetComponentLocation();
-    FVector ForwardVector = UpdatedComponent->GetForwardVector();
-    FVector UpVector = UpdatedComponent->GetUpVector();
-    FVector DownVector = -UpdatedComponent->GetUpVector();
+    // Too late to read the batch back, the server may not get a move every frame, so scan again from here
+    if(!bScanRead)
+    {
+        ScanObstacleProfile(Obstacle);
+    }
 
-    for (int i = 0; i < 5; i++){
-        FVector Start = ComponentLocation + UpVector * 50.f + ForwardVector * 50.f * (i+1);
-        FVector End = Start + DownVector * 80.f * (i+1);
-        FHitResult Hit = DoLineTraceSingleByObject(Start,End);
+    StartObstacleTraversal(Obstacle);
+}
 
-        if(i==0 && Hit.bBlockingHit){
-            OutVaultStartPos = Hit.ImpactPoint;
-        }
-        if(i==4 && Hit.bBlockingHit){
-            OutVaultEndPos = Hit.ImpactPoint;
+void UCustomMovementComponent::StartObstacleTraversal(const FClimbObstacleProfile& Obstacle)
+{
+    const EClimbObstacleAction Action = ClimbMath::ChooseObstacleAction(Obstacle, GetClimbProfile()->GetConstants().ObstacleRules);
+    switch(Action)
+    {
+    case EClimbObstacleAction::ClimbDown:
+        PlayClimbMontage(ClimbDownLedgeMontage);
+        break;
+
+    case EClimbObstacleAction::StepOver:
+    case EClimbObstacleAction::Vault:
+        CLIMB_VLOG_SEGMENT(CharacterOwner, Obstacle.TopPoint, Obstacle.LandingPoint, FColor::Orange, TEXT("Vault %.0f high %.0f deep"), Obstacle.Height, Obstacle.Depth);
+
+        SetMotionWarpTarget(VaultStartWarpTarget,Obstacle.TopPoint);
+        SetMotionWarpTarget(VaultEndWarpTarget,Obstacle.LandingPoint);
+
+        StartClimbing();
+        PlayClimbMontage(Action == EClimbObstacleAction::StepOver && !StepOverMontage.IsNull() ? StepOverMontage : VaultMontage);
+        break;
+
+    case EClimbObstacleAction::Mantle:
+        if(MantleMontage.IsNull())
+        {
+            CLIMB_LOG(Log, TEXT("%s could mantle but has no mantle montage"), *GetNameSafe(CharacterOwner));
+            break;
         }
+        CLIMB_VLOG_LOCATION(CharacterOwner, Obstacle.TopPoint, 10.f, FColor::Orange, TEXT("Mantle %.0f high"), Obstacle.Height);
+
+        SetMotionWarpTarget(MantleTopWarpTarget,Obstacle.TopPoint);
+
+        StartClimbing();
+        PlayClimbMontage(MantleMontage);
+        break;
+
+    default:
+        CLIMB_LOG(Log, TEXT("%s found nothing to traverse, obstacle %.0f high %.0f deep with %.0f clearance"),
+            *GetNameSafe(CharacterOwner), Obstacle.Height, Obstacle.Depth, Obstacle.Clearance);
+        break;
     }
+}
 
-    if(OutVaultEndPos != FVector::ZeroVector && OutVaultStartPos != FVector::ZeroVector) return true;
+// Height profile of what is in front of a standing character, from the baked graph or one fixed set of traces
+void UCustomMovementComponent::ScanObstacleProfile(FClimbObstacleProfile& OutProfile)
+{
+    CLIMB_SCOPE_CYCLE_COUNTER(STAT_ScanObstacleProfile);
+
+    if(QueryLedgeGraphForObstacle(OutProfile)) return;
+
+    const UClimbProfile* Profile = GetClimbProfile();
+    const FVector ForwardVector = UpdatedComponent->GetForwardVector();
+    const FVector UpVector = UpdatedComponent->GetUpVector();
+    const FVector FeetLocation = UpdatedComponent->GetComponentLocation() - UpVector * CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+    const FVector ScanTop = FeetLocation + UpVector * Profile->ObstacleScanHeight;
+
+    // One trace along the top of the scan finds walls and overhangs, columns under them would start inside and miss
+    const FHitResult CeilingHit = DoLineTraceSingleByObject(ScanTop, ScanTop + ForwardVector * Profile->ObstacleScanDistance);
+    const float CeilingDistance = CeilingHit.bBlockingHit ? CeilingHit.Distance : TNumericLimits<float>::Max();
+
+    // Every column is traced, none depends on another, deep enough to tell a drop to climb down from a step down
+    const int32 NumColumns = FMath::Clamp(Profile->ObstacleScanColumns, 2, 32);
+    const float ColumnDepth = Profile->ObstacleScanHeight + Profile->ClimbDownLedgeTraceDepth;
+
+    TArray<FClimbObstacleSample, TInlineAllocator<32>> Samples;
+    Samples.SetNum(NumColumns);
+    for(int32 Column = 0; Column < NumColumns; ++Column)
+    {
+        FClimbObstacleSample& Sample = Samples[Column];
+        Sample.Distance = Profile->ObstacleScanDistance * (Column + 1) / NumColumns;
+
+        const FVector Start = ScanTop + ForwardVector * Sample.Distance;
+        const FHitResult Hit = DoLineTraceSingleByObject(Start, Start - UpVector * ColumnDepth);
+        Sample.bHit = Hit.bBlockingHit;
+        Sample.ImpactPoint = Hit.ImpactPoint;
+        Sample.Height = FVector::DotProduct(Hit.ImpactPoint - FeetLocation, UpVector);
+    }
+
+    ClimbMath::BuildObstacleProfile(Samples, Profile->ObstacleScanHeight, CeilingDistance, Profile->MinObstacleHeight, OutProfile);
+}
+
+// The same traces as ScanObstacleProfile, queued together instead of waited on one by one
+void UCustomMovementComponent::SubmitObstacleScan()
+{
+    UWorld* World = GetWorld();
+    if(!World) return;
+
+    const UClimbProfile* Profile = GetClimbProfile();
+    const FVector ForwardVector = UpdatedComponent->GetForwardVector();
+    ObstacleScan.UpVector = UpdatedComponent->GetUpVector();
+    ObstacleScan.FeetLocation = UpdatedComponent->GetComponentLocation() - ObstacleScan.UpVector * CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+    const FVector ScanTop = ObstacleScan.FeetLocation + ObstacleScan.UpVector * Profile->ObstacleScanHeight;
+
+    ObstacleScan.CeilingHandle = SubmitAsyncClimbLineTrace(World, ScanTop, ScanTop + ForwardVector * Profile->ObstacleScanDistance);
+
+    const int32 NumColumns = FMath::Clamp(Profile->ObstacleScanColumns, 2, 32);
+    const float ColumnDepth = Profile->ObstacleScanHeight + Profile->ClimbDownLedgeTraceDepth;
+    ObstacleScan.ColumnHandles.Reset();
+    for(int32 Column = 0; Column < NumColumns; ++Column)
+    {
+        const FVector Start = ScanTop + ForwardVector * (Profile->ObstacleScanDistance * (Column + 1) / NumColumns);
+        ObstacleScan.ColumnHandles.Add(SubmitAsyncClimbLineTrace(World, Start, Start - ObstacleScan.UpVector * ColumnDepth));
+    }
+
+    ObstacleScan.SubmitFrame = GFrameCounter;
+    RecordClimbTraces(NumColumns + 1, 0);
+}
+
+// Build the profile from the scan submitted last frame, returns false if its results are gone
+bool UCustomMovementComponent::ConsumeObstacleScan(FClimbObstacleProfile& OutProfile)
+{
+    const uint64 SubmitFrame = ObstacleScan.SubmitFrame;
+    ObstacleScan.SubmitFrame = 0;
+
+    UWorld* World = GetWorld();
+    if(!World || SubmitFrame == 0 || SubmitFrame + 1 != GFrameCounter) return false;
+
+    const UClimbProfile* Profile = GetClimbProfile();
+
+    if(!World->QueryTraceData(ObstacleScan.CeilingHandle, ObstacleTraceDatum)) return false;
+    const float CeilingDistance = ObstacleTraceDatum.OutHits.IsEmpty() ? TNumericLimits<float>::Max() : ObstacleTraceDatum.OutHits[0].Distance;
+    int32 NumHits = ObstacleTraceDatum.OutHits.IsEmpty() ? 0 : 1;
+
+    const int32 NumColumns = ObstacleScan.ColumnHandles.Num();
+    TArray<FClimbObstacleSample, TInlineAllocator<32>> Samples;
+    Samples.SetNum(NumColumns);
+    for(int32 Column = 0; Column < NumColumns; ++Column)
+    {
+        if(!World->QueryTraceData(ObstacleScan.ColumnHandles[Column], ObstacleTraceDatum)) return false;
+
+        FClimbObstacleSample& Sample = Samples[Column];
+        Sample.Distance = Profile->ObstacleScanDistance * (Column + 1) / NumColumns;
+        if(ObstacleTraceDatum.OutHits.IsEmpty()) continue;
+
+        // Nearest first on the Climbable channel too, same as DoLineTraceSingleByObject
+        const FHitResult& Hit = ObstacleTraceDatum.OutHits[0];
+        Sample.bHit = true;
+        Sample.ImpactPoint = Hit.ImpactPoint;
+        Sample.Height = FVector::DotProduct(Hit.ImpactPoint - ObstacleScan.FeetLocation, ObstacleScan.UpVector);
+        ++NumHits;
+    }
+    RecordClimbTraces(0, NumHits);
+
+    ClimbMath::BuildObstacleProfile(Samples, Profile->ObstacleScanHeight, CeilingDistance, Profile->MinObstacleHeight, OutProfile);
+    return true;
+}
+
+// Fill the obstacle profile from the baked graph, returns false if it has nothing here and the scan has to trace
+bool UCustomMovementComponent::QueryLedgeGraphForObstacle(FClimbObstacleProfile& OutProfile) const
+{
+    const UClimbLedgeGraph* LedgeGraph = LedgeGraphSubsystem ? LedgeGraphSubsystem->GetLedgeGraph() : nullptr;
+    if(!LedgeGraph) return false;
+
+    const UClimbProfile* Profile = GetClimbProfile();
+    const FVector ComponentLocation = UpdatedComponent->GetComponentLocation();
+    const FVector ForwardVector = UpdatedComponent->GetForwardVector();
+    const float FeetZ = ComponentLocation.Z - CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+
+    OutProfile = FClimbObstacleProfile();
+
+    // Spans carry nothing about what is overhead, take the whole scan height above one as free
+    FVector TopPoint;
+    if(const FClimbVaultSpan* Span = LedgeGraph->FindVault(ComponentLocation, ForwardVector, Profile->ObstacleScanDistance,
+        FeetZ + Profile->MinObstacleHeight, FeetZ + Profile->ObstacleScanHeight, TopPoint))
+    {
+        OutProfile.bHasObstacle = true;
+        OutProfile.Height = TopPoint.Z - FeetZ;
+        OutProfile.Distance = FVector::Dist2D(ComponentLocation, TopPoint);
+        OutProfile.Depth = Span->Depth;
+        OutProfile.Clearance = Profile->ObstacleScanHeight - OutProfile.Height;
+        OutProfile.bHasLanding = OutProfile.Distance + Span->Depth < Profile->ObstacleScanDistance;
+        OutProfile.LandingHeight = Span->LandingZ - FeetZ;
+        OutProfile.TopPoint = TopPoint;
+        OutProfile.LandingPoint = ComponentLocation + ForwardVector * Profile->ObstacleScanDistance;
+        OutProfile.LandingPoint.Z = Span->LandingZ;
+        return true;
+    }
+
+    // Standing on baked geometry the graph knows every ledge around us, a top at foot level with a drop the scan would not reach the bottom of
+    if(GetLedgeGraphFor(CurrentFloor.HitResult.GetComponent()))
+    {
+        FVector LedgePoint;
+        const FClimbLedgeSegment* Ledge = LedgeGraph->FindLedge(ComponentLocation, ForwardVector, Profile->GetConstants().ObstacleRules.MaxClimbDownDistance,
+            FeetZ - Profile->MinObstacleHeight, FeetZ + Profile->MinObstacleHeight, false, LedgePoint);
+        if(Ledge && Ledge->Drop > Profile->ClimbDownLedgeTraceDepth - (FeetZ - LedgePoint.Z))
+        {
+            OutProfile.bHasDrop = true;
+            OutProfile.DropDistance = FVector::Dist2D(ComponentLocation, LedgePoint);
+            return true;
+        }
+    }
 
     return false;
 }
@@ -510,33 +1199,32 @@ FQuat UCustomMovementComponent::GetClimbRotation(float DeltaTime)
         return CurrentQuat;
     }
 
-    // If there's no animation root motion or override velocity:
-    // Create a rotation based on the negative of the current climbable surface normal
-    const FQuat TargetQuat = FRotationMatrix::MakeFromX(-CurrentClimbableSurfaceNormal).ToQuat();
+    // The batched simulation already blended it for this frame
+    if (HasClimbSolve()) {
+        return ClimbSolve.ClimbRotation;
+    }
 
-    // Interpolate (blend) between the current rotation and the target rotation over time (DeltaTime)
-    // The 5.f is a speed factor, controlling how fast the interpolation happens
-    return FMath::QInterpTo(CurrentQuat, TargetQuat, DeltaTime, 5.f);
+    // If there's no animation root motion or override velocity:
+    // Blend towards facing against the current climbable surface normal at the profile's turn speed
+    return ClimbMath::GetClimbRotation(CurrentQuat, CurrentClimbableSurfaceNormal, DeltaTime, GetClimbProfile()->GetConstants().RotationInterpSpeed);
 }
 
 
 void UCustomMovementComponent::SnapMovementToClimableSurfaces(float DeltaTime)
 {   
-    // Get the forward direction of the movement component
-    const FVector ComponentForward = UpdatedComponent->GetForwardVector();
-
-    // Get the current location of the movement component
-    const FVector ComponentLocation = UpdatedComponent->GetComponentLocation();
-
-    // Project the vector from the character to the climbable surface onto the forward direction
-    const FVector ProjectedCharacterToSurface = (CurrentClimbableSurfaceLocation - ComponentLocation).ProjectOnTo(ComponentForward);
-
-    // Calculate a vector that "snaps" the character to the climbable surface
-    const FVector SnapVector = -CurrentClimbableSurfaceNormal * ProjectedCharacterToSurface.Length();
+    CLIMB_SCOPE_CYCLE_COUNTER(STAT_SnapMovementToClimableSurfaces);
+
+    // Calculate a vector that "snaps" the character to the climbable surface, from where this frame's move left us
+    const FVector SnapVector = ClimbMath::GetSnapVector(
+        UpdatedComponent->GetComponentLocation(),
+        UpdatedComponent->GetForwardVector(),
+        CurrentClimbableSurfaceLocation,
+        CurrentClimbableSurfaceNormal
+    );
 
     // Move the component based on the snap vector, time, and maximum climb speed
     UpdatedComponent->MoveComponent(
-        SnapVector * DeltaTime * MaxClimbSpeed,
+        SnapVector * DeltaTime * GetClimbProfile()->MaxClimbSpeed,
         UpdatedComponent->GetComponentQuat(),
         true
     );
@@ -544,24 +1232,398 @@ void UCustomMovementComponent::SnapMovementToClimableSurfaces(float DeltaTime)
 
 
 
+// Count how long we have been hanging still and anchor to the surface once it is long enough
+void UCustomMovementComponent::UpdateHangSleep(float DeltaTime)
+{
+    // Still means no input, no root motion, no velocity and already facing the surface
+    const bool bHangingStill = bEnableHangSleep &&
+        IsClimbing() &&
+        !ClimbableSurfacesTracedResults.IsEmpty() &&
+        Acceleration.IsNearlyZero() &&
+        Velocity.IsNearlyZero(1.f) &&
+        !HasAnimRootMotion() &&
+        !CurrentRootMotion.HasOverrideVelocity() &&
+        FVector::DotProduct(UpdatedComponent->GetForwardVector(), -CurrentClimbableSurfaceNormal) > 0.999f;
+
+    if(!bHangingStill)
+    {
+        HangStillTime = 0.f;
+        return;
+    }
+
+    HangStillTime += DeltaTime;
+    if(HangStillTime >= HangSleepDelay)
+    {
+        EnterHangSleep();
+    }
+}
+
+// Returns true once input arrives, any anchoring primitive moves or the revalidation timeout is hit
+bool UCustomMovementComponent::ShouldWakeFromHangSleep(float DeltaTime)
+{
+    if(!Acceleration.IsNearlyZero()) return true;
+    if(HasAnimRootMotion() || CurrentRootMotion.HasOverrideVelocity()) return true;
+
+    for(const FHangSleepAnchor& Anchor : HangSleepAnchors)
+    {
+        const UPrimitiveComponent* SurfaceComponent = Anchor.Component.Get();
+        if(!SurfaceComponent) return true;
+        if(!SurfaceComponent->GetComponentTransform().Equals(Anchor.Transform)) return true;
+    }
+
+    HangSleepElapsed += DeltaTime;
+    return HangSleepElapsed >= HangSleepRevalidateInterval;
+}
+
+void UCustomMovementComponent::EnterHangSleep()
+{
+    // Anchor to every primitive the averaged surface info came from, it stays as it is while they do
+    HangSleepAnchors.Reset();
+    for(const FHitResult& SurfaceHit : ClimbableSurfacesTracedResults)
+    {
+        UPrimitiveComponent* SurfaceComponent = SurfaceHit.GetComponent();
+        if(!SurfaceComponent) continue;
+
+        if(!HangSleepAnchors.ContainsByPredicate([SurfaceComponent](const FHangSleepAnchor& Anchor) { return Anchor.Component == SurfaceComponent; }))
+        {
+            HangSleepAnchors.Add({SurfaceComponent, SurfaceComponent->GetComponentTransform()});
+        }
+    }
+    if(HangSleepAnchors.IsEmpty()) return;
+
+    HangSleepElapsed = 0.f;
+    bHangSleeping = true;
+}
+
+void UCustomMovementComponent::WakeFromHangSleep()
+{
+    bHangSleeping = false;
+    HangStillTime = 0.f;
+    HangSleepElapsed = 0.f;
+    HangSleepAnchors.Reset();
+}
+
 bool UCustomMovementComponent::IsClimbing() const
 {   
     return MovementMode == MOVE_Custom && CustomMovementMode == ECustomMovementMode::MOVE_Climb;
 }
 
+void UCustomMovementComponent::SetUseAsyncClimbProbes(bool bEnable)
+{
+    if(bUseAsyncClimbProbes == bEnable) return;
+
+    bUseAsyncClimbProbes = bEnable;
+    ResetAsyncClimbProbes();
+}
+
 
 // trace for climable surfaces, reteun true if there are indeed vali surfaces otherwise false
 bool UCustomMovementComponent::TraceClimableSurfaces()
 {   
-    const FVector StartOffset = UpdatedComponent->GetForwardVector() * 30.f;
-    const FVector Start = UpdatedComponent->GetComponentLocation() + StartOffset;
-    const FVector End = Start + UpdatedComponent->GetForwardVector();
+    CLIMB_SCOPE_CYCLE_COUNTER(STAT_TraceClimableSurfaces);
 
-    ClimbableSurfacesTracedResults = DoCapsuleTraceMultiByObject(Start, End);
+    const FClimbProfileConstants& Constants = GetClimbProfile()->GetConstants();
+    const FVector ComponentLocation = UpdatedComponent->GetComponentLocation();
+    const FQuat ComponentQuat = UpdatedComponent->GetComponentQuat();
+    const FVector Start = ComponentLocation + ComponentQuat.RotateVector(Constants.SurfaceSweepStart);
+    const FVector End = ComponentLocation + ComponentQuat.RotateVector(Constants.SurfaceSweepEnd);
+
+    DoCapsuleTraceMultiByObject(Start, End, ClimbableSurfacesTracedResults);
+    ApplyClimbSurfaceRules();
     
     return !ClimbableSurfacesTracedResults.IsEmpty();
 }
 
+// Floor probe under the capsule
+void UCustomMovementComponent::TraceClimbFloor()
+{
+    // Start and end below the capsule, baked into component space by the profile
+    const FClimbProfileConstants& Constants = GetClimbProfile()->GetConstants();
+    const FVector ComponentLocation = UpdatedComponent->GetComponentLocation();
+    const FQuat ComponentQuat = UpdatedComponent->GetComponentQuat();
+    const FVector Start = ComponentLocation + ComponentQuat.RotateVector(Constants.FloorSweepStart);
+    const FVector End = ComponentLocation + ComponentQuat.RotateVector(Constants.FloorSweepEnd);
+
+    // Perform a capsule trace to detect the floor hits
+    DoCapsuleTraceMultiByObject(Start, End, FloorTracedResults);
+}
+
+// Look ahead for the ledge when the tracked one no longer applies, one trace down onto the top of the wall
+void UCustomMovementComponent::UpdateLedgeTrack()
+{
+    if(ClimbableSurfacesTracedResults.IsEmpty())
+    {
+        LedgeTrack = FClimbLedgeTrack();
+        return;
+    }
+
+    const UClimbProfile* Profile = GetClimbProfile();
+    const FClimbProfileConstants& Constants = Profile->GetConstants();
+    const FHitResult& SurfaceHit = ClimbableSurfacesTracedResults[0];
+    const FQuat ComponentQuat = UpdatedComponent->GetComponentQuat();
+    const FVector UpVector = ComponentQuat.GetUpVector();
+    const FVector EyeLocation = UpdatedComponent->GetComponentLocation() + UpVector * CharacterOwner->BaseEyeHeight;
+
+    if(!NeedsLedgeLookahead(SurfaceHit, EyeLocation)) return;
+
+    // Cover as much height as we climb in the lookahead time, a start inside a taller wall finds nothing
+    const float LookaheadHeight = FMath::Max(GetUnrotatedClimbVelocity().Z * Profile->LedgeLookaheadTime, Profile->LedgeLookaheadMinHeight);
+    const FVector Start = EyeLocation + ComponentQuat.RotateVector(Constants.LedgeLookaheadStart) + UpVector * LookaheadHeight;
+    const FVector End = EyeLocation + ComponentQuat.RotateVector(Constants.LedgeLookaheadEnd);
+    const FHitResult TopHit = DoLineTraceSingleByObject(Start, End);
+
+    LedgeTrack.SurfaceComponent = SurfaceHit.GetComponent();
+    LedgeTrack.SurfaceNormal = SurfaceHit.ImpactNormal;
+    LedgeTrack.ProbeLocation = UpdatedComponent->GetComponentLocation();
+    LedgeTrack.RefreshLocation = EyeLocation + UpVector * (LookaheadHeight * 0.5f);
+    LedgeTrack.LedgePoint = TopHit.ImpactPoint;
+    LedgeTrack.bHasLedge = TopHit.bBlockingHit && !TopHit.bStartPenetrating && ClimbMath::IsLedgeTop(TopHit.ImpactNormal);
+    LedgeTrack.bValid = true;
+}
+
+bool UCustomMovementComponent::NeedsLedgeLookahead(const FHitResult& SurfaceHit, const FVector& EyeLocation) const
+{
+    if(!LedgeTrack.bValid) return true;
+
+    // Another surface, or the same one turning away, can have its top anywhere
+    const FClimbProfileConstants& Constants = GetClimbProfile()->GetConstants();
+    if(SurfaceHit.GetComponent() != LedgeTrack.SurfaceComponent.Get()) return true;
+    if(FVector::DotProduct(SurfaceHit.ImpactNormal, LedgeTrack.SurfaceNormal) < Constants.LedgeTrackSurfaceDot) return true;
+
+    // Along the wall the top can change height
+    const FVector Moved = UpdatedComponent->GetComponentLocation() - LedgeTrack.ProbeLocation;
+    if(FMath::Abs(FVector::DotProduct(Moved, UpdatedComponent->GetRightVector())) > GetClimbProfile()->LedgeTrackRefreshDistance) return true;
+
+    // Climbed halfway up a lookahead that found nothing
+    return !LedgeTrack.bHasLedge && FVector::DotProduct(EyeLocation - LedgeTrack.RefreshLocation, UpdatedComponent->GetUpVector()) > 0.f;
+}
+
+// Everything one climb tick looks at, read back from last frame's async probes when those are available
+void UCustomMovementComponent::RunClimbProbes()
+{
+    CLIMB_SCOPE_CYCLE_COUNTER(STAT_RunClimbProbes);
+
+    // In async mode read back last frame's probes and queue next frame's, falling back to sync traces until results exist.
+    // Lower LOD tiers do not probe on consecutive frames, so they have nothing to read back
+    const bool bUseAsyncProbes = bUseAsyncClimbProbes && ClimbLODTier == EClimbLODTier::Full;
+    bHasAsyncProbeResults = bUseAsyncProbes && ConsumeAsyncClimbProbes();
+    LastClimbProbeFrame = GFrameCounter;
+    if(bUseAsyncProbes)
+    {
+        SubmitAsyncClimbProbes();
+    }
+    if(!bHasAsyncProbeResults)
+    {
+        TraceClimableSurfaces();
+        TraceClimbFloor();
+    }
+
+    // The baked graph answers the ledge check for static geometry and the mesh's own ledge edges for anything else that has them
+    bLedgeAnsweredByBakedData = QueryLedgeGraphForLedge(bBakedLedgeReached) || QueryMeshLedgeEdgesForLedge(bBakedLedgeReached);
+    if(!bLedgeAnsweredByBakedData)
+    {
+        UpdateLedgeTrack();
+    }
+
+#if CLIMB_DIAGNOSTICS
+    for(const FHitResult& SurfaceHit : ClimbableSurfacesTracedResults)
+    {
+        CLIMB_VLOG_LOCATION(CharacterOwner, SurfaceHit.ImpactPoint, 5.f, FColor::Green, TEXT("Surface hit"));
+    }
+    for(const FHitResult& FloorHit : FloorTracedResults)
+    {
+        CLIMB_VLOG_LOCATION(CharacterOwner, FloorHit.ImpactPoint, 5.f, FColor::Blue, TEXT("Floor hit"));
+    }
+    if(bLedgeAnsweredByBakedData)
+    {
+        CLIMB_VLOG(CharacterOwner, TEXT("Ledge from baked data: %s"), bBakedLedgeReached ? TEXT("reached") : TEXT("not reached"));
+    }
+    else if(LedgeTrack.bHasLedge)
+    {
+        CLIMB_VLOG_LOCATION(CharacterOwner, LedgeTrack.LedgePoint, 10.f, FColor::Yellow, TEXT("Tracked ledge"));
+    }
+#endif
+}
+
+bool UCustomMovementComponent::GatherClimbSolveInput(FClimbSolveBatch& Batch, float DeltaTime)
+{
+    // Sleeping climbers skip probing and simulated proxies never run PhysClimb
+    if(!IsClimbing() || bHangSleeping || !UpdatedComponent || !ShouldProbeThisFrame()) return false;
+    if(CharacterOwner->GetLocalRole() == ROLE_SimulatedProxy) return false;
+
+    // A remote client's moves run on the server from its RPCs with their own delta times, never in the tick the batch is solved for
+    if(CharacterOwner->HasAuthority() && !CharacterOwner->IsLocallyControlled() && CharacterOwner->GetRemoteRole() == ROLE_AutonomousProxy) return false;
+
+    RunClimbProbes();
+
+    FClimbSolveInput& Input = Batch.Inputs.AddDefaulted_GetRef();
+    Input.Location = UpdatedComponent->GetComponentLocation();
+    Input.Rotation = UpdatedComponent->GetComponentQuat();
+    Input.UnrotatedVelocity = GetUnrotatedClimbVelocity();
+    Input.DeltaTime = DeltaTime;
+    Input.Profile = &GetClimbProfile()->GetConstants();
+
+    Input.ContactStart = Batch.ContactPoints.Num();
+    Input.ContactNum = ClimbableSurfacesTracedResults.Num();
+    for(int32 Index = 0; Index < ClimbableSurfacesTracedResults.Num(); ++Index)
+    {
+        Batch.ContactPoints.Add(ClimbableSurfacesTracedResults[Index].ImpactPoint);
+        Batch.ContactNormals.Add(ClimbableSurfacesTracedResults[Index].ImpactNormal);
+        Batch.ContactGrips.Add(ClimbableSurfaceGrips.IsEmpty() ? 1.f : ClimbableSurfaceGrips[Index]);
+    }
+
+    Input.FloorStart = Batch.FloorNormals.Num();
+    Input.FloorNum = FloorTracedResults.Num();
+    for(const FHitResult& FloorHit : FloorTracedResults)
+    {
+        Batch.FloorNormals.Add(FloorHit.ImpactNormal);
+    }
+
+    Input.bLedgeReached = CheckHasReachedLedge();
+
+    return true;
+}
+
+void UCustomMovementComponent::SetClimbSolveOutput(const FClimbSolveOutput& Output)
+{
+    ClimbSolve = Output;
+}
+
+EClimbSubState UCustomMovementComponent::EvaluateClimbSubState() const
+{
+    const UAnimMontage* ActiveMontage = OwningPlayerAnimInstance ? OwningPlayerAnimInstance->GetCurrentActiveMontage() : nullptr;
+    if(ActiveMontage)
+    {
+        if(ActiveMontage == HopUpMontage.Get() || ActiveMontage == HopDownMontage.Get()) return EClimbSubState::Hopping;
+
+        if(ActiveMontage == IdleToClimbMontage.Get() || ActiveMontage == ClimbToTopMontage.Get() ||
+           ActiveMontage == ClimbDownLedgeMontage.Get() || ActiveMontage == VaultMontage.Get() ||
+           ActiveMontage == StepOverMontage.Get() || ActiveMontage == MantleMontage.Get())
+        {
+            return EClimbSubState::Transitioning;
+        }
+    }
+
+    if(!IsClimbing()) return EClimbSubState::None;
+
+    return bHangSleeping ? EClimbSubState::Hanging : EClimbSubState::Climbing;
+}
+
+FClimbReplicatedState UCustomMovementComponent::BuildReplicatedClimbState() const
+{
+    FClimbReplicatedState State;
+    State.SubState = ClimbSubState;
+
+    if(IsClimbing())
+    {
+        State.SetSurfaceNormal(CurrentClimbableSurfaceNormal);
+        State.SetUnrotatedClimbVelocity(GetUnrotatedClimbVelocity());
+    }
+
+    return State;
+}
+
+void UCustomMovementComponent::ApplyReplicatedClimbState(const FClimbReplicatedState& State)
+{
+    ClimbSubState = State.SubState;
+    ProxyTargetSurfaceNormal = State.GetSurfaceNormal();
+    ProxyTargetClimbVelocity = State.GetUnrotatedClimbVelocity();
+
+    // Only climbers send a normal, a zero one means the climb is over even if the movement mode has not replicated yet
+    if(ProxyTargetSurfaceNormal.IsZero())
+    {
+        CurrentClimbableSurfaceNormal = FVector::ZeroVector;
+    }
+}
+
+// Ease toward the last replicated state, proxies never trace
+void UCustomMovementComponent::SmoothReplicatedClimbState(float DeltaTime)
+{
+    const float Alpha = FMath::Clamp(DeltaTime * ProxyClimbSmoothingSpeed, 0.f, 1.f);
+
+    if(!ProxyTargetSurfaceNormal.IsZero())
+    {
+        // Snap on the first state of a climb, blend afterwards
+        CurrentClimbableSurfaceNormal = CurrentClimbableSurfaceNormal.IsZero()
+            ? ProxyTargetSurfaceNormal
+            : FMath::Lerp(CurrentClimbableSurfaceNormal, ProxyTargetSurfaceNormal, Alpha).GetSafeNormal();
+    }
+
+    ProxyUnrotatedClimbVelocity = FMath::Lerp(ProxyUnrotatedClimbVelocity, ProxyTargetClimbVelocity, Alpha);
+}
+
+void UCustomMovementComponent::RegisterClimbSignificance()
+{
+    if(!bEnableClimbLOD || bRegisteredClimbSignificance) return;
+
+    USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld());
+    if(!SignificanceManager) return;
+
+    // Lower tiers are more significant and the manager keeps the most significant viewpoint
+    auto SignificanceFunction = [this](USignificanceManager::FManagedObjectInfo* ObjectInfo, const FTransform& Viewpoint) -> float
+    {
+        return static_cast<float>(EClimbLODTier::Frozen) - static_cast<float>(CalculateClimbLODTier(Viewpoint));
+    };
+
+    auto PostSignificanceFunction = [this](USignificanceManager::FManagedObjectInfo* ObjectInfo, float OldSignificance, float Significance, bool bFinal)
+    {
+        const int32 Tier = static_cast<int32>(EClimbLODTier::Frozen) - FMath::RoundToInt(Significance);
+        ClimbLODTier = static_cast<EClimbLODTier>(FMath::Clamp(Tier, 0, static_cast<int32>(EClimbLODTier::Frozen)));
+    };
+
+    SignificanceManager->RegisterObject(this, ClimbSignificanceTag, SignificanceFunction, USignificanceManager::EPostSignificanceType::Sequential, PostSignificanceFunction);
+    bRegisteredClimbSignificance = true;
+}
+
+void UCustomMovementComponent::UnregisterClimbSignificance()
+{
+    if(!bRegisteredClimbSignificance) return;
+
+    if(USignificanceManager* SignificanceManager = USignificanceManager::Get(GetWorld()))
+    {
+        SignificanceManager->UnregisterObject(this);
+    }
+    bRegisteredClimbSignificance = false;
+    ClimbLODTier = EClimbLODTier::Full;
+}
+
+// Runs inside the significance manager's update, possibly off the game thread, so only reads state
+EClimbLODTier UCustomMovementComponent::CalculateClimbLODTier(const FTransform& Viewpoint) const
+{
+    // Player climbers are predicted and corrected, they always climb at full rate
+    if(!CharacterOwner || CharacterOwner->IsPlayerControlled()) return EClimbLODTier::Full;
+
+    // Only a standalone game sees everything it simulates, a listen server's render says nothing about what its clients see
+    const float FreezeTime = ClimbLODSettings.FreezeAfterNotRenderedTime;
+    if(FreezeTime > 0.f && GetNetMode() == NM_Standalone && !CharacterOwner->WasRecentlyRendered(FreezeTime))
+    {
+        return EClimbLODTier::Frozen;
+    }
+
+    const double DistanceSquared = FVector::DistSquared(Viewpoint.GetLocation(), CharacterOwner->GetActorLocation());
+    if(DistanceSquared <= FMath::Square(ClimbLODSettings.ReducedDistance)) return EClimbLODTier::Full;
+    if(DistanceSquared <= FMath::Square(ClimbLODSettings.SurfaceLockedDistance)) return EClimbLODTier::Reduced;
+    return EClimbLODTier::SurfaceLocked;
+}
+
+bool UCustomMovementComponent::ShouldProbeThisFrame() const
+{
+    // Always probe once right after entering the climb
+    if(LastClimbProbeFrame == 0) return ClimbLODTier != EClimbLODTier::Frozen;
+
+    switch(ClimbLODTier)
+    {
+    case EClimbLODTier::Reduced:
+        return (GFrameCounter + ClimbLODFrameOffset) % FMath::Max(ClimbLODSettings.ReducedProbeInterval, 1) == 0;
+    case EClimbLODTier::SurfaceLocked:
+        return (GFrameCounter + ClimbLODFrameOffset) % FMath::Max(ClimbLODSettings.SurfaceLockedProbeInterval, 1) == 0;
+    case EClimbLODTier::Frozen:
+        return false;
+    default:
+        return true;
+    }
+}
+
 FHitResult UCustomMovementComponent::TraceFromEyeHeight(float TraceDistance, float TraceStartOffset,bool bShowDebugShape, bool bDrawPresistantShapes)
 {
     const FVector ComponentLocation = UpdatedComponent->GetComponentLocation();
@@ -573,38 +1635,252 @@ FHitResult UCustomMovementComponent::TraceFromEyeHeight(float TraceDistance, flo
     return DoLineTraceSingleByObject(Start,End,bShowDebugShape,bDrawPresistantShapes);
 }
 
-void UCustomMovementComponent::PlayClimbMontage(UAnimMontage *MontageToPlay)
+void UCustomMovementComponent::PlayClimbMontage(const TSoftObjectPtr<UAnimMontage>& MontageToPlay)
 {
-    if(!MontageToPlay) return;
+    if(MontageToPlay.IsNull()) return;
     if(!OwningPlayerAnimInstance) return;
     if(OwningPlayerAnimInstance->IsAnyMontagePlaying()) return;
 
-    OwningPlayerAnimInstance->Montage_Play(MontageToPlay);
+    // Preloading should have it in memory by now, a teleport straight onto a wall can still beat it
+    UAnimMontage* Montage = MontageToPlay.Get();
+    if(!Montage)
+    {
+        CLIMB_LOG(Warning, TEXT("%s was not preloaded, loading it now"), *MontageToPlay.ToString());
+        Montage = MontageToPlay.LoadSynchronous();
+        if(!Montage) return;
+    }
+
+    OwningPlayerAnimInstance->Montage_Play(Montage);
+    CLIMB_VLOG(CharacterOwner, TEXT("Montage %s"), *Montage->GetName());
 
 }
 
 void UCustomMovementComponent::OnClimbMontageEnded(UAnimMontage *Montage, bool bInterrupted)
 {
-    if(Montage == IdleToClimbMontage || Montage == ClimbDownLedgeMontage)
+    if(Montage == IdleToClimbMontage.Get() || Montage == ClimbDownLedgeMontage.Get())
     {
         StartClimbing();
         StopMovementImmediately();
     }
-    if(Montage == ClimbToTopMontage || Montage == VaultMontage)
+    if(Montage == ClimbToTopMontage.Get() || Montage == VaultMontage.Get() || Montage == StepOverMontage.Get() || Montage == MantleMontage.Get())
     {
         SetMovementMode(MOVE_Walking);
     }
 }
 
+// The mesh ticks after us, so the anim instance updates from this tick's movement without calling back into it.
+// Root motion updates it earlier, inside the move, see PerformMovement
+void UCustomMovementComponent::UpdateClimbAnimProxy()
+{
+    if(!CharacterAnimInstance) return;
+
+    FClimbAnimProxy Proxy;
+    Proxy.Velocity = Velocity;
+    Proxy.Acceleration = GetCurrentAcceleration();
+    Proxy.UnrotatedClimbVelocity = GetUnrotatedClimbVelocity();
+    Proxy.bIsFalling = IsFalling();
+    Proxy.bIsClimbing = IsClimbing();
+    Proxy.LimbTargets = LimbTargets;
+    CharacterAnimInstance->SetClimbAnimProxy(Proxy);
+}
+
+// Hands and feet go straight onto a flat patch for free, only an uneven one costs a batch of traces
+void UCustomMovementComponent::UpdateClimbLimbs()
+{
+    if(!bEnableClimbLimbIK || !IsClimbing())
+    {
+        LimbTargets.bValid = false;
+        LimbTraceFrame = 0;
+        return;
+    }
+
+    ConsumeLimbTraces();
+
+    // Planted limbs stay where they are while asleep or too far away to see them
+    if(bHangSleeping || ClimbLODTier == EClimbLODTier::SurfaceLocked || ClimbLODTier == EClimbLODTier::Frozen) return;
+    if(LimbTraceFrame != 0) return;
+
+    const UClimbProfile* Profile = GetClimbProfile();
+    const FClimbProfileConstants& Constants = Profile->GetConstants();
+    if(LimbTargets.bValid && (GFrameCounter + ClimbLODFrameOffset) % FMath::Max(Profile->LimbRefreshInterval, 1) != 0) return;
+
+    const FVector ComponentLocation = UpdatedComponent->GetComponentLocation();
+    const FQuat ComponentQuat = UpdatedComponent->GetComponentQuat();
+    FVector RestPoints[static_cast<int32>(EClimbLimb::Num)];
+    for(int32 Index = 0; Index < static_cast<int32>(EClimbLimb::Num); ++Index)
+    {
+        RestPoints[Index] = ComponentLocation + ComponentQuat.RotateVector(Constants.LimbRestOffsets[Index]);
+    }
+
+    // Proxies never trace, lay the limbs on the replicated surface normal a capsule radius ahead
+    if(ClimbableSurfacesTracedResults.IsEmpty())
+    {
+        if(CurrentClimbableSurfaceNormal.IsZero()) return;
+
+        const FVector SurfacePoint = ComponentLocation - CurrentClimbableSurfaceNormal * CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleRadius();
+        ClimbMath::PlaceLimbsOnPatch(RestPoints, FPlane(SurfacePoint, CurrentClimbableSurfaceNormal), LimbTargets);
+        return;
+    }
+
+    FPlane Patch;
+    const bool bFlatPatch = ClimbMath::FitSurfacePatch(ClimbableSurfacesTracedResults, Constants.LimbPatchNormalDot, Profile->LimbPatchMaxOffset, Patch);
+
+    // Only back faces in the sweep, nothing to place the limbs on
+    if(Patch.GetNormal().IsZero()) return;
+
+    // On an uneven patch the mean plane holds the limbs until their traces come back
+    if(bFlatPatch || !LimbTargets.bValid)
+    {
+        ClimbMath::PlaceLimbsOnPatch(RestPoints, Patch, LimbTargets);
+    }
+    if(bFlatPatch) return;
+
+    UWorld* World = GetWorld();
+    if(!World) return;
+
+    const FVector IntoSurface = -Patch.GetNormal() * Profile->LimbTraceDepth;
+    for(int32 Index = 0; Index < static_cast<int32>(EClimbLimb::Num); ++Index)
+    {
+        LimbTraceHandles[Index] = SubmitAsyncClimbLineTrace(World, RestPoints[Index], RestPoints[Index] + IntoSurface);
+    }
+    LimbTraceFrame = GFrameCounter;
+    RecordClimbTraces(static_cast<int32>(EClimbLimb::Num), 0);
+}
+
+// Limbs whose trace found nothing keep the mean plane placement
+void UCustomMovementComponent::ConsumeLimbTraces()
+{
+    if(LimbTraceFrame == 0 || LimbTraceFrame == GFrameCounter) return;
+    LimbTraceFrame = 0;
+
+    UWorld* World = GetWorld();
+    if(!World) return;
+
+    int32 NumHits = 0;
+    for(int32 Index = 0; Index < static_cast<int32>(EClimbLimb::Num); ++Index)
+    {
+        if(!World->QueryTraceData(LimbTraceHandles[Index], LimbTraceDatum) || LimbTraceDatum.OutHits.IsEmpty()) continue;
+
+        const FHitResult& Hit = LimbTraceDatum.OutHits[0];
+        LimbTargets.Locations[Index] = Hit.ImpactPoint;
+        LimbTargets.Normals[Index] = Hit.ImpactNormal;
+        ++NumHits;
+    }
+    RecordClimbTraces(0, NumHits);
+}
+
+// Montage transitions are motion warped and must never skip a frame, still hangers can be throttled hard
+void UCustomMovementComponent::UpdateAnimBudgetSignificance()
+{
+    USkeletalMeshComponentBudgeted* BudgetedMesh = Cast<USkeletalMeshComponentBudgeted>(CharacterOwner->GetMesh());
+    if(!BudgetedMesh || BudgetedMesh->GetAutoCalculateSignificance()) return;
+
+    IAnimationBudgetAllocator* BudgetAllocator = IAnimationBudgetAllocator::Get(GetWorld());
+    if(!BudgetAllocator) return;
+
+    const bool bInTransition = ClimbSubState == EClimbSubState::Hopping || ClimbSubState == EClimbSubState::Transitioning;
+
+    // Same tiers the climb itself runs at, Full is the most significant
+    const float MaxTier = static_cast<float>(EClimbLODTier::Frozen);
+    float Significance = (MaxTier - static_cast<float>(ClimbLODTier)) / MaxTier;
+    if(bInTransition)
+    {
+        Significance = 1.f;
+    }
+    // The player's own climber is on screen the whole time it hangs. AI controllers are local too in standalone, so check for a player
+    else if(!(CharacterOwner->IsLocallyControlled() && CharacterOwner->IsPlayerControlled()) &&
+        (ClimbSubState == EClimbSubState::Hanging || (ClimbSubState == EClimbSubState::Climbing && GetUnrotatedClimbVelocity().IsNearlyZero())))
+    {
+        Significance *= ClimbLODSettings.HangingAnimSignificanceScale;
+    }
+
+    if(Significance == AnimBudgetSignificance && bInTransition == bAnimBudgetNeverSkip) return;
+
+    AnimBudgetSignificance = Significance;
+    bAnimBudgetNeverSkip = bInTransition;
+    BudgetAllocator->SetComponentSignificance(BudgetedMesh, Significance, bInTransition, bInTransition);
+}
+
+// Keep the climb montages in memory only while there is something to climb nearby
+void UCustomMovementComponent::UpdateClimbMontageStreaming(float DeltaTime)
+{
+    ClimbMontageProximityCheckTime -= DeltaTime;
+    if(ClimbMontageProximityCheckTime > 0.f) return;
+
+    const float ElapsedTime = ClimbMontageProximityCheckInterval - ClimbMontageProximityCheckTime;
+    ClimbMontageProximityCheckTime = ClimbMontageProximityCheckInterval;
+
+    // Never let go mid climb or mid montage, the cooldown only runs once we are clear of both
+    const bool bInUse = IsClimbing() || (OwningPlayerAnimInstance && OwningPlayerAnimInstance->IsAnyMontagePlaying());
+
+    // Only the characters that start climbs look ahead, proxies load once they are shown one
+    const bool bStartsClimbs = CharacterOwner->IsLocallyControlled() || CharacterOwner->HasAuthority();
+    if(bInUse || (bStartsClimbs && IsNearClimbableGeometry()))
+    {
+        ClimbMontageReleaseTime = ClimbMontageReleaseDelay;
+        RequestClimbMontages();
+        return;
+    }
+
+    if(!ClimbMontageHandle.IsValid()) return;
+
+    ClimbMontageReleaseTime -= ElapsedTime;
+    if(ClimbMontageReleaseTime <= 0.f)
+    {
+        ReleaseClimbMontages();
+    }
+}
+
+bool UCustomMovementComponent::IsNearClimbableGeometry() const
+{
+    const UWorld* World = GetWorld();
+    if(!World) return false;
+
+    // The Climbable channel only, the floor under every character is of the climb object types too and would keep them all loaded
+    const FVector Location = UpdatedComponent->GetComponentLocation();
+    return World->OverlapAnyTestByChannel(Location, FQuat::Identity, ECC_Climbable, FCollisionShape::MakeSphere(ClimbMontagePreloadDistance), ClimbQueryParams);
+}
+
+void UCustomMovementComponent::RequestClimbMontages()
+{
+    if(ClimbMontageHandle.IsValid()) return;
+
+    TArray<FSoftObjectPath> MontagePaths;
+    for(const TSoftObjectPtr<UAnimMontage>* Montage : {&IdleToClimbMontage, &ClimbToTopMontage, &ClimbDownLedgeMontage, &VaultMontage,
+        &StepOverMontage, &MantleMontage, &HopUpMontage, &HopDownMontage})
+    {
+        if(!Montage->IsNull())
+        {
+            MontagePaths.Add(Montage->ToSoftObjectPath());
+        }
+    }
+    if(MontagePaths.IsEmpty()) return;
+
+    // Characters of the same class share the loaded montages, the last handle released unloads them
+    ClimbMontageHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(MontagePaths), FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority);
+    CLIMB_LOG(Verbose, TEXT("%s requested climb montages"), *GetNameSafe(CharacterOwner));
+}
+
+void UCustomMovementComponent::ReleaseClimbMontages()
+{
+    if(!ClimbMontageHandle.IsValid()) return;
+
+    ClimbMontageHandle->ReleaseHandle();
+    ClimbMontageHandle.Reset();
+    CLIMB_LOG(Verbose, TEXT("%s released climb montages"), *GetNameSafe(CharacterOwner));
+}
+
 void UCustomMovementComponent::RequestHopping()
 {
+    WakeFromHangSleep();
+
+    // Acceleration travels with the saved move, the last input vector only exists on the owning client
     const FVector UnrotatedLastInputVector = 
-    UKismetMathLibrary::Quat_UnrotateVector(UpdatedComponent->GetComponentQuat(),GetLastInputVector());
+    UKismetMathLibrary::Quat_UnrotateVector(UpdatedComponent->GetComponentQuat(),Acceleration);
 
     const float DotResult =
     FVector::DotProduct(UnrotatedLastInputVector.GetSafeNormal(),FVector::UpVector);
 
-    Debug::Print(TEXT("Dot Result: ")+ FString::SanitizeFloat(DotResult));
     
     if(DotResult >= 0.9f)
     {
@@ -616,7 +1892,7 @@ void UCustomMovementComponent::RequestHopping()
     }
     else
     {
-        Debug::Print(TEXT("Invalid Input Range"));
+        CLIMB_LOG(Log, TEXT("%s hop ignored, input %.2f is neither up nor down"), *GetNameSafe(CharacterOwner), DotResult);
     }
 }
 
@@ -635,7 +1911,7 @@ void UCustomMovementComponent::HandleHopUp()
     FVector HopUpTargetPoint;
     if(CheckCanHopUp(HopUpTargetPoint))
     {   
-        SetMotionWarpTarget(FName("HopUpTargetPoint"),HopUpTargetPoint);
+        SetMotionWarpTarget(HopUpWarpTarget,HopUpTargetPoint);
 
         PlayClimbMontage(HopUpMontage);
     }
@@ -646,7 +1922,7 @@ void UCustomMovementComponent::HandleHopDown()
     FVector HopDownTargetPoint;
     if(CheckCanHopDown(HopDownTargetPoint))
     {   
-        SetMotionWarpTarget(FName("HopDownTargetPoint"),HopDownTargetPoint);
+        SetMotionWarpTarget(HopDownWarpTarget,HopDownTargetPoint);
 
         PlayClimbMontage(HopDownMontage);
     }
@@ -654,8 +1930,23 @@ void UCustomMovementComponent::HandleHopDown()
 
 bool UCustomMovementComponent::CheckCanHopUp(FVector& OutHopUpTargetPosition)
 {
-    FHitResult HopHitResult = TraceFromEyeHeight(100.f,-20.f);
-    FHitResult SafeLedgeHit = TraceFromEyeHeight(100.f,150.f);
+    CLIMB_SCOPE_CYCLE_COUNTER(STAT_CheckCanHopUp);
+
+    const UClimbProfile* Profile = GetClimbProfile();
+
+    // On baked geometry the wall has to cover both the hop target and the safe ledge height, the graph not having it is no proof there is none
+    if(const UClimbLedgeGraph* LedgeGraph = GetLedgeGraphFor(GetClimbedSurfaceComponent()))
+    {
+        const FVector EyeLocation = UpdatedComponent->GetComponentLocation() + UpdatedComponent->GetUpVector() * CharacterOwner->BaseEyeHeight;
+        if(LedgeGraph->FindWall(EyeLocation, UpdatedComponent->GetForwardVector(), Profile->EyeTraceDistance,
+            EyeLocation.Z + Profile->HopUpTargetHeight, EyeLocation.Z + Profile->HopUpClearanceHeight, OutHopUpTargetPosition))
+        {
+            return true;
+        }
+    }
+
+    FHitResult HopHitResult = TraceFromEyeHeight(Profile->EyeTraceDistance, Profile->HopUpTargetHeight);
+    FHitResult SafeLedgeHit = TraceFromEyeHeight(Profile->EyeTraceDistance, Profile->HopUpClearanceHeight);
 
     if(HopHitResult.bBlockingHit && SafeLedgeHit.bBlockingHit)
     {
@@ -668,7 +1959,22 @@ bool UCustomMovementComponent::CheckCanHopUp(FVector& OutHopUpTargetPosition)
 
 bool UCustomMovementComponent::CheckCanHopDown(FVector& HopDownTargetPosition)
 {
-    FHitResult SafeLedgeHit = TraceFromEyeHeight(100.f,-300.f);
+    CLIMB_SCOPE_CYCLE_COUNTER(STAT_CheckCanHopDown);
+
+    const UClimbProfile* Profile = GetClimbProfile();
+
+    // Same as CheckCanHopUp, a miss in the graph falls through to the trace
+    if(const UClimbLedgeGraph* LedgeGraph = GetLedgeGraphFor(GetClimbedSurfaceComponent()))
+    {
+        const FVector EyeLocation = UpdatedComponent->GetComponentLocation() + UpdatedComponent->GetUpVector() * CharacterOwner->BaseEyeHeight;
+        if(LedgeGraph->FindWall(EyeLocation, UpdatedComponent->GetForwardVector(), Profile->EyeTraceDistance,
+            EyeLocation.Z + Profile->HopDownTargetHeight, EyeLocation.Z + Profile->HopDownTargetHeight, HopDownTargetPosition))
+        {
+            return true;
+        }
+    }
+
+    FHitResult SafeLedgeHit = TraceFromEyeHeight(Profile->EyeTraceDistance, Profile->HopDownTargetHeight);
     if(SafeLedgeHit.bBlockingHit)
     {
         HopDownTargetPosition = SafeLedgeHit.ImpactPoint;
@@ -679,9 +1985,86 @@ bool UCustomMovementComponent::CheckCanHopDown(FVector& HopDownTargetPosition)
 }
 FVector UCustomMovementComponent::GetUnrotatedClimbVelocity() const
 {
+    // Proxies only have the stock replicated velocity, the replicated climb velocity is the accurate one
+    if(CharacterOwner && CharacterOwner->GetLocalRole() == ROLE_SimulatedProxy)
+    {
+        return ProxyUnrotatedClimbVelocity;
+    }
+
     // Unrotate the velocity vector using the component's quaternion
     // This is done to get the velocity in the component's local space without rotation
     return UKismetMathLibrary::Quat_UnrotateVector(UpdatedComponent->GetComponentQuat(), Velocity);
 }
 
-#pragma endregion
\ No newline at end of file
+#pragma endregion
+
+#pragma region ClimbPrediction
+
+void FSavedMove_Climb::Clear()
+{
+    Super::Clear();
+
+    bSavedWantsToToggleClimb = false;
+    bSavedWantsToHop = false;
+}
+
+uint8 FSavedMove_Climb::GetCompressedFlags() const
+{
+    uint8 Result = Super::GetCompressedFlags();
+
+    if(bSavedWantsToToggleClimb)
+    {
+        Result |= FLAG_Custom_0;
+    }
+    if(bSavedWantsToHop)
+    {
+        Result |= FLAG_Custom_1;
+    }
+
+    return Result;
+}
+
+// Plain climbing moves combine as usual, only the one-off requests must reach the server as their own move
+bool FSavedMove_Climb::CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const
+{
+    const FSavedMove_Climb* NewClimbMove = static_cast<const FSavedMove_Climb*>(NewMove.Get());
+
+    if(bSavedWantsToToggleClimb || NewClimbMove->bSavedWantsToToggleClimb) return false;
+    if(bSavedWantsToHop || NewClimbMove->bSavedWantsToHop) return false;
+
+    return Super::CanCombineWith(NewMove, InCharacter, MaxDelta);
+}
+
+void FSavedMove_Climb::SetMoveFor(ACharacter* C, float InDeltaTime, FVector const& NewAccel, FNetworkPredictionData_Client_Character& ClientData)
+{
+    Super::SetMoveFor(C, InDeltaTime, NewAccel, ClientData);
+
+    if(const UCustomMovementComponent* MovementComponent = Cast<UCustomMovementComponent>(C->GetCharacterMovement()))
+    {
+        bSavedWantsToToggleClimb = MovementComponent->bWantsToToggleClimb;
+        bSavedWantsToHop = MovementComponent->bWantsToHop;
+    }
+}
+
+void FSavedMove_Climb::PrepMoveFor(ACharacter* C)
+{
+    Super::PrepMoveFor(C);
+
+    if(UCustomMovementComponent* MovementComponent = Cast<UCustomMovementComponent>(C->GetCharacterMovement()))
+    {
+        MovementComponent->bWantsToToggleClimb = bSavedWantsToToggleClimb;
+        MovementComponent->bWantsToHop = bSavedWantsToHop;
+    }
+}
+
+FNetworkPredictionData_Client_Climb::FNetworkPredictionData_Client_Climb(const UCharacterMovementComponent& ClientMovement)
+    : Super(ClientMovement)
+{
+}
+
+FSavedMovePtr FNetworkPredictionData_Client_Climb::AllocateNewMove()
+{
+    return FSavedMovePtr(new FSavedMove_Climb());
+}
+
+#pragma endregion
@@ -0,0 +1,156 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Data/ClimbLedgeEdgeUserData.h"
+#include "Climbing/ClimbMath.h"
+#include "Engine/StaticMesh.h"
+#include "PhysicsEngine/BodySetup.h"
+
+namespace ClimbLedgeEdge
+{
+    // Same split as the default walkable floor angle, anything between the two is neither top nor wall
+    static constexpr float WalkableNormalZ = 0.7f;
+    static constexpr float WallNormalZ = 0.3f;
+}
+
+bool UClimbLedgeEdgeUserData::FindLedge(const FTransform& MeshToWorld, const FVector& Location, const FVector& Forward, float MaxDistance, float MinZ, float MaxZ, FVector& OutLedgePoint) const
+{
+    // Normals go through the inverse transpose, which for a scale is its reciprocal
+    const FVector InverseScale = FTransform::GetSafeScaleReciprocal(MeshToWorld.GetScale3D());
+
+    bool bFoundLedge = false;
+    float BestDistance = MaxDistance;
+    for(const FClimbMeshLedgeEdge& Edge : Edges)
+    {
+        const FVector TopNormal = MeshToWorld.TransformVectorNoScale(FVector(Edge.TopNormal) * InverseScale).GetSafeNormal();
+        const FVector WallNormal = MeshToWorld.TransformVectorNoScale(FVector(Edge.WallNormal) * InverseScale).GetSafeNormal();
+
+        // A rotated instance may have turned the edge into something that is no ledge
+        if(TopNormal.Z < ClimbLedgeEdge::WalkableNormalZ || FMath::Abs(WallNormal.Z) > ClimbLedgeEdge::WallNormalZ) continue;
+
+        FVector LedgePoint;
+        float Distance;
+        if(!ClimbMath::FindEdgeAhead(Location, Forward, MeshToWorld.TransformPosition(FVector(Edge.Start)), MeshToWorld.TransformPosition(FVector(Edge.End)), WallNormal, BestDistance, LedgePoint, Distance)) continue;
+        if(LedgePoint.Z < MinZ || LedgePoint.Z > MaxZ) continue;
+
+        bFoundLedge = true;
+        BestDistance = Distance;
+        OutLedgePoint = LedgePoint;
+    }
+
+    return bFoundLedge;
+}
+
+#if WITH_EDITOR
+bool UClimbLedgeEdgeUserData::BuildFromStaticMesh(const UStaticMesh* StaticMesh)
+{
+    Edges.Reset();
+
+    const UBodySetup* BodySetup = StaticMesh ? StaticMesh->GetBodySetup() : nullptr;
+    if(!BodySetup) return false;
+
+    // Collects the convex edges of one hull where a walkable face meets a wall face
+    const auto AddHullEdges = [this](const TArray<FVector>& LocalVertices, const TArray<int32>& Indices, const FTransform& ElemTransform)
+    {
+        if(LocalVertices.IsEmpty() || Indices.Num() < 3) return;
+
+        TArray<FVector> Vertices;
+        Vertices.Reserve(LocalVertices.Num());
+        FVector HullCenter = FVector::ZeroVector;
+        for(const FVector& LocalVertex : LocalVertices)
+        {
+            HullCenter += Vertices.Add_GetRef(ElemTransform.TransformPosition(LocalVertex));
+        }
+        HullCenter /= Vertices.Num();
+
+        // Up to two face normals per edge, keyed by the sorted vertex pair
+        struct FEdgeFaces
+        {
+            FVector Normals[2];
+            int32 NumFaces = 0;
+        };
+        TMap<uint64, FEdgeFaces> EdgeFaces;
+
+        for(int32 Index = 0; Index + 2 < Indices.Num(); Index += 3)
+        {
+            const int32 Corners[3] = { Indices[Index], Indices[Index + 1], Indices[Index + 2] };
+            const FVector& A = Vertices[Corners[0]];
+            const FVector& B = Vertices[Corners[1]];
+            const FVector& C = Vertices[Corners[2]];
+
+            // Winding differs between sources, a hull face always points away from the hull center
+            FVector Normal = FVector::CrossProduct(B - A, C - A).GetSafeNormal();
+            if(FVector::DotProduct(Normal, (A + B + C) / 3.f - HullCenter) < 0.f)
+            {
+                Normal = -Normal;
+            }
+
+            for(int32 Corner = 0; Corner < 3; ++Corner)
+            {
+                const uint32 First = static_cast<uint32>(Corners[Corner]);
+                const uint32 Second = static_cast<uint32>(Corners[(Corner + 1) % 3]);
+                const uint64 Key = (static_cast<uint64>(FMath::Min(First, Second)) << 32) | FMath::Max(First, Second);
+
+                FEdgeFaces& Faces = EdgeFaces.FindOrAdd(Key);
+                if(Faces.NumFaces < 2)
+                {
+                    Faces.Normals[Faces.NumFaces] = Normal;
+                }
+                ++Faces.NumFaces;
+            }
+        }
+
+        for(const TPair<uint64, FEdgeFaces>& Pair : EdgeFaces)
+        {
+            if(Pair.Value.NumFaces != 2) continue;
+
+            const FVector* TopNormal = nullptr;
+            const FVector* WallNormal = nullptr;
+            for(const FVector& Normal : Pair.Value.Normals)
+            {
+                if(Normal.Z >= ClimbLedgeEdge::WalkableNormalZ) TopNormal = &Normal;
+                else if(FMath::Abs(Normal.Z) <= ClimbLedgeEdge::WallNormalZ) WallNormal = &Normal;
+            }
+            if(!TopNormal || !WallNormal) continue;
+
+            FClimbMeshLedgeEdge& Edge = Edges.AddDefaulted_GetRef();
+            Edge.Start = FVector3f(Vertices[static_cast<int32>(Pair.Key >> 32)]);
+            Edge.End = FVector3f(Vertices[static_cast<int32>(Pair.Key & 0xFFFFFFFF)]);
+            Edge.WallNormal = FVector3f(WallNormal->GetSafeNormal2D());
+            Edge.TopNormal = FVector3f(*TopNormal);
+        }
+    };
+
+    // Boxes become an eight corner hull
+    static const int32 BoxIndices[36] =
+    {
+        0, 1, 3,  0, 3, 2,
+        4, 6, 7,  4, 7, 5,
+        0, 4, 5,  0, 5, 1,
+        2, 3, 7,  2, 7, 6,
+        0, 2, 6,  0, 6, 4,
+        1, 5, 7,  1, 7, 3
+    };
+    const TArray<int32> BoxIndexArray(BoxIndices, UE_ARRAY_COUNT(BoxIndices));
+    for(const FKBoxElem& BoxElem : BodySetup->AggGeom.BoxElems)
+    {
+        TArray<FVector> Corners;
+        for(int32 Corner = 0; Corner < 8; ++Corner)
+        {
+            Corners.Add(FVector(
+                (Corner & 4) ? BoxElem.X * 0.5f : -BoxElem.X * 0.5f,
+                (Corner & 2) ? BoxElem.Y * 0.5f : -BoxElem.Y * 0.5f,
+                (Corner & 1) ? BoxElem.Z * 0.5f : -BoxElem.Z * 0.5f
+            ));
+        }
+        AddHullEdges(Corners, BoxIndexArray, BoxElem.GetTransform());
+    }
+
+    for(const FKConvexElem& ConvexElem : BodySetup->AggGeom.ConvexElems)
+    {
+        AddHullEdges(ConvexElem.VertexData, ConvexElem.IndexData, ConvexElem.GetTransform());
+    }
+
+    return !Edges.IsEmpty();
+}
+#endif
@@ -0,0 +1,184 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Data/ClimbLedgeGraph.h"
+#include "Climbing/ClimbMath.h"
+
+void UClimbLedgeGraph::BuildSpatialIndex(float InCellSize, float QueryReach)
+{
+    CellSize = FMath::Max(InCellSize, 1.f);
+
+    // XY footprint of every element, grown by how far a query can reach from its cell
+    TArray<FBox2f> ItemBounds;
+    TArray<uint32> Items;
+    const auto AddItem = [&](EItemKind Kind, int32 Index, const FVector3f& A, const FVector3f& B)
+    {
+        FBox2f Box(ForceInit);
+        Box += FVector2f(A.X, A.Y);
+        Box += FVector2f(B.X, B.Y);
+        ItemBounds.Add(Box.ExpandBy(QueryReach));
+        Items.Add(PackItem(Kind, Index));
+    };
+
+    for(int32 Index = 0; Index < Ledges.Num(); ++Index)
+    {
+        AddItem(EItemKind::Ledge, Index, Ledges[Index].Start, Ledges[Index].End);
+    }
+    for(int32 Index = 0; Index < WallPatches.Num(); ++Index)
+    {
+        const FClimbWallPatch& Patch = WallPatches[Index];
+        const FVector3f Along = FVector3f(-Patch.Normal.Y, Patch.Normal.X, 0.f) * Patch.HalfExtents.X;
+        AddItem(EItemKind::Wall, Index, Patch.Center - Along, Patch.Center + Along);
+    }
+    for(int32 Index = 0; Index < VaultSpans.Num(); ++Index)
+    {
+        AddItem(EItemKind::Vault, Index, VaultSpans[Index].Start, VaultSpans[Index].End);
+    }
+
+    CellOffsets.Reset();
+    CellItems.Reset();
+    if(Items.IsEmpty())
+    {
+        GridDims = FIntPoint::ZeroValue;
+        return;
+    }
+
+    FBox2f GridBounds(ForceInit);
+    for(const FBox2f& Box : ItemBounds)
+    {
+        GridBounds += Box;
+    }
+    GridOrigin = GridBounds.Min;
+    const FVector2f GridSize = GridBounds.GetSize();
+    GridDims = FIntPoint(
+        FMath::Max(1, FMath::CeilToInt(GridSize.X / CellSize)),
+        FMath::Max(1, FMath::CeilToInt(GridSize.Y / CellSize))
+    );
+
+    const auto ForEachCell = [this](const FBox2f& Box, TFunctionRef<void(int32)> Func)
+    {
+        const int32 MinX = FMath::Clamp(FMath::FloorToInt((Box.Min.X - GridOrigin.X) / CellSize), 0, GridDims.X - 1);
+        const int32 MinY = FMath::Clamp(FMath::FloorToInt((Box.Min.Y - GridOrigin.Y) / CellSize), 0, GridDims.Y - 1);
+        const int32 MaxX = FMath::Clamp(FMath::FloorToInt((Box.Max.X - GridOrigin.X) / CellSize), 0, GridDims.X - 1);
+        const int32 MaxY = FMath::Clamp(FMath::FloorToInt((Box.Max.Y - GridOrigin.Y) / CellSize), 0, GridDims.Y - 1);
+        for(int32 Y = MinY; Y <= MaxY; ++Y)
+        {
+            for(int32 X = MinX; X <= MaxX; ++X)
+            {
+                Func(Y * GridDims.X + X);
+            }
+        }
+    };
+
+    // Counting sort, first count the items per cell then turn the counts into offsets and scatter
+    const int32 NumCells = GridDims.X * GridDims.Y;
+    CellOffsets.SetNumZeroed(NumCells + 1);
+    for(const FBox2f& Box : ItemBounds)
+    {
+        ForEachCell(Box, [this](int32 Cell) { ++CellOffsets[Cell + 1]; });
+    }
+    for(int32 Cell = 0; Cell < NumCells; ++Cell)
+    {
+        CellOffsets[Cell + 1] += CellOffsets[Cell];
+    }
+
+    CellItems.SetNumUninitialized(CellOffsets[NumCells]);
+    TArray<int32> WriteCursor(CellOffsets.GetData(), NumCells);
+    for(int32 ItemIndex = 0; ItemIndex < Items.Num(); ++ItemIndex)
+    {
+        ForEachCell(ItemBounds[ItemIndex], [&](int32 Cell) { CellItems[WriteCursor[Cell]++] = Items[ItemIndex]; });
+    }
+}
+
+TArrayView<const uint32> UClimbLedgeGraph::GetCellItems(const FVector& Location) const
+{
+    if(CellOffsets.IsEmpty()) return TArrayView<const uint32>();
+
+    const int32 X = FMath::FloorToInt((Location.X - GridOrigin.X) / CellSize);
+    const int32 Y = FMath::FloorToInt((Location.Y - GridOrigin.Y) / CellSize);
+    if(X < 0 || Y < 0 || X >= GridDims.X || Y >= GridDims.Y) return TArrayView<const uint32>();
+
+    const int32 Cell = Y * GridDims.X + X;
+    return TArrayView<const uint32>(CellItems.GetData() + CellOffsets[Cell], CellOffsets[Cell + 1] - CellOffsets[Cell]);
+}
+
+const FClimbLedgeSegment* UClimbLedgeGraph::FindLedge(const FVector& Location, const FVector& Forward, float MaxDistance, float MinZ, float MaxZ, bool bFromWallSide, FVector& OutLedgePoint) const
+{
+    const FClimbLedgeSegment* BestLedge = nullptr;
+    float BestDistance = MaxDistance;
+
+    for(const uint32 Item : GetCellItems(Location))
+    {
+        if(UnpackKind(Item) != EItemKind::Ledge) continue;
+
+        const FClimbLedgeSegment& Ledge = Ledges[UnpackIndex(Item)];
+
+        // Coming from the top the character faces away from the wall
+        const FVector FacingNormal = bFromWallSide ? FVector(Ledge.WallNormal) : -FVector(Ledge.WallNormal);
+
+        FVector LedgePoint;
+        float Distance;
+        if(!ClimbMath::FindEdgeAhead(Location, Forward, FVector(Ledge.Start), FVector(Ledge.End), FacingNormal, BestDistance, LedgePoint, Distance)) continue;
+        if(LedgePoint.Z < MinZ || LedgePoint.Z > MaxZ) continue;
+
+        BestLedge = &Ledge;
+        BestDistance = Distance;
+        OutLedgePoint = LedgePoint;
+    }
+
+    return BestLedge;
+}
+
+const FClimbWallPatch* UClimbLedgeGraph::FindWall(const FVector& Location, const FVector& Forward, float MaxDistance, float MinZ, float MaxZ, FVector& OutWallPoint) const
+{
+    const FClimbWallPatch* BestPatch = nullptr;
+    float BestDistance = MaxDistance;
+
+    for(const uint32 Item : GetCellItems(Location))
+    {
+        if(UnpackKind(Item) != EItemKind::Wall) continue;
+
+        const FClimbWallPatch& Patch = WallPatches[UnpackIndex(Item)];
+
+        // Whole height range has to be on the patch
+        if(MinZ < Patch.Center.Z - Patch.HalfExtents.Y || MaxZ > Patch.Center.Z + Patch.HalfExtents.Y) continue;
+
+        // Bottom-to-top the patch is the same everywhere, so test it as the horizontal edge through its center
+        const FVector Center(Patch.Center);
+        const FVector Along = FVector(-Patch.Normal.Y, Patch.Normal.X, 0.f) * Patch.HalfExtents.X;
+
+        FVector WallPoint;
+        float Distance;
+        if(!ClimbMath::FindEdgeAhead(Location, Forward, Center - Along, Center + Along, FVector(Patch.Normal), BestDistance, WallPoint, Distance)) continue;
+
+        BestPatch = &Patch;
+        BestDistance = Distance;
+        OutWallPoint = FVector(WallPoint.X, WallPoint.Y, MinZ);
+    }
+
+    return BestPatch;
+}
+
+const FClimbVaultSpan* UClimbLedgeGraph::FindVault(const FVector& Location, const FVector& Forward, float MaxDistance, float MinZ, float MaxZ, FVector& OutTopPoint) const
+{
+    const FClimbVaultSpan* BestSpan = nullptr;
+    float BestDistance = MaxDistance;
+
+    for(const uint32 Item : GetCellItems(Location))
+    {
+        if(UnpackKind(Item) != EItemKind::Vault) continue;
+
+        const FClimbVaultSpan& Span = VaultSpans[UnpackIndex(Item)];
+
+        FVector TopPoint;
+        float Distance;
+        if(!ClimbMath::FindEdgeAhead(Location, Forward, FVector(Span.Start), FVector(Span.End), FVector(Span.Normal), BestDistance, TopPoint, Distance)) continue;
+        if(TopPoint.Z < MinZ || TopPoint.Z > MaxZ) continue;
+
+        BestSpan = &Span;
+        BestDistance = Distance;
+        OutTopPoint = TopPoint;
+    }
+
+    return BestSpan;
+}
@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Data/ClimbProfile.h"
+
+void UClimbProfile::PostInitProperties()
+{
+    Super::PostInitProperties();
+
+    BakeConstants();
+}
+
+void UClimbProfile::PostLoad()
+{
+    Super::PostLoad();
+
+    BakeConstants();
+}
+
+#if WITH_EDITOR
+void UClimbProfile::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+
+    BakeConstants();
+}
+#endif
+
+void UClimbProfile::BakeConstants()
+{
+    // Within MinClimbableSurfaceAngle of up is the same as a dot with up of at least its cosine
+    Constants.TooFlatSurfaceUpDot = FMath::Cos(FMath::DegreesToRadians(MinClimbableSurfaceAngle));
+
+    Constants.MinVerticalClimbSpeed = MinVerticalClimbSpeed;
+    Constants.RotationInterpSpeed = RotationInterpSpeed;
+
+    // Both sweeps only move one unit, they are overlap tests that still report impact points
+    Constants.SurfaceSweepStart = FVector(SurfaceTraceForwardOffset, 0.f, 0.f);
+    Constants.SurfaceSweepEnd = Constants.SurfaceSweepStart + FVector::ForwardVector;
+    Constants.FloorSweepStart = FVector(0.f, 0.f, -FloorTraceDownOffset);
+    Constants.FloorSweepEnd = Constants.FloorSweepStart - FVector::UpVector;
+
+    // The lookahead comes down onto the top from above the reach height, to as far below it as a walkable top still counts
+    Constants.LedgeReachHeight = LedgeTraceHeight;
+    Constants.LedgeLookaheadStart = FVector(EyeTraceDistance, 0.f, LedgeTraceHeight);
+    Constants.LedgeLookaheadEnd = FVector(EyeTraceDistance, 0.f, LedgeTraceHeight - LedgeWalkableTraceDepth);
+    Constants.LedgeTrackSurfaceDot = FMath::Cos(FMath::DegreesToRadians(LedgeTrackMaxSurfaceTurn));
+
+    // Climbing down keeps the window the old walkable and ledge traces covered
+    FClimbObstacleRules& Rules = Constants.ObstacleRules;
+    Rules.MinObstacleHeight = MinObstacleHeight;
+    Rules.MaxStepOverHeight = MaxStepOverHeight;
+    Rules.MaxVaultHeight = MaxVaultHeight;
+    Rules.MaxVaultDepth = MaxVaultDepth;
+    Rules.MaxMantleHeight = MaxMantleHeight;
+    Rules.MinClearance = MinObstacleClearance;
+    Rules.MinClimbDownDistance = ClimbDownWalkableSurfaceTraceOffset;
+    Rules.MaxClimbDownDistance = ClimbDownWalkableSurfaceTraceOffset + ClimbDownLedgeTraceOffset;
+
+    Constants.LimbRestOffsets[static_cast<int32>(EClimbLimb::LeftHand)] = FVector(0.f, -HandSpread, HandHeight);
+    Constants.LimbRestOffsets[static_cast<int32>(EClimbLimb::RightHand)] = FVector(0.f, HandSpread, HandHeight);
+    Constants.LimbRestOffsets[static_cast<int32>(EClimbLimb::LeftFoot)] = FVector(0.f, -FootSpread, FootHeight);
+    Constants.LimbRestOffsets[static_cast<int32>(EClimbLimb::RightFoot)] = FVector(0.f, FootSpread, FootHeight);
+    Constants.LimbPatchNormalDot = FMath::Cos(FMath::DegreesToRadians(LimbPatchMaxAngle));
+}
@@ -0,0 +1,205 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Mass/ClimbingCrowdProcessor.h"
+#include "Mass/ClimbingCrowdFragments.h"
+#include "ClimbingSystem/ClimbingSystem.h"
+#include "ClimbingSystem/ClimbingStats.h"
+#include "ClimbingSystem/ClimbingSystemCharacter.h"
+#include "Climbing/ClimbMath.h"
+#include "Components/CustomMovementComponent.h"
+#include "Data/ClimbProfile.h"
+#include "MassCommonFragments.h"
+#include "MassCommonTypes.h"
+#include "MassExecutionContext.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+DECLARE_CYCLE_STAT(TEXT("ClimbingCrowdProcessor"), STAT_ClimbingCrowdProcessor, STATGROUP_Climbing);
+
+namespace
+{
+    // Same directions AClimbingSystemCharacter::HandleClimbMovementInput moves along
+    FVector GetCrowdClimbVelocity(const FQuat& Rotation, const FVector& SurfaceNormal, const FVector2f& SurfaceVelocity, float MaxClimbSpeed)
+    {
+        const FVector UpAlongWall = FVector::CrossProduct(-SurfaceNormal, Rotation.GetRightVector());
+        const FVector RightAlongWall = FVector::CrossProduct(-SurfaceNormal, -Rotation.GetUpVector());
+        return (RightAlongWall * SurfaceVelocity.X + UpAlongWall * SurfaceVelocity.Y).GetClampedToMaxSize(MaxClimbSpeed);
+    }
+}
+
+UClimbingCrowdProcessor::UClimbingCrowdProcessor()
+    : EntityQuery(*this)
+{
+    ExecutionFlags = static_cast<int32>(EProcessorExecutionFlags::All);
+    ProcessingPhase = EMassProcessingPhase::PrePhysics;
+    ExecutionOrder.ExecuteInGroup = UE::Mass::ProcessorGroupNames::Movement;
+
+    // Async trace submission and read back go through the world
+    bRequiresGameThreadExecution = true;
+}
+
+void UClimbingCrowdProcessor::ConfigureQueries()
+{
+    EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadWrite);
+    EntityQuery.AddRequirement<FClimbSurfaceNormalFragment>(EMassFragmentAccess::ReadWrite);
+    EntityQuery.AddRequirement<FClimbSurfacePointFragment>(EMassFragmentAccess::ReadWrite);
+    EntityQuery.AddRequirement<FClimbVelocityFragment>(EMassFragmentAccess::ReadWrite);
+    EntityQuery.AddRequirement<FClimbProbeFragment>(EMassFragmentAccess::ReadWrite);
+    EntityQuery.AddConstSharedRequirement<FClimbCrowdParameters>();
+    EntityQuery.AddTagRequirement<FClimbingCrowdTag>(EMassFragmentPresence::All);
+}
+
+void UClimbingCrowdProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+    CLIMB_SCOPE_CYCLE_COUNTER(STAT_ClimbingCrowdProcessor);
+
+    UWorld* World = EntityManager.GetWorld();
+    if(!World) return;
+
+    EntityQuery.ForEachEntityChunk(EntityManager, Context, [World](FMassExecutionContext& Context)
+    {
+        const FClimbCrowdParameters& Parameters = Context.GetConstSharedFragment<FClimbCrowdParameters>();
+        const UClimbProfile* Profile = Parameters.GetClimbProfile();
+        const FClimbProfileConstants& Constants = Profile->GetConstants();
+        const TArrayView<FTransformFragment> Transforms = Context.GetMutableFragmentView<FTransformFragment>();
+        const TArrayView<FClimbSurfaceNormalFragment> SurfaceNormals = Context.GetMutableFragmentView<FClimbSurfaceNormalFragment>();
+        const TArrayView<FClimbSurfacePointFragment> SurfacePoints = Context.GetMutableFragmentView<FClimbSurfacePointFragment>();
+        const TArrayView<FClimbVelocityFragment> Velocities = Context.GetMutableFragmentView<FClimbVelocityFragment>();
+        const TArrayView<FClimbProbeFragment> Probes = Context.GetMutableFragmentView<FClimbProbeFragment>();
+        const float DeltaTime = Context.GetDeltaTimeSeconds();
+
+        // One set of query params for the whole chunk, they all share the tuning
+        FCollisionObjectQueryParams ObjectQueryParams;
+        for(const TEnumAsByte<EObjectTypeQuery>& ObjectType : Parameters.ClimableSurfaceTraceTypes)
+        {
+            ObjectQueryParams.AddObjectTypesToQuery(UEngineTypes::ConvertToCollisionChannel(ObjectType));
+        }
+        const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ClimbCrowdProbe), false);
+        const FCollisionShape CapsuleShape = FCollisionShape::MakeCapsule(Profile->ClimbCapsuleTraceRadius, Profile->ClimbCapsuleTraceHalfHeight);
+
+        for(int32 EntityIndex = 0; EntityIndex < Context.GetNumEntities(); ++EntityIndex)
+        {
+            FTransform& Transform = Transforms[EntityIndex].GetMutableTransform();
+            FVector& SurfaceNormal = SurfaceNormals[EntityIndex].Normal;
+            FVector& SurfacePoint = SurfacePoints[EntityIndex].Point;
+            FClimbProbeFragment& Probe = Probes[EntityIndex];
+
+            // Same as ProcessClimbableSurfaceInfo, on last frame's sweep
+            FTraceDatum ProbeData;
+            const bool bProbeRead = Probe.SubmitFrame + 1 == GFrameCounter && World->QueryTraceData(Probe.PendingHandle, ProbeData);
+            if(bProbeRead)
+            {
+                ClimbMath::ReduceClimbableSurface(ProbeData.OutHits, {}, Transform.GetLocation(), Transform.GetRotation().GetForwardVector(), SurfacePoint, SurfaceNormal);
+                INC_DWORD_STAT_BY(STAT_ClimbTraceHits, ProbeData.OutHits.Num());
+            }
+
+            // Same as CheckShouldStopClimbing, a crowd climber has no fall to play so it leaves the crowd instead of hanging in the air
+            const bool bCanClimb = !SurfaceNormal.IsZero() && !ClimbMath::IsSurfaceTooFlat(SurfaceNormal, Constants.TooFlatSurfaceUpDot);
+            if(!bCanClimb && bProbeRead)
+            {
+                Context.Defer().DestroyEntity(Context.GetEntity(EntityIndex));
+                continue;
+            }
+
+            // Until its first probe comes back an entity waits where it spawned
+            if(bCanClimb)
+            {
+                const FQuat CurrentQuat = Transform.GetRotation();
+                const FVector ClimbVelocity = GetCrowdClimbVelocity(CurrentQuat, SurfaceNormal, Velocities[EntityIndex].SurfaceVelocity, Profile->MaxClimbSpeed);
+
+                // Same as GetClimbRotation and SnapMovementToClimableSurfaces
+                const FVector Location = Transform.GetLocation() + ClimbVelocity * DeltaTime;
+                const FVector SnapVector = ClimbMath::GetSnapVector(Location, CurrentQuat.GetForwardVector(), SurfacePoint, SurfaceNormal);
+
+                Transform.SetRotation(ClimbMath::GetClimbRotation(CurrentQuat, SurfaceNormal, DeltaTime, Constants.RotationInterpSpeed));
+                Transform.SetLocation(Location + SnapVector * DeltaTime * Profile->MaxClimbSpeed);
+            }
+
+            // Same sweep as TraceClimableSurfaces, read back next frame
+            const FQuat ProbeQuat = Transform.GetRotation();
+            const FVector Start = Transform.GetLocation() + ProbeQuat.RotateVector(Constants.SurfaceSweepStart);
+            const FVector End = Transform.GetLocation() + ProbeQuat.RotateVector(Constants.SurfaceSweepEnd);
+            Probe.PendingHandle = Parameters.bTraceClimbableChannel
+                ? World->AsyncSweepByChannel(EAsyncTraceType::Multi, Start, End, FQuat::Identity, ECC_Climbable, CapsuleShape, QueryParams)
+                : World->AsyncSweepByObjectType(EAsyncTraceType::Multi, Start, End, FQuat::Identity, ObjectQueryParams, CapsuleShape, QueryParams);
+            Probe.SubmitFrame = GFrameCounter;
+            INC_DWORD_STAT(STAT_ClimbTracesIssued);
+        }
+    });
+}
+
+UClimbingCrowdPromotionProcessor::UClimbingCrowdPromotionProcessor()
+    : EntityQuery(*this)
+{
+    ExecutionFlags = static_cast<int32>(EProcessorExecutionFlags::All);
+    ProcessingPhase = EMassProcessingPhase::PrePhysics;
+    ExecutionOrder.ExecuteAfter.Add(UE::Mass::ProcessorGroupNames::Movement);
+
+    // Spawns actors
+    bRequiresGameThreadExecution = true;
+}
+
+void UClimbingCrowdPromotionProcessor::ConfigureQueries()
+{
+    EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
+    EntityQuery.AddRequirement<FClimbSurfaceNormalFragment>(EMassFragmentAccess::ReadOnly);
+    EntityQuery.AddRequirement<FClimbVelocityFragment>(EMassFragmentAccess::ReadOnly);
+    EntityQuery.AddConstSharedRequirement<FClimbCrowdParameters>();
+    EntityQuery.AddTagRequirement<FClimbingCrowdTag>(EMassFragmentPresence::All);
+}
+
+void UClimbingCrowdPromotionProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+    UWorld* World = EntityManager.GetWorld();
+    if(!World) return;
+
+    TArray<FVector, TInlineAllocator<4>> PlayerLocations;
+    for(FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+    {
+        if(const APawn* PlayerPawn = It->Get() ? It->Get()->GetPawn() : nullptr)
+        {
+            PlayerLocations.Add(PlayerPawn->GetActorLocation());
+        }
+    }
+    if(PlayerLocations.IsEmpty()) return;
+
+    EntityQuery.ForEachEntityChunk(EntityManager, Context, [World, &PlayerLocations](FMassExecutionContext& Context)
+    {
+        const FClimbCrowdParameters& Parameters = Context.GetConstSharedFragment<FClimbCrowdParameters>();
+        if(!Parameters.PromotedCharacterClass) return;
+
+        const TConstArrayView<FTransformFragment> Transforms = Context.GetFragmentView<FTransformFragment>();
+        const TConstArrayView<FClimbSurfaceNormalFragment> SurfaceNormals = Context.GetFragmentView<FClimbSurfaceNormalFragment>();
+        const TConstArrayView<FClimbVelocityFragment> Velocities = Context.GetFragmentView<FClimbVelocityFragment>();
+        const float PromotionDistanceSquared = FMath::Square(Parameters.PromotionDistance);
+
+        for(int32 EntityIndex = 0; EntityIndex < Context.GetNumEntities(); ++EntityIndex)
+        {
+            const FTransform& Transform = Transforms[EntityIndex].GetTransform();
+            const bool bNearPlayer = PlayerLocations.ContainsByPredicate([&](const FVector& PlayerLocation)
+            {
+                return FVector::DistSquared(PlayerLocation, Transform.GetLocation()) <= PromotionDistanceSquared;
+            });
+            if(!bNearPlayer) continue;
+
+            FActorSpawnParameters SpawnParameters;
+            SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+            AClimbingSystemCharacter* Character = World->SpawnActor<AClimbingSystemCharacter>(Parameters.PromotedCharacterClass, Transform, SpawnParameters);
+            if(!Character) continue;
+
+            // A controller to drive it like any other placed AI climber
+            Character->SpawnDefaultController();
+
+            // Carry on climbing where the entity left off, at the speed it was climbing at
+            const FVector& SurfaceNormal = SurfaceNormals[EntityIndex].Normal;
+            UCustomMovementComponent* MovementComponent = Character->GetCustomeMovementComponent();
+            if(MovementComponent && !SurfaceNormal.IsZero())
+            {
+                MovementComponent->ForceStartClimbing();
+                MovementComponent->Velocity = GetCrowdClimbVelocity(Transform.GetRotation(), SurfaceNormal, Velocities[EntityIndex].SurfaceVelocity, Parameters.GetClimbProfile()->MaxClimbSpeed);
+            }
+            Context.Defer().DestroyEntity(Context.GetEntity(EntityIndex));
+        }
+    });
+}
@@ -0,0 +1,23 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Mass/ClimbingCrowdTrait.h"
+#include "MassCommonFragments.h"
+#include "MassEntityTemplateRegistry.h"
+#include "MassEntityUtils.h"
+
+void UClimbingCrowdTrait::BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, const UWorld& World) const
+{
+    FMassEntityManager& EntityManager = UE::Mass::Utils::GetEntityManagerChecked(World);
+
+    BuildContext.RequireFragment<FTransformFragment>();
+    BuildContext.AddFragment<FClimbSurfaceNormalFragment>();
+    BuildContext.AddFragment<FClimbSurfacePointFragment>();
+    BuildContext.AddFragment<FClimbProbeFragment>();
+    BuildContext.AddFragment_GetRef<FClimbVelocityFragment>().SurfaceVelocity = InitialSurfaceVelocity;
+    BuildContext.AddTag<FClimbingCrowdTag>();
+
+    // Every entity of this config shares one copy of the tuning
+    const FConstSharedStruct SharedParameters = EntityManager.GetOrCreateConstSharedFragment(Parameters);
+    BuildContext.AddConstSharedFragment(SharedParameters);
+}
@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/ClimbLedgeGraphSubsystem.h"
+#include "Data/ClimbLedgeGraph.h"
+#include "ClimbingSystem/ClimbingStats.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/Level.h"
+#include "Misc/PackageName.h"
+
+void UClimbLedgeGraphSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    LLM_SCOPE_BYTAG(Climbing);
+
+    // PIE worlds carry a prefix on their package name
+    const FString MapName = FPackageName::GetShortName(UWorld::RemovePIEPrefix(InWorld.GetOutermost()->GetName()));
+    const FString PackageName = GetLedgeGraphPackageName(MapName);
+    const FString ObjectPath = PackageName + TEXT(".") + FPackageName::GetShortName(PackageName);
+
+    // Not every map has a baked graph, climbers fall back to traces without one
+    if(!FPackageName::DoesPackageExist(PackageName)) return;
+
+    LedgeGraph = LoadObject<UClimbLedgeGraph>(nullptr, *ObjectPath, nullptr, LOAD_NoWarn | LOAD_Quiet);
+    if(!LedgeGraph) return;
+
+    BakedComponentPaths.Append(LedgeGraph->BakedComponentPaths);
+}
+
+void UClimbLedgeGraphSubsystem::Deinitialize()
+{
+    LedgeGraph = nullptr;
+    BakedComponentPaths.Reset();
+    BakedComponentCache.Reset();
+
+    Super::Deinitialize();
+}
+
+bool UClimbLedgeGraphSubsystem::IsComponentBaked(const UPrimitiveComponent* Component) const
+{
+    if(!LedgeGraph || !Component) return false;
+
+    // Anything that can move may have left the spot it was baked at
+    if(Component->Mobility != EComponentMobility::Static) return false;
+
+    if(const bool* bCachedBaked = BakedComponentCache.Find(Component))
+    {
+        return *bCachedBaked;
+    }
+
+    const bool bBaked = BakedComponentPaths.Contains(GetBakedComponentKey(Component));
+    BakedComponentCache.Add(Component, bBaked);
+    return bBaked;
+}
+
+FString UClimbLedgeGraphSubsystem::GetLedgeGraphPackageName(const FString& MapName)
+{
+    return FString::Printf(TEXT("/Game/Climbing/LedgeGraphs/%s_LedgeGraph"), *MapName);
+}
+
+FName UClimbLedgeGraphSubsystem::GetBakedComponentKey(const UPrimitiveComponent* Component)
+{
+    // A path relative to the world would carry the PIE prefix and differ for primitives of streamed levels
+    const ULevel* Level = Component->GetComponentLevel();
+    const FString LevelPackageName = UWorld::RemovePIEPrefix(Component->GetOutermost()->GetName());
+    return FName(*FString::Printf(TEXT("%s:%s"), *LevelPackageName, *Component->GetPathName(Level)));
+}
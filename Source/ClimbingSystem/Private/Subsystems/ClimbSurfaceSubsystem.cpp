@@ -0,0 +1,92 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/ClimbSurfaceSubsystem.h"
+#include "ClimbingSystem/ClimbingStats.h"
+#include "Components/PrimitiveComponent.h"
+#include "Engine/HitResult.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+
+bool UClimbSurfaceSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+    return Super::ShouldCreateSubsystem(Outer) && GetDefault<UClimbSurfaceSettings>()->HasRules();
+}
+
+void UClimbSurfaceSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    LLM_SCOPE_BYTAG(Climbing);
+
+    // The meshes using these materials hold them anyway, so loading them up front costs nothing extra
+    for(const TPair<TSoftObjectPtr<UPhysicalMaterial>, FClimbSurfaceRule>& MaterialRule : GetDefault<UClimbSurfaceSettings>()->PhysicalMaterialRules)
+    {
+        if(const UPhysicalMaterial* PhysMaterial = MaterialRule.Key.LoadSynchronous())
+        {
+            PhysicalMaterialRules.Add(PhysMaterial, MaterialRule.Value);
+        }
+    }
+
+    // Registering, unregistering and collision changes all rebuild the physics state
+    CreatePhysicsHandle = UActorComponent::GlobalCreatePhysicsDelegate.AddUObject(this, &ThisClass::InvalidateComponent);
+    DestroyPhysicsHandle = UActorComponent::GlobalDestroyPhysicsDelegate.AddUObject(this, &ThisClass::InvalidateComponent);
+}
+
+void UClimbSurfaceSubsystem::Deinitialize()
+{
+    UActorComponent::GlobalCreatePhysicsDelegate.Remove(CreatePhysicsHandle);
+    UActorComponent::GlobalDestroyPhysicsDelegate.Remove(DestroyPhysicsHandle);
+
+    SurfaceRuleCache.Reset();
+    PhysicalMaterialRules.Reset();
+
+    Super::Deinitialize();
+}
+
+FClimbSurfaceRule UClimbSurfaceSubsystem::GetSurfaceRule(const FHitResult& Hit)
+{
+    const UPrimitiveComponent* Component = Hit.GetComponent();
+    if(!Component) return FClimbSurfaceRule();
+
+    const UPhysicalMaterial* PhysMaterial = Hit.PhysMaterial.Get();
+    const TObjectKey<UPhysicalMaterial> MaterialKey(PhysMaterial);
+
+    TArray<FCachedSurfaceRule, TInlineAllocator<2>>& CachedRules = SurfaceRuleCache.FindOrAdd(Component);
+    for(const FCachedSurfaceRule& CachedRule : CachedRules)
+    {
+        if(CachedRule.PhysMaterial == MaterialKey) return CachedRule.Rule;
+    }
+
+    LLM_SCOPE_BYTAG(Climbing);
+
+    const FClimbSurfaceRule Rule = ResolveSurfaceRule(Component, PhysMaterial);
+    CachedRules.Add({MaterialKey, Rule});
+    return Rule;
+}
+
+FClimbSurfaceRule UClimbSurfaceSubsystem::ResolveSurfaceRule(const UPrimitiveComponent* Component, const UPhysicalMaterial* PhysMaterial) const
+{
+    for(const FName& Tag : Component->ComponentTags)
+    {
+        if(const FClimbSurfaceRule* TagRule = GetDefault<UClimbSurfaceSettings>()->ComponentTagRules.Find(Tag))
+        {
+            return *TagRule;
+        }
+    }
+
+    if(const FClimbSurfaceRule* MaterialRule = PhysicalMaterialRules.Find(PhysMaterial))
+    {
+        return *MaterialRule;
+    }
+
+    return FClimbSurfaceRule();
+}
+
+void UClimbSurfaceSubsystem::InvalidateComponent(UActorComponent* Component)
+{
+    // Fires for every world, only primitives can be in our cache
+    const UPrimitiveComponent* Primitive = Cast<UPrimitiveComponent>(Component);
+    if(!Primitive || Primitive->GetWorld() != GetWorld()) return;
+
+    SurfaceRuleCache.Remove(Primitive);
+}
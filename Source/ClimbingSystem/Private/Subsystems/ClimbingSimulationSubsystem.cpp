@@ -0,0 +1,151 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Subsystems/ClimbingSimulationSubsystem.h"
+#include "ClimbingSystem/ClimbingStats.h"
+#include "Components/CustomMovementComponent.h"
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+namespace
+{
+    // Climbers per chunk of the parallel solve
+    constexpr int32 ClimbSolveChunkSize = 8;
+
+    int32 GClimbSimulationMaxWorkers = 0;
+    FAutoConsoleVariableRef CVarClimbSimulationMaxWorkers(
+        TEXT("Climbing.Simulation.MaxWorkers"),
+        GClimbSimulationMaxWorkers,
+        TEXT("Most tasks the batched climb solve is split into, 0 for one per chunk of climbers. 1 solves on the game thread."));
+}
+
+void FClimbingSimulationTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+    if(Subsystem && TickType != LEVELTICK_ViewportsOnly)
+    {
+        Subsystem->Simulate(DeltaTime);
+    }
+}
+
+FString FClimbingSimulationTickFunction::DiagnosticMessage()
+{
+    return TEXT("FClimbingSimulationTickFunction");
+}
+
+FName FClimbingSimulationTickFunction::DiagnosticContext(bool bDetailed)
+{
+    return FName(TEXT("ClimbingSimulation"));
+}
+
+void UClimbingSimulationSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    // Same group as character movement, climbers add us as a prerequisite so the batch is solved first
+    SimulationTickFunction.Subsystem = this;
+    SimulationTickFunction.bCanEverTick = true;
+    SimulationTickFunction.bStartWithTickEnabled = true;
+    SimulationTickFunction.TickGroup = TG_PrePhysics;
+    SimulationTickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+}
+
+void UClimbingSimulationSubsystem::Deinitialize()
+{
+    if(SimulationTickFunction.IsTickFunctionRegistered())
+    {
+        SimulationTickFunction.UnRegisterTickFunction();
+    }
+    SimulationTickFunction.Subsystem = nullptr;
+
+    Climbers.Reset();
+    BatchClimbers.Reset();
+    Batch.Reset();
+
+    Super::Deinitialize();
+}
+
+void UClimbingSimulationSubsystem::RegisterClimber(UCustomMovementComponent* Climber)
+{
+    if(!Climber || Climbers.Contains(Climber)) return;
+
+    Climbers.Add(Climber);
+    Climber->PrimaryComponentTick.AddPrerequisite(this, SimulationTickFunction);
+}
+
+void UClimbingSimulationSubsystem::UnregisterClimber(UCustomMovementComponent* Climber)
+{
+    if(!Climber || Climbers.Remove(Climber) == 0) return;
+
+    Climber->PrimaryComponentTick.RemovePrerequisite(this, SimulationTickFunction);
+}
+
+void UClimbingSimulationSubsystem::Simulate(float DeltaTime)
+{
+    LLM_SCOPE_BYTAG(Climbing);
+
+    LastSerialCycles = 0;
+    LastParallelCycles = 0;
+    if(Climbers.IsEmpty()) return;
+
+    Batch.Reset();
+    BatchClimbers.Reset();
+
+    // Serial: probes touch the physics scene and the climbers' state
+    uint64 StartCycles = FPlatformTime::Cycles64();
+    {
+        CLIMB_SCOPE_CYCLE_COUNTER(STAT_ClimbSimSerial);
+
+        for(UCustomMovementComponent* Climber : Climbers)
+        {
+            if(IsValid(Climber) && Climber->GatherClimbSolveInput(Batch, DeltaTime))
+            {
+                BatchClimbers.Add(Climber);
+            }
+        }
+    }
+
+    const int32 NumClimbers = BatchClimbers.Num();
+    SET_DWORD_STAT(STAT_ClimbersBatched, NumClimbers);
+    LastSerialCycles += FPlatformTime::Cycles64() - StartCycles;
+    if(NumClimbers == 0) return;
+
+    // Parallel: pure math over the flattened batch in chunks, each chunk reduces its contacts in one pass and only writes its own outputs.
+    // A task takes every NumTasks-th chunk, so capping the tasks caps the workers the solve occupies
+    Batch.Outputs.SetNum(NumClimbers);
+    StartCycles = FPlatformTime::Cycles64();
+    {
+        CLIMB_SCOPE_CYCLE_COUNTER(STAT_ClimbSimParallel);
+
+        const int32 NumChunks = FMath::DivideAndRoundUp(NumClimbers, ClimbSolveChunkSize);
+        const int32 NumTasks = GClimbSimulationMaxWorkers > 0 ? FMath::Min(GClimbSimulationMaxWorkers, NumChunks) : NumChunks;
+        ParallelFor(TEXT("ClimbSolve"), NumTasks, 1, [this, NumClimbers, NumChunks, NumTasks](int32 Task)
+        {
+            for(int32 Chunk = Task; Chunk < NumChunks; Chunk += NumTasks)
+            {
+                const int32 First = Chunk * ClimbSolveChunkSize;
+                const int32 Num = FMath::Min(ClimbSolveChunkSize, NumClimbers - First);
+
+                ClimbMath::ReduceClimbableSurfaces(Batch, First, Num, Batch.Outputs);
+                for(int32 Index = First; Index < First + Num; ++Index)
+                {
+                    ClimbMath::SolveClimb(Batch, Index, Batch.Outputs[Index]);
+                }
+            }
+        });
+    }
+    LastParallelCycles = FPlatformTime::Cycles64() - StartCycles;
+
+    // Serial: hand each climber its result, the moves happen in their PhysClimb
+    StartCycles = FPlatformTime::Cycles64();
+    {
+        CLIMB_SCOPE_CYCLE_COUNTER(STAT_ClimbSimSerial);
+
+        for(int32 Index = 0; Index < NumClimbers; ++Index)
+        {
+            Batch.Outputs[Index].SolveFrame = GFrameCounter;
+            BatchClimbers[Index]->SetClimbSolveOutput(Batch.Outputs[Index]);
+        }
+    }
+    LastSerialCycles += FPlatformTime::Cycles64() - StartCycles;
+}
@@ -0,0 +1,130 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Tests/ClimbTestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "ClimbingSystem/ClimbingDiagnostics.h"
+#include "ClimbingSystem/ClimbingSystemCharacter.h"
+#include "Misc/AutomationTest.h"
+
+#if CLIMB_DIAGNOSTICS
+
+namespace
+{
+    /* Sets a diagnostics cvar for the length of a test and puts it back after */
+    struct FScopedClimbDiagnostic
+    {
+        int32& Value;
+        const int32 PreviousValue;
+
+        FScopedClimbDiagnostic(int32& InValue, int32 NewValue)
+            : Value(InValue)
+            , PreviousValue(InValue)
+        {
+            Value = NewValue;
+        }
+
+        ~FScopedClimbDiagnostic()
+        {
+            Value = PreviousValue;
+        }
+    };
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbDiagnosticsOffAllocationTest, "ClimbingSystem.Allocations.DiagnosticsOff",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+// With the diagnostics cvars off the climb tick must not build log strings or visual log entries, so a scripted climb allocates nothing
+bool FClimbDiagnosticsOffAllocationTest::RunTest(const FString& Parameters)
+{
+    if(!TestTrue(TEXT("Allocations can be counted on this platform"), FClimbAllocationCounter::IsAvailable())) return false;
+
+    FScopedClimbDiagnostic LogOff(ClimbDiagnostics::GLogEnabled, 0);
+    FScopedClimbDiagnostic VisualLogOff(ClimbDiagnostics::GVisualLogEnabled, 0);
+
+    FClimbTestWorld TestWorld;
+    TestWorld.SpawnTestWall();
+
+    AClimbingSystemCharacter* Climber = TestWorld.SpawnClimber(0.f, 300.f);
+    if(!TestNotNull(TEXT("Climber"), Climber)) return false;
+    AClimbingSystemCharacter* const Climbers[] = {Climber};
+
+    // The first pass grows every reused buffer, the second is the one counted
+    TestWorld.RunScript(Climbers, FClimbTestWorld::GetClimbScript(), [](int32 Frame) {});
+
+    int64 NumAllocations = 0;
+    int32 NumCountedTicks = 0;
+    {
+        FClimbTickAllocationCounter Counter(*Climber);
+        TestWorld.RunScript(Climbers, FClimbTestWorld::GetClimbScript(), [](int32 Frame) {});
+        NumAllocations = static_cast<int64>(Counter.GetNumAllocations());
+        NumCountedTicks = Counter.GetNumTicks();
+    }
+
+    TestTrue(TEXT("Climber still climbing"), Climber->GetCustomeMovementComponent()->IsClimbing());
+    TestEqual(TEXT("Climb ticks counted"), NumCountedTicks, FClimbTestWorld::GetNumScriptFrames(FClimbTestWorld::GetClimbScript()));
+    TestEqual(TEXT("Allocations in a scripted climb with diagnostics off"), NumAllocations, static_cast<int64>(0));
+
+    return true;
+}
+
+#endif
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbSteadyTickAllocationTest, "ClimbingSystem.Allocations.SteadyClimbTick",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+// 1000 climb ticks back and forth along the wall once the reused buffers have grown, not one of them may allocate
+bool FClimbSteadyTickAllocationTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 NumSteadyTicks = 1000;
+
+    if(!TestTrue(TEXT("Allocations can be counted on this platform"), FClimbAllocationCounter::IsAvailable())) return false;
+
+    FClimbTestWorld TestWorld;
+    TestWorld.SpawnTestWall();
+
+    AClimbingSystemCharacter* Climber = TestWorld.SpawnClimber(0.f, 400.f);
+    if(!TestNotNull(TEXT("Climber"), Climber)) return false;
+    UCustomMovementComponent* Movement = Climber->GetCustomeMovementComponent();
+    AClimbingSystemCharacter* const Climbers[] = {Climber};
+
+    // Sideways both ways and never still, so the climber keeps probing instead of falling asleep on the wall
+    const FClimbTestStep Script[] =
+    {
+        {FVector2D(1.f, 0.f), 100},
+        {FVector2D(-1.f, 0.f), 100}
+    };
+    TestWorld.RunScript(Climbers, Script, [](int32 Frame) {});
+
+    TArray<const void*> BuffersBefore;
+    FClimbTestAccess::GetReusedBuffers(*Movement, BuffersBefore);
+
+    int64 NumAllocations = 0;
+    int32 NumCountedTicks = 0;
+    {
+        FClimbTickAllocationCounter Counter(*Climber);
+        for(int32 Pass = 0; Pass < NumSteadyTicks / FClimbTestWorld::GetNumScriptFrames(Script); ++Pass)
+        {
+            TestWorld.RunScript(Climbers, Script, [](int32 Frame) {});
+        }
+        NumAllocations = static_cast<int64>(Counter.GetNumAllocations());
+        NumCountedTicks = Counter.GetNumTicks();
+    }
+
+    TArray<const void*> BuffersAfter;
+    FClimbTestAccess::GetReusedBuffers(*Movement, BuffersAfter);
+
+    TestTrue(TEXT("Climber still climbing"), Movement->IsClimbing());
+    TestEqual(TEXT("Climb ticks counted"), NumCountedTicks, NumSteadyTicks);
+    TestEqual(TEXT("Allocations in 1000 steady climb ticks"), NumAllocations, static_cast<int64>(0));
+    for(int32 Index = 0; Index < BuffersBefore.Num(); ++Index)
+    {
+        TestTrue(FString::Printf(TEXT("Reused buffer %d kept its allocation"), Index), BuffersAfter[Index] == BuffersBefore[Index]);
+    }
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,167 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Tests/ClimbTestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "ClimbingSystem/ClimbingSystemCharacter.h"
+#include "Components/ClimbingMeshComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "IAnimationBudgetAllocator.h"
+#include "Misc/AutomationTest.h"
+#include "SignificanceManager.h"
+
+namespace
+{
+    /* Viewpoint straight out from the climber's wall, Distance away from it */
+    FTransform GetViewpointInFront(const AClimbingSystemCharacter& Climber, float Distance)
+    {
+        return FTransform(Climber.GetActorLocation() - FVector::ForwardVector * Distance);
+    }
+
+    /* Climb up for a second at whatever tier the climber is in, returning how many climb traces it issued */
+    uint64 ClimbUpForASecond(FClimbTestWorld& TestWorld, AClimbingSystemCharacter& Climber)
+    {
+        const uint64 TracesBefore = Climber.GetCustomeMovementComponent()->GetClimbTracesIssued();
+        AClimbingSystemCharacter* const Climbers[] = {&Climber};
+        const FClimbTestStep Script[] = {{FVector2D(0.f, 1.f), 60}};
+        TestWorld.RunScript(Climbers, Script, [](int32 Frame) {});
+        return Climber.GetCustomeMovementComponent()->GetClimbTracesIssued() - TracesBefore;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbLODTierTest, "ClimbingSystem.LOD.TiersFollowViewDistance",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+// An AI climber's tier as the only viewpoint moves away, and what each tier still does on the wall
+bool FClimbLODTierTest::RunTest(const FString& Parameters)
+{
+    FClimbTestWorld TestWorld;
+    TestWorld.SpawnTestWall();
+
+    USignificanceManager* SignificanceManager = USignificanceManager::Get(TestWorld.GetWorld());
+    if(!TestNotNull(TEXT("Significance manager"), SignificanceManager)) return false;
+
+    AClimbingSystemCharacter* Climber = TestWorld.SpawnClimber(0.f, 200.f);
+    if(!TestNotNull(TEXT("Climber"), Climber)) return false;
+    UCustomMovementComponent* Movement = Climber->GetCustomeMovementComponent();
+
+    // Nothing renders here, so the freeze is off until the freeze check below
+    FClimbTestAccess::EnableClimbLOD(*Movement, 0.f);
+    const FClimbLODSettings& Settings = FClimbTestAccess::GetClimbLODSettings(*Movement);
+
+    SignificanceManager->Update(TArrayView<const FTransform>({GetViewpointInFront(*Climber, Settings.ReducedDistance * 0.5f)}));
+    TestEqual(TEXT("Close climber is Full"), Movement->GetClimbLODTier(), EClimbLODTier::Full);
+    const uint64 FullTraces = ClimbUpForASecond(TestWorld, *Climber);
+
+    SignificanceManager->Update(TArrayView<const FTransform>({GetViewpointInFront(*Climber, (Settings.ReducedDistance + Settings.SurfaceLockedDistance) * 0.5f)}));
+    TestEqual(TEXT("Mid range climber is Reduced"), Movement->GetClimbLODTier(), EClimbLODTier::Reduced);
+    const uint64 ReducedTraces = ClimbUpForASecond(TestWorld, *Climber);
+
+    SignificanceManager->Update(TArrayView<const FTransform>({GetViewpointInFront(*Climber, Settings.SurfaceLockedDistance * 2.f)}));
+    TestEqual(TEXT("Far climber is SurfaceLocked"), Movement->GetClimbLODTier(), EClimbLODTier::SurfaceLocked);
+    const float LockedStartZ = Climber->GetActorLocation().Z;
+    const uint64 LockedTraces = ClimbUpForASecond(TestWorld, *Climber);
+
+    AddInfo(FString::Printf(TEXT("Climb traces over 60 frames: Full %llu, Reduced %llu, SurfaceLocked %llu"), FullTraces, ReducedTraces, LockedTraces));
+    TestTrue(TEXT("Reduced probes less than Full"), ReducedTraces < FullTraces);
+    TestTrue(TEXT("SurfaceLocked probes less than Reduced"), LockedTraces < ReducedTraces);
+    TestTrue(TEXT("SurfaceLocked climber still climbs"), Movement->IsClimbing() && Climber->GetActorLocation().Z > LockedStartZ + 10.f);
+
+    // A standalone game that never rendered the climber freezes it whatever the distance
+    FClimbTestAccess::EnableClimbLOD(*Movement, 0.5f);
+    SignificanceManager->Update(TArrayView<const FTransform>({GetViewpointInFront(*Climber, Settings.ReducedDistance * 0.5f)}));
+    TestEqual(TEXT("Unrendered standalone climber is Frozen"), Movement->GetClimbLODTier(), EClimbLODTier::Frozen);
+
+    return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbCrowdAnimBudgetTest, "ClimbingSystem.LOD.CrowdAnimationBudget",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+// A crowd of AI climbers hanging still next to the player's own climber under an enabled animation budget,
+// what each asks of it and what the budgeted meshes spent
+bool FClimbCrowdAnimBudgetTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 NumCrowdClimbers = 32;
+    constexpr float BudgetMs = 1.f;
+
+    FClimbTestWorld TestWorld;
+    TestWorld.SpawnTestWall();
+
+    // The allocator belongs to the test world, what is set here goes with it
+    IAnimationBudgetAllocator* BudgetAllocator = IAnimationBudgetAllocator::Get(TestWorld.GetWorld());
+    if(!TestNotNull(TEXT("Animation budget allocator"), BudgetAllocator)) return false;
+    FAnimationBudgetAllocatorParameters BudgetParameters = BudgetAllocator->GetParameters();
+    BudgetParameters.BudgetInMs = BudgetMs;
+    BudgetAllocator->SetParameters(BudgetParameters);
+    BudgetAllocator->SetEnabled(true);
+
+    TArray<AClimbingSystemCharacter*> Crowd;
+    for(int32 Index = 0; Index < NumCrowdClimbers; ++Index)
+    {
+        if(AClimbingSystemCharacter* Climber = TestWorld.SpawnClimber(-800.f + 1500.f * Index / (NumCrowdClimbers - 1), 300.f))
+        {
+            Crowd.Add(Climber);
+        }
+    }
+
+    AClimbingSystemCharacter* PlayerClimber = TestWorld.SpawnClimber(900.f, 300.f);
+    if(!TestNotNull(TEXT("Player climber"), PlayerClimber)) return false;
+    APlayerController* PlayerController = TestWorld.GetWorld()->SpawnActor<APlayerController>();
+    if(!TestNotNull(TEXT("Player controller"), PlayerController)) return false;
+    PlayerController->Possess(PlayerClimber);
+    TestTrue(TEXT("Player climber is locally controlled"), PlayerClimber->IsLocallyControlled());
+
+    TArray<const UClimbingMeshComponent*> Meshes;
+    for(const AClimbingSystemCharacter* Climber : Crowd)
+    {
+        Meshes.Add(Cast<UClimbingMeshComponent>(Climber->GetMesh()));
+    }
+    Meshes.Add(Cast<UClimbingMeshComponent>(PlayerClimber->GetMesh()));
+    if(!TestFalse(TEXT("Every climber has a budgeted climbing mesh"), Meshes.Contains(nullptr))) return false;
+
+    // Nobody moves, every climber hangs still on the wall. A second to settle first, the allocator starts from an estimate
+    TestWorld.Tick(60);
+    FClimbPerfSamples FrameTimes;
+    FClimbPerfSamples BudgetedTimes;
+    int32 NumMeshTicks = 0;
+    uint64 LastCycles = FPlatformTime::Cycles64();
+    for(int32 Frame = 0; Frame < 120; ++Frame)
+    {
+        TestWorld.Tick();
+        const uint64 NowCycles = FPlatformTime::Cycles64();
+        FrameTimes.AddCycles(NowCycles - LastCycles);
+        LastCycles = NowCycles;
+
+        // What the meshes handed the allocator this frame. The native climbers have no mesh asset, so this is the budgeted tick without a pose to evaluate
+        float FrameBudgetedMs = 0.f;
+        for(const UClimbingMeshComponent* Mesh : Meshes)
+        {
+            const float MeshMs = Mesh->GetAnimationGameThreadMs();
+            FrameBudgetedMs += MeshMs;
+            NumMeshTicks += MeshMs > 0.f ? 1 : 0;
+        }
+        BudgetedTimes.Microseconds.Add(FrameBudgetedMs * 1000.0);
+    }
+    AddInfo(FString::Printf(TEXT("%d hanging climbers and the player: %s"), NumCrowdClimbers, *FrameTimes.ToString()));
+    AddInfo(FString::Printf(TEXT("Budgeted meshes against a %.1f ms budget: %s, %d of %d mesh ticks"), BudgetMs, *BudgetedTimes.ToString(), NumMeshTicks, 120 * Meshes.Num()));
+
+    // The allocator evens out over frames, a single frame may go over while it catches up
+    TestTrue(FString::Printf(TEXT("Median budgeted mesh time %.3f ms is within the %.1f ms budget"), BudgetedTimes.GetPercentile(0.5f) / 1000.0, BudgetMs),
+        BudgetedTimes.GetPercentile(0.5f) / 1000.0 <= BudgetMs);
+
+    const float HangingScale = FClimbTestAccess::GetClimbLODSettings(*PlayerClimber->GetCustomeMovementComponent()).HangingAnimSignificanceScale;
+    for(const AClimbingSystemCharacter* Climber : Crowd)
+    {
+        const float Significance = FClimbTestAccess::GetAnimBudgetSignificance(*Climber->GetCustomeMovementComponent());
+        TestTrue(FString::Printf(TEXT("Hanging AI climber significance %.2f is scaled down"), Significance), Significance >= 0.f && Significance <= HangingScale);
+    }
+    TestEqual(TEXT("Player's own hanging climber keeps full significance"), FClimbTestAccess::GetAnimBudgetSignificance(*PlayerClimber->GetCustomeMovementComponent()), 1.f);
+
+    return true;
+}
+
+#endif
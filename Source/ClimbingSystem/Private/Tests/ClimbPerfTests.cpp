@@ -0,0 +1,935 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Tests/ClimbTestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Async/TaskGraphInterfaces.h"
+#include "ClimbingSystem/ClimbingSystemCharacter.h"
+#include "Climbing/ClimbMath.h"
+#include "Climbing/ClimbObstacle.h"
+#include "Climbing/ClimbSession.h"
+#include "Climbing/ClimbSolve.h"
+#include "Data/ClimbProfile.h"
+#include "HAL/IConsoleManager.h"
+#include "Mass/ClimbingCrowdFragments.h"
+#include "Mass/ClimbingCrowdProcessor.h"
+#include "MassCommonFragments.h"
+#include "MassEntitySubsystem.h"
+#include "MassExecutor.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Policies/PrettyJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+#include "SignificanceManager.h"
+#include "Subsystems/ClimbingSimulationSubsystem.h"
+
+namespace
+{
+    /* What one scripted run of a group of climbers cost */
+    struct FClimbPerfRun
+    {
+        /* Sum of the climbers' movement component ticks, per frame */
+        FClimbPerfSamples TickTimes;
+        uint64 TracesIssued = 0;
+        uint64 TraceHits = 0;
+        int32 ClimberTicks = 0;
+
+        FString ToString() const
+        {
+            return FString::Printf(TEXT("%s, %.2f traces and %.2f hits per climber tick"), *TickTimes.ToString(),
+                static_cast<double>(TracesIssued) / FMath::Max(ClimberTicks, 1), static_cast<double>(TraceHits) / FMath::Max(ClimberTicks, 1));
+        }
+    };
+
+    /* Run the climb script on every climber, timing their movement ticks */
+    FClimbPerfRun RunClimbPerfScript(FClimbTestWorld& TestWorld, TConstArrayView<AClimbingSystemCharacter*> Climbers)
+    {
+        FClimbPerfRun Run;
+        for(const AClimbingSystemCharacter* Climber : Climbers)
+        {
+            Run.TracesIssued -= Climber->GetCustomeMovementComponent()->GetClimbTracesIssued();
+            Run.TraceHits -= Climber->GetCustomeMovementComponent()->GetClimbTraceHitsReturned();
+        }
+
+        TestWorld.RunScript(Climbers, FClimbTestWorld::GetClimbScript(), [&](int32 Frame)
+        {
+            uint64 FrameCycles = 0;
+            for(const AClimbingSystemCharacter* Climber : Climbers)
+            {
+                FrameCycles += Climber->GetCustomeMovementComponent()->GetLastTickCycles();
+            }
+            Run.TickTimes.AddCycles(FrameCycles);
+            Run.ClimberTicks += Climbers.Num();
+        });
+
+        for(const AClimbingSystemCharacter* Climber : Climbers)
+        {
+            Run.TracesIssued += Climber->GetCustomeMovementComponent()->GetClimbTracesIssued();
+            Run.TraceHits += Climber->GetCustomeMovementComponent()->GetClimbTraceHitsReturned();
+        }
+        return Run;
+    }
+
+    /* One row of the climb operations report */
+    struct FClimbOperationResult
+    {
+        FString Name;
+        int32 NumOps = 0;
+        uint64 Cycles = 0;
+        uint64 Traces = 0;
+
+        /* Counted on runs of their own so the counting allocator stays out of the timings, INDEX_NONE if they could not be */
+        int64 Allocations = INDEX_NONE;
+        int32 NumCountedOps = 0;
+    };
+
+    /* One climb check timed once per climber per frame while the world ticks around it */
+    struct FClimbOperationTiming
+    {
+        const TCHAR* Name = nullptr;
+        TFunction<void(UCustomMovementComponent&)> Run;
+        FClimbPerfSamples Times;
+        uint64 Cycles = 0;
+        uint64 Traces = 0;
+        int32 NumCalls = 0;
+        FClimbAllocationCounter AllocationCounter;
+        int32 NumCountedCalls = 0;
+
+        void Measure(TConstArrayView<AClimbingSystemCharacter*> Climbers)
+        {
+            uint64 FrameCycles = 0;
+            for(const AClimbingSystemCharacter* Climber : Climbers)
+            {
+                UCustomMovementComponent& Movement = *Climber->GetCustomeMovementComponent();
+                const uint64 TracesBefore = Movement.GetClimbTracesIssued();
+                const uint64 StartCycles = FPlatformTime::Cycles64();
+                Run(Movement);
+                FrameCycles += FPlatformTime::Cycles64() - StartCycles;
+                Traces += Movement.GetClimbTracesIssued() - TracesBefore;
+                ++NumCalls;
+            }
+            Times.AddCycles(FrameCycles);
+            Cycles += FrameCycles;
+
+            // Once more to count what it allocates, the checks leave nothing behind that a second call would see
+            if(!FClimbAllocationCounter::IsAvailable()) return;
+            for(const AClimbingSystemCharacter* Climber : Climbers)
+            {
+                AllocationCounter.Start();
+                Run(*Climber->GetCustomeMovementComponent());
+                AllocationCounter.Stop();
+                ++NumCountedCalls;
+            }
+        }
+
+        FString ToString(int32 NumClimbers) const
+        {
+            return FString::Printf(TEXT("%s for %d climbers: %s, %.2f traces per call"), Name, NumClimbers, *Times.ToString(),
+                static_cast<double>(Traces) / FMath::Max(NumCalls, 1));
+        }
+
+        FClimbOperationResult GetResult() const
+        {
+            FClimbOperationResult Result;
+            Result.Name = Name;
+            Result.NumOps = NumCalls;
+            Result.Cycles = Cycles;
+            Result.Traces = Traces;
+            Result.Allocations = NumCountedCalls > 0 ? static_cast<int64>(AllocationCounter.GetNumAllocations()) : INDEX_NONE;
+            Result.NumCountedOps = NumCountedCalls;
+            return Result;
+        }
+    };
+
+    // Times one direct call, counting its allocations too when given a counter
+    uint64 TimeClimbCall(FClimbAllocationCounter* Counter, TFunctionRef<void()> Call)
+    {
+        if(Counter)
+        {
+            Counter->Start();
+        }
+        const uint64 StartCycles = FPlatformTime::Cycles64();
+        Call();
+        const uint64 Cycles = FPlatformTime::Cycles64() - StartCycles;
+        if(Counter)
+        {
+            Counter->Stop();
+        }
+        return Cycles;
+    }
+
+    /**
+     * Run a scripted sequence on one climber NumRuns times timed, then NumRuns times counting its allocations. Reset puts the climber
+     * back before every run and is neither timed nor counted. Sequence returns the cycles it spent, direct calls through TimeClimbCall
+     * with the counter it is given and ticks from the movement component's own tick time, the counter only covers the climber's tick.
+     */
+    FClimbOperationResult MeasureClimbSequence(const TCHAR* Name, AClimbingSystemCharacter& Climber, int32 NumRuns, TFunctionRef<void()> Reset,
+        TFunctionRef<uint64(FClimbAllocationCounter* Counter)> Sequence)
+    {
+        FClimbOperationResult Result;
+        Result.Name = Name;
+        const UCustomMovementComponent& Movement = *Climber.GetCustomeMovementComponent();
+
+        for(int32 Run = 0; Run < NumRuns; ++Run)
+        {
+            Reset();
+            const uint64 TracesBefore = Movement.GetClimbTracesIssued();
+            Result.Cycles += Sequence(nullptr);
+            Result.Traces += Movement.GetClimbTracesIssued() - TracesBefore;
+            ++Result.NumOps;
+        }
+
+        if(!FClimbAllocationCounter::IsAvailable()) return Result;
+
+        FClimbAllocationCounter CallCounter;
+        FClimbTickAllocationCounter TickCounter(Climber);
+        for(int32 Run = 0; Run < NumRuns; ++Run)
+        {
+            TickCounter.SetEnabled(false);
+            Reset();
+            TickCounter.SetEnabled(true);
+            Sequence(&CallCounter);
+            ++Result.NumCountedOps;
+        }
+        Result.Allocations = static_cast<int64>(CallCounter.GetNumAllocations() + TickCounter.GetNumAllocations());
+
+        return Result;
+    }
+
+    /* Write ns, traces and allocations per op of every operation under Saved/Profiling/ClimbPerf, so runs can be diffed across commits */
+    FString WriteClimbOperationsReport(TConstArrayView<FClimbOperationResult> Results, int32 NumClimbers)
+    {
+        FString Json;
+        TSharedRef<TJsonWriter<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&Json);
+        Writer->WriteObjectStart();
+        Writer->WriteValue(TEXT("climbers"), NumClimbers);
+        Writer->WriteArrayStart(TEXT("operations"));
+        for(const FClimbOperationResult& Result : Results)
+        {
+            const double NumOps = FMath::Max(Result.NumOps, 1);
+
+            Writer->WriteObjectStart();
+            Writer->WriteValue(TEXT("name"), Result.Name);
+            Writer->WriteValue(TEXT("ops"), Result.NumOps);
+            Writer->WriteValue(TEXT("ns_op"), FPlatformTime::ToSeconds64(Result.Cycles) * 1e9 / NumOps);
+            Writer->WriteValue(TEXT("traces_op"), Result.Traces / NumOps);
+            if(Result.Allocations == INDEX_NONE)
+            {
+                Writer->WriteNull(TEXT("allocs_op"));
+            }
+            else
+            {
+                Writer->WriteValue(TEXT("allocs_op"), static_cast<double>(Result.Allocations) / FMath::Max(Result.NumCountedOps, 1));
+            }
+            Writer->WriteObjectEnd();
+        }
+        Writer->WriteArrayEnd();
+        Writer->WriteObjectEnd();
+        Writer->Close();
+
+        const FString FileName = FPaths::ProfilingDir() / TEXT("ClimbPerf") / FString::Printf(TEXT("ClimbOperations-%s.json"), *FDateTime::Now().ToString());
+        return FFileHelper::SaveStringToFile(Json, *FileName) ? FileName : FString();
+    }
+
+    /* Growth of the Climbing LLM tag across a run, or a note on how to get it */
+    FString DescribeClimbingMemory(int64 BytesBefore, int64 BytesAfter)
+    {
+        if(BytesBefore == INDEX_NONE || BytesAfter == INDEX_NONE)
+        {
+            return TEXT("Climbing LLM tag not tracked, run with -llm to get it");
+        }
+        return FString::Printf(TEXT("Climbing LLM tag grew %lld bytes, %lld held"), BytesAfter - BytesBefore, BytesAfter);
+    }
+
+    /* Fraction of the synthetic contacts that are the back side of thin geometry */
+    constexpr float ReduceBackFaceChance = 0.125f;
+
+    // Climbers facing a wall at random spots, their contacts as hit results for the per climber path and packed into a batch for the kernel
+    void MakeReduceClimbers(int32 NumClimbers, int32 ContactsPerClimber, FRandomStream& Random, TArray<TArray<FHitResult>>& OutHits, FClimbSolveBatch& OutBatch)
+    {
+        OutHits.Reset();
+        OutHits.SetNum(NumClimbers);
+        OutBatch.Reset();
+        OutBatch.Outputs.SetNum(NumClimbers);
+
+        for(int32 Climber = 0; Climber < NumClimbers; ++Climber)
+        {
+            FClimbSolveInput& Input = OutBatch.Inputs.AddDefaulted_GetRef();
+            Input.Location = Random.GetPointInBoundingBox(FVector::ZeroVector, FVector(10000.f));
+            Input.Rotation = FRotator(0.f, Random.FRandRange(-180.f, 180.f), 0.f).Quaternion();
+            Input.ContactStart = OutBatch.ContactPoints.Num();
+            Input.ContactNum = ContactsPerClimber;
+
+            const FVector Forward = Input.Rotation.GetForwardVector();
+            for(int32 Contact = 0; Contact < ContactsPerClimber; ++Contact)
+            {
+                FVector Normal = (-Forward + Random.GetUnitVector() * 0.3f).GetSafeNormal();
+                if(Random.FRand() < ReduceBackFaceChance)
+                {
+                    Normal = -Normal;
+                }
+
+                FHitResult& Hit = OutHits[Climber].AddDefaulted_GetRef();
+                Hit.ImpactPoint = Input.Location + Forward * 40.f + Random.GetUnitVector() * 30.f;
+                Hit.ImpactNormal = Normal;
+
+                OutBatch.ContactPoints.Add(Hit.ImpactPoint);
+                OutBatch.ContactNormals.Add(Hit.ImpactNormal);
+                OutBatch.ContactGrips.Add(1.f);
+            }
+        }
+    }
+
+    /* A row of climbers on the test wall, spaced so they never touch */
+    void SpawnClimberRow(FClimbTestWorld& TestWorld, int32 NumClimbers, TArray<AClimbingSystemCharacter*>& OutClimbers)
+    {
+        for(int32 Index = 0; Index < NumClimbers; ++Index)
+        {
+            if(AClimbingSystemCharacter* Climber = TestWorld.SpawnClimber(-800.f + 1600.f * Index / FMath::Max(NumClimbers - 1, 1), 300.f))
+            {
+                OutClimbers.Add(Climber);
+            }
+        }
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbableChannelSweepPerfTest, "ClimbingSystem.Perf.ClimbableChannelSweep",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+// Object type sweeps against the Climbable channel on a wall covered in decoration that climbing ignores.
+// Chaos does not hand out the broadphase candidates of a query, so the hits the sweeps return stand in for them: with object types every
+// decoration box is a hit, on the channel it is filtered out. That shows less work reaching narrowphase and the caller, not a smaller candidate set
+bool FClimbableChannelSweepPerfTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 NumClimbers = 16;
+
+    FClimbPerfRun Runs[2];
+    for(const bool bTraceClimbableChannel : {false, true})
+    {
+        FClimbTestWorld TestWorld;
+        TestWorld.SpawnTestWall();
+        for(int32 Index = 0; Index < 20; ++Index)
+        {
+            TestWorld.SpawnDecoration(FVector(FClimbTestWorld::WallFaceX - 10.f, -950.f + Index * 100.f, FClimbTestWorld::WallHeight * 0.5f),
+                FVector(20.f, 30.f, FClimbTestWorld::WallHeight * 0.5f));
+        }
+
+        TArray<AClimbingSystemCharacter*> Climbers;
+        SpawnClimberRow(TestWorld, NumClimbers, Climbers);
+        for(AClimbingSystemCharacter* Climber : Climbers)
+        {
+            FClimbTestAccess::SetTraceClimbableChannel(*Climber->GetCustomeMovementComponent(), bTraceClimbableChannel);
+        }
+
+        Runs[bTraceClimbableChannel] = RunClimbPerfScript(TestWorld, Climbers);
+    }
+
+    AddInfo(FString::Printf(TEXT("%d climbers, object types: %s"), NumClimbers, *Runs[0].ToString()));
+    AddInfo(FString::Printf(TEXT("%d climbers, Climbable channel: %s"), NumClimbers, *Runs[1].ToString()));
+    AddInfo(TEXT("Hits stand in for broadphase candidates, which are not exposed per query"));
+
+    TestTrue(TEXT("Climbable channel returns fewer hits than the object types"), Runs[1].TraceHits < Runs[0].TraceHits);
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbCrowdPerfTest, "ClimbingSystem.Perf.CrowdVersusCharacters",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+// The same number of climbers on the same wall as full characters and as crowd entities, 500 of each unless -ClimbCrowdPerfClimbers= says otherwise
+bool FClimbCrowdPerfTest::RunTest(const FString& Parameters)
+{
+    int32 NumClimbers = 500;
+    FParse::Value(FCommandLine::Get(), TEXT("ClimbCrowdPerfClimbers="), NumClimbers);
+    NumClimbers = FMath::Max(NumClimbers, 1);
+
+    constexpr float StartZ = 200.f;
+    const int32 NumFrames = FClimbTestWorld::GetNumScriptFrames(FClimbTestWorld::GetClimbScript());
+
+    // One row a meter apart on a wall as long as it needs, the test wall only fits a few dozen characters
+    constexpr float ClimberSpacing = 100.f;
+    const float RowHalfWidth = 0.5f * ClimberSpacing * (NumClimbers - 1);
+    const auto SpawnCrowdWall = [RowHalfWidth](FClimbTestWorld& TestWorld)
+    {
+        const FVector HalfExtent(100.f, RowHalfWidth + 200.f, FClimbTestWorld::WallHeight * 0.5f);
+        TestWorld.SpawnWall(FVector(FClimbTestWorld::WallFaceX + HalfExtent.X, 0.f, HalfExtent.Z), HalfExtent);
+    };
+
+    FClimbPerfRun CharacterRun;
+    {
+        FClimbTestWorld TestWorld;
+        SpawnCrowdWall(TestWorld);
+
+        TArray<AClimbingSystemCharacter*> Climbers;
+        for(int32 Index = 0; Index < NumClimbers; ++Index)
+        {
+            if(AClimbingSystemCharacter* Climber = TestWorld.SpawnClimber(-RowHalfWidth + ClimberSpacing * Index, 300.f))
+            {
+                Climbers.Add(Climber);
+            }
+        }
+        if(!TestEqual(TEXT("Characters spawned"), Climbers.Num(), NumClimbers)) return false;
+        CharacterRun = RunClimbPerfScript(TestWorld, Climbers);
+    }
+
+    FClimbPerfSamples CrowdTimes;
+    int32 NumCrowdSurvivors = 0;
+    float LowestCrowdZ = TNumericLimits<float>::Max();
+    {
+        FClimbTestWorld TestWorld;
+        SpawnCrowdWall(TestWorld);
+
+        UMassEntitySubsystem* EntitySubsystem = TestWorld.GetWorld()->GetSubsystem<UMassEntitySubsystem>();
+        if(!TestNotNull(TEXT("Mass entity subsystem"), EntitySubsystem)) return false;
+        FMassEntityManager& EntityManager = EntitySubsystem->GetMutableEntityManager();
+
+        // What UClimbingCrowdTrait builds, put together by hand since there is no spawner here
+        FMassArchetypeCompositionDescriptor Composition;
+        Composition.Fragments.Add<FTransformFragment>();
+        Composition.Fragments.Add<FClimbSurfaceNormalFragment>();
+        Composition.Fragments.Add<FClimbSurfacePointFragment>();
+        Composition.Fragments.Add<FClimbVelocityFragment>();
+        Composition.Fragments.Add<FClimbProbeFragment>();
+        Composition.Tags.Add<FClimbingCrowdTag>();
+        Composition.ConstSharedFragments.Add<FClimbCrowdParameters>();
+        const FMassArchetypeHandle Archetype = EntityManager.CreateArchetype(Composition, TEXT("ClimbCrowdPerf"));
+
+        // No profile set, so the crowd climbs with the same profile defaults as the characters
+        FClimbCrowdParameters CrowdParameters;
+        CrowdParameters.ClimableSurfaceTraceTypes.Add(UEngineTypes::ConvertToObjectType(ECC_WorldStatic));
+        FMassArchetypeSharedFragmentValues SharedValues;
+        SharedValues.AddConstSharedFragment(EntityManager.GetOrCreateConstSharedFragment(CrowdParameters));
+        SharedValues.Sort();
+
+        TArray<FMassEntityHandle> Entities;
+        EntityManager.BatchCreateEntities(Archetype, SharedValues, NumClimbers, Entities);
+        for(int32 Index = 0; Index < Entities.Num(); ++Index)
+        {
+            const FVector Location(FClimbTestWorld::WallFaceX - 42.f, -RowHalfWidth + ClimberSpacing * Index, StartZ);
+            EntityManager.GetFragmentDataChecked<FTransformFragment>(Entities[Index]).SetTransform(FTransform(Location));
+            EntityManager.GetFragmentDataChecked<FClimbVelocityFragment>(Entities[Index]).SurfaceVelocity = FVector2f(0.f, 100.f);
+        }
+
+        // Run by hand so only the processor is timed, the world tick in between completes its async sweeps
+        UClimbingCrowdProcessor* Processor = NewObject<UClimbingCrowdProcessor>(TestWorld.GetWorld());
+        Processor->Initialize(*TestWorld.GetWorld());
+        for(int32 Frame = 0; Frame < NumFrames; ++Frame)
+        {
+            TestWorld.Tick();
+
+            FMassProcessingContext ProcessingContext(EntityManager, FClimbTestWorld::DeltaTime);
+            const uint64 StartCycles = FPlatformTime::Cycles64();
+            UE::Mass::Executor::Run(*Processor, ProcessingContext);
+            CrowdTimes.AddCycles(FPlatformTime::Cycles64() - StartCycles);
+        }
+
+        for(const FMassEntityHandle Entity : Entities)
+        {
+            if(!EntityManager.IsEntityValid(Entity)) continue;
+            ++NumCrowdSurvivors;
+            LowestCrowdZ = FMath::Min(LowestCrowdZ, static_cast<float>(EntityManager.GetFragmentDataChecked<FTransformFragment>(Entity).GetTransform().GetLocation().Z));
+        }
+    }
+
+    AddInfo(FString::Printf(TEXT("%d characters: %s"), NumClimbers, *CharacterRun.ToString()));
+    AddInfo(FString::Printf(TEXT("%d crowd entities: %s"), NumClimbers, *CrowdTimes.ToString()));
+
+    TestEqual(TEXT("Every crowd entity stays on the wall"), NumCrowdSurvivors, NumClimbers);
+    TestTrue(TEXT("Crowd entities climbed"), LowestCrowdZ > StartZ + 100.f);
+    TestTrue(TEXT("Crowd entities cost less per frame than characters"), CrowdTimes.GetPercentile(0.5f) < CharacterRun.TickTimes.GetPercentile(0.5f));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbBatchedSimulationPerfTest, "ClimbingSystem.Perf.BatchedSimulation",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+// The same climbers and script solved one at a time and in the world's batch capped at 1 to 16 workers, timing whole frames since the batch runs outside the climbers' ticks
+bool FClimbBatchedSimulationPerfTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 NumClimbers = 64;
+    constexpr int32 WorkerCounts[] = {1, 2, 4, 8, 16};
+
+    IConsoleVariable* MaxWorkersVariable = IConsoleManager::Get().FindConsoleVariable(TEXT("Climbing.Simulation.MaxWorkers"));
+    if(!TestNotNull(TEXT("Climbing.Simulation.MaxWorkers"), MaxWorkersVariable)) return false;
+    const int32 PreviousMaxWorkers = MaxWorkersVariable->GetInt();
+
+    // Run 0 is one at a time, run N the batch capped at WorkerCounts[N - 1]
+    constexpr int32 NumRuns = UE_ARRAY_COUNT(WorkerCounts) + 1;
+    FClimbPerfSamples FrameTimes[NumRuns];
+    FClimbPerfSamples SerialTimes[NumRuns];
+    FClimbPerfSamples ParallelTimes[NumRuns];
+    TArray<FVector> EndLocations[NumRuns];
+    for(int32 Run = 0; Run < NumRuns; ++Run)
+    {
+        const bool bBatched = Run > 0;
+        if(bBatched)
+        {
+            MaxWorkersVariable->Set(WorkerCounts[Run - 1], ECVF_SetByCode);
+        }
+
+        FClimbTestWorld TestWorld;
+        TestWorld.SpawnTestWall();
+        const UClimbingSimulationSubsystem* Simulation = TestWorld.GetWorld()->GetSubsystem<UClimbingSimulationSubsystem>();
+        if(!TestNotNull(TEXT("Climbing simulation subsystem"), Simulation))
+        {
+            MaxWorkersVariable->Set(PreviousMaxWorkers, ECVF_SetByCode);
+            return false;
+        }
+
+        TArray<AClimbingSystemCharacter*> Climbers;
+        for(int32 Index = 0; Index < NumClimbers; ++Index)
+        {
+            if(AClimbingSystemCharacter* Climber = TestWorld.SpawnClimber(-800.f + 1600.f * Index / (NumClimbers - 1), 300.f, false))
+            {
+                FClimbTestAccess::SetUseBatchedClimbSimulation(*Climber->GetCustomeMovementComponent(), bBatched);
+                Climber->GetCustomeMovementComponent()->ForceStartClimbing();
+                Climbers.Add(Climber);
+            }
+        }
+
+        uint64 LastCycles = FPlatformTime::Cycles64();
+        TestWorld.RunScript(Climbers, FClimbTestWorld::GetClimbScript(), [&](int32 Frame)
+        {
+            const uint64 NowCycles = FPlatformTime::Cycles64();
+            FrameTimes[Run].AddCycles(NowCycles - LastCycles);
+            LastCycles = NowCycles;
+
+            if(bBatched)
+            {
+                SerialTimes[Run].AddCycles(Simulation->GetLastSerialCycles());
+                ParallelTimes[Run].AddCycles(Simulation->GetLastParallelCycles());
+            }
+        });
+
+        for(const AClimbingSystemCharacter* Climber : Climbers)
+        {
+            EndLocations[Run].Add(Climber->GetActorLocation());
+        }
+    }
+    MaxWorkersVariable->Set(PreviousMaxWorkers, ECVF_SetByCode);
+
+    // Caps past the task graph's workers run the same as the biggest one it has
+    AddInfo(FString::Printf(TEXT("%d climbers, %d task graph workers"), NumClimbers, FTaskGraphInterface::Get().GetNumWorkerThreads()));
+    AddInfo(FString::Printf(TEXT("One at a time: %s"), *FrameTimes[0].ToString()));
+    for(int32 Run = 1; Run < NumRuns; ++Run)
+    {
+        const double SerialUs = SerialTimes[Run].GetPercentile(0.5f);
+        const double ParallelUs = ParallelTimes[Run].GetPercentile(0.5f);
+        AddInfo(FString::Printf(TEXT("Batched, %d workers: %s, median batch %.1f us serial + %.1f us parallel (%.0f%% parallel)"),
+            WorkerCounts[Run - 1], *FrameTimes[Run].ToString(), SerialUs, ParallelUs, 100.0 * ParallelUs / FMath::Max(SerialUs + ParallelUs, UE_DOUBLE_SMALL_NUMBER)));
+    }
+
+    // Every path runs the same rules, so they have to end up in the same place
+    for(int32 Run = 1; Run < NumRuns; ++Run)
+    {
+        if(!TestEqual(FString::Printf(TEXT("Climbers in the %d worker run"), WorkerCounts[Run - 1]), EndLocations[Run].Num(), EndLocations[0].Num())) return false;
+        float WorstDivergence = 0.f;
+        for(int32 Index = 0; Index < EndLocations[0].Num(); ++Index)
+        {
+            WorstDivergence = FMath::Max(WorstDivergence, static_cast<float>(FVector::Dist(EndLocations[0][Index], EndLocations[Run][Index])));
+        }
+        TestTrue(FString::Printf(TEXT("Batched climbers on %d workers end within 2 cm of the serial ones, worst %.3f cm"), WorkerCounts[Run - 1], WorstDivergence), WorstDivergence <= 2.f);
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbOperationsPerfTest, "ClimbingSystem.Perf.ClimbOperations",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+// What each climb operation costs on the generated wall: the checks once per climber per frame through the climb script, the climb tick,
+// and vault, ledge-up and climb-down sequences from their request to the tick acting on it. The native climbers have no montages,
+// so the sequences cost their traces and decisions, not the animation. Written to Saved/Profiling/ClimbPerf as ns, traces and allocations per op
+bool FClimbOperationsPerfTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 NumClimbers = 16;
+    constexpr int32 NumSequenceRuns = 50;
+
+    if(!FClimbAllocationCounter::IsAvailable())
+    {
+        AddWarning(TEXT("Allocations cannot be counted on this platform, allocs_op is left out of the report"));
+    }
+
+    TArray<FClimbOperationResult> Results;
+
+    // Hop checks while climbing, one call each per frame next to the tick that already ran the climber's probes
+    {
+        FClimbTestWorld TestWorld;
+        TestWorld.SpawnTestWall();
+
+        TArray<AClimbingSystemCharacter*> Climbers;
+        SpawnClimberRow(TestWorld, NumClimbers, Climbers);
+
+        // With the native climbers' empty montages a hop request is its input check and the hop check it picks
+        FClimbOperationTiming Operations[] =
+        {
+            {TEXT("CheckCanHopUp"), [](UCustomMovementComponent& Movement) { FVector HopTarget; FClimbTestAccess::CheckCanHopUp(Movement, HopTarget); }},
+            {TEXT("CheckCanHopDown"), [](UCustomMovementComponent& Movement) { FVector HopTarget; FClimbTestAccess::CheckCanHopDown(Movement, HopTarget); }},
+            {TEXT("RequestHopping"), [](UCustomMovementComponent& Movement) { Movement.RequestHopping(); }}
+        };
+
+        FClimbPerfSamples TickTimes;
+        const int64 BytesBefore = FClimbTestWorld::GetClimbingTrackedBytes();
+        TestWorld.RunScript(Climbers, FClimbTestWorld::GetClimbScript(), [&](int32 Frame)
+        {
+            uint64 FrameCycles = 0;
+            for(const AClimbingSystemCharacter* Climber : Climbers)
+            {
+                FrameCycles += Climber->GetCustomeMovementComponent()->GetLastTickCycles();
+            }
+            TickTimes.AddCycles(FrameCycles);
+
+            for(FClimbOperationTiming& Operation : Operations)
+            {
+                Operation.Measure(Climbers);
+            }
+        });
+        const int64 BytesAfter = FClimbTestWorld::GetClimbingTrackedBytes();
+
+        AddInfo(FString::Printf(TEXT("Climb tick for %d climbers: %s"), NumClimbers, *TickTimes.ToString()));
+        for(const FClimbOperationTiming& Operation : Operations)
+        {
+            AddInfo(Operation.ToString(NumClimbers));
+            Results.Add(Operation.GetResult());
+        }
+        AddInfo(DescribeClimbingMemory(BytesBefore, BytesAfter));
+
+        for(const AClimbingSystemCharacter* Climber : Climbers)
+        {
+            TestTrue(TEXT("Climber still climbing after the script"), Climber->GetCustomeMovementComponent()->IsClimbing());
+        }
+    }
+
+    // The climb tick through the climb script, one climber alone so the counting window holds only its ticks
+    {
+        FClimbTestWorld TestWorld;
+        TestWorld.SpawnTestWall();
+
+        AClimbingSystemCharacter* Climber = TestWorld.SpawnClimber(0.f, 300.f);
+        if(!TestNotNull(TEXT("Climber"), Climber)) return false;
+        const UCustomMovementComponent& Movement = *Climber->GetCustomeMovementComponent();
+        AClimbingSystemCharacter* const Climbers[] = {Climber};
+
+        FClimbOperationResult& Result = Results.AddDefaulted_GetRef();
+        Result.Name = TEXT("ClimbTick");
+        const uint64 TracesBefore = Movement.GetClimbTracesIssued();
+        TestWorld.RunScript(Climbers, FClimbTestWorld::GetClimbScript(), [&](int32 Frame)
+        {
+            Result.Cycles += Movement.GetLastTickCycles();
+            ++Result.NumOps;
+        });
+        Result.Traces = Movement.GetClimbTracesIssued() - TracesBefore;
+
+        if(FClimbAllocationCounter::IsAvailable())
+        {
+            // Back where it started, the climb script ends lower than it starts
+            Climber->TeleportTo(FVector(FClimbTestWorld::WallFaceX - 42.f, 0.f, 300.f), FRotator::ZeroRotator, false, true);
+            FClimbTickAllocationCounter Counter(*Climber);
+            TestWorld.RunScript(Climbers, FClimbTestWorld::GetClimbScript(), [](int32 Frame) {});
+            Result.Allocations = static_cast<int64>(Counter.GetNumAllocations());
+            Result.NumCountedOps = Counter.GetNumTicks();
+        }
+    }
+
+    // Ledge-up: climbing the last stretch of the wall until the ledge is reached, the tick that reaches it would start the climb to top
+    {
+        FClimbTestWorld TestWorld;
+        TestWorld.SpawnTestWall();
+
+        AClimbingSystemCharacter* Climber = TestWorld.SpawnClimber(0.f, FClimbTestWorld::WallHeight - 150.f);
+        if(!TestNotNull(TEXT("Climber"), Climber)) return false;
+        UCustomMovementComponent& Movement = *Climber->GetCustomeMovementComponent();
+
+        FClimbSessionFrame ClimbUp;
+        ClimbUp.ClimbMoveInput = FVector2f(0.f, 1.f);
+
+        // Every run, the counted ones included
+        const int32 NumRuns = (FClimbAllocationCounter::IsAvailable() ? 2 : 1) * NumSequenceRuns;
+        int32 NumLedgesReached = 0;
+        Results.Add(MeasureClimbSequence(TEXT("LedgeUp"), *Climber, NumSequenceRuns, [&]()
+        {
+            Climber->TeleportTo(FVector(FClimbTestWorld::WallFaceX - 42.f, 0.f, FClimbTestWorld::WallHeight - 150.f), FRotator::ZeroRotator, false, true);
+            Movement.ForceStartClimbing();
+            TestWorld.Tick(2);
+        },
+        [&](FClimbAllocationCounter* Counter)
+        {
+            uint64 Cycles = 0;
+            for(int32 Frame = 0; Frame < 300; ++Frame)
+            {
+                Climber->ApplyClimbSessionInput(ClimbUp);
+                TestWorld.Tick();
+                Cycles += Movement.GetLastTickCycles();
+                if(FClimbTestAccess::CheckHasReachedLedge(Movement))
+                {
+                    ++NumLedgesReached;
+                    break;
+                }
+            }
+            return Cycles;
+        }));
+        TestEqual(TEXT("Ledge-up runs that reached the ledge"), NumLedgesReached, NumRuns);
+    }
+
+    // Vault and climb-down: a climb request standing in front of a low box and on top of the wall facing its edge, the request
+    // submits the obstacle scan and the next tick reads it back and acts on it
+    {
+        FClimbTestWorld TestWorld;
+        TestWorld.SpawnTestWall();
+        TestWorld.SpawnWall(FVector(FClimbTestWorld::WallFaceX - 500.f, 0.f, -50.f), FVector(500.f, 1000.f, 50.f));
+        TestWorld.SpawnWall(FVector(-300.f, 0.f, 50.f), FVector(30.f, 200.f, 50.f));
+
+        AClimbingSystemCharacter* Climber = TestWorld.SpawnClimber(0.f, 100.f, false);
+        if(!TestNotNull(TEXT("Climber"), Climber)) return false;
+        UCustomMovementComponent& Movement = *Climber->GetCustomeMovementComponent();
+
+        const auto RequestAndTick = [&](FClimbAllocationCounter* Counter)
+        {
+            const uint64 Cycles = TimeClimbCall(Counter, [&Movement]() { Movement.ToggleClimbing(true); });
+            TestWorld.Tick();
+            return Cycles + Movement.GetLastTickCycles();
+        };
+
+        struct FTraversalSequence
+        {
+            const TCHAR* Name;
+            FVector Location;
+            FRotator Rotation;
+            EClimbObstacleAction ExpectedAction;
+        };
+        const FTraversalSequence Sequences[] =
+        {
+            {TEXT("Vault"), FVector(-390.f, 0.f, 100.f), FRotator::ZeroRotator, EClimbObstacleAction::Vault},
+            {TEXT("ClimbDown"), FVector(FClimbTestWorld::WallFaceX + 120.f, 0.f, FClimbTestWorld::WallHeight + 100.f), FRotator(0.f, 180.f, 0.f), EClimbObstacleAction::ClimbDown}
+        };
+        for(const FTraversalSequence& Sequence : Sequences)
+        {
+            const auto Reset = [&]()
+            {
+                Climber->TeleportTo(Sequence.Location, Sequence.Rotation, false, true);
+                Movement.SetMovementMode(MOVE_Walking);
+                Movement.StopMovementImmediately();
+                TestWorld.Tick(10);
+            };
+
+            // The timings only mean something if the scan sees what the sequence is named after
+            Reset();
+            FClimbObstacleProfile Obstacle;
+            FClimbTestAccess::ScanObstacleProfile(Movement, Obstacle);
+            TestTrue(FString::Printf(TEXT("%s sequence faces an obstacle to %s"), Sequence.Name, Sequence.Name),
+                ClimbMath::ChooseObstacleAction(Obstacle, Movement.GetClimbProfile()->GetConstants().ObstacleRules) == Sequence.ExpectedAction);
+
+            Results.Add(MeasureClimbSequence(Sequence.Name, *Climber, NumSequenceRuns, Reset, RequestAndTick));
+        }
+    }
+
+    // Climb entry checks from the floor in front of the wall, everything ToggleClimbing does short of a montage
+    {
+        FClimbTestWorld TestWorld;
+        TestWorld.SpawnTestWall();
+        TestWorld.SpawnWall(FVector(FClimbTestWorld::WallFaceX - 500.f, 0.f, -50.f), FVector(500.f, 1000.f, 50.f));
+
+        TArray<AClimbingSystemCharacter*> Climbers;
+        for(int32 Index = 0; Index < NumClimbers; ++Index)
+        {
+            if(AClimbingSystemCharacter* Climber = TestWorld.SpawnClimber(-800.f + 1600.f * Index / (NumClimbers - 1), 100.f, false))
+            {
+                Climbers.Add(Climber);
+            }
+        }
+
+        FClimbOperationTiming Operations[] =
+        {
+            {TEXT("CanStartClimbing"), [](UCustomMovementComponent& Movement) { FClimbTestAccess::CanStartClimbing(Movement); }},
+            {TEXT("ChooseObstacleAction"), [](UCustomMovementComponent& Movement)
+            {
+                FClimbObstacleProfile Obstacle;
+                FClimbTestAccess::ScanObstacleProfile(Movement, Obstacle);
+                ClimbMath::ChooseObstacleAction(Obstacle, Movement.GetClimbProfile()->GetConstants().ObstacleRules);
+            }}
+        };
+
+        // Let them land before anything is timed
+        TestWorld.Tick(30);
+
+        const int32 NumFrames = FClimbTestWorld::GetNumScriptFrames(FClimbTestWorld::GetClimbScript());
+        const int64 BytesBefore = FClimbTestWorld::GetClimbingTrackedBytes();
+        for(int32 Frame = 0; Frame < NumFrames; ++Frame)
+        {
+            TestWorld.Tick();
+            for(FClimbOperationTiming& Operation : Operations)
+            {
+                Operation.Measure(Climbers);
+            }
+        }
+        const int64 BytesAfter = FClimbTestWorld::GetClimbingTrackedBytes();
+
+        for(const FClimbOperationTiming& Operation : Operations)
+        {
+            AddInfo(Operation.ToString(NumClimbers));
+            Results.Add(Operation.GetResult());
+        }
+        AddInfo(DescribeClimbingMemory(BytesBefore, BytesAfter));
+    }
+
+    for(const FClimbOperationResult& Result : Results)
+    {
+        const double NumOps = FMath::Max(Result.NumOps, 1);
+        const FString Allocations = Result.Allocations == INDEX_NONE ? FString(TEXT("uncounted"))
+            : FString::Printf(TEXT("%.2f"), static_cast<double>(Result.Allocations) / FMath::Max(Result.NumCountedOps, 1));
+        AddInfo(FString::Printf(TEXT("%s: %.0f ns, %.2f traces, %s allocations per op"), *Result.Name,
+            FPlatformTime::ToSeconds64(Result.Cycles) * 1e9 / NumOps, Result.Traces / NumOps, *Allocations));
+    }
+
+    const FString ReportFile = WriteClimbOperationsReport(Results, NumClimbers);
+    if(TestFalse(TEXT("Climb operations report written"), ReportFile.IsEmpty()))
+    {
+        AddInfo(FString::Printf(TEXT("Climb operations report in %s"), *ReportFile));
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbReduceSurfacesPerfTest, "ClimbingSystem.Perf.ReduceSurfaces",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+// The per climber surface reduction against the batched kernel, both on this thread, on synthetic climbers at a few crowd sizes
+bool FClimbReduceSurfacesPerfTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 Iterations = 100;
+    constexpr int32 ContactsPerClimber = 8;
+    // The odd count leaves the kernel a partly filled last group of lanes
+    const int32 ClimberCounts[] = { 64, 256, 1024, 1023 };
+
+    FRandomStream Random(0x436C696D);
+    TArray<TArray<FHitResult>> Hits;
+    FClimbSolveBatch Batch;
+    TArray<FVector> ScalarLocations;
+    TArray<FVector> ScalarNormals;
+    for(const int32 NumClimbers : ClimberCounts)
+    {
+        MakeReduceClimbers(NumClimbers, ContactsPerClimber, Random, Hits, Batch);
+        ScalarLocations.SetNum(NumClimbers);
+        ScalarNormals.SetNum(NumClimbers);
+
+        // Per climber, the way ProcessClimbableSurfaceInfo reduces its own sweep
+        const uint64 ScalarStart = FPlatformTime::Cycles64();
+        for(int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+        {
+            for(int32 Climber = 0; Climber < NumClimbers; ++Climber)
+            {
+                const FClimbSolveInput& Input = Batch.Inputs[Climber];
+                ClimbMath::ReduceClimbableSurface(Hits[Climber], {}, Input.Location, Input.Rotation.GetForwardVector(), ScalarLocations[Climber], ScalarNormals[Climber]);
+            }
+        }
+        const uint64 ScalarCycles = FPlatformTime::Cycles64() - ScalarStart;
+
+        const uint64 BatchStart = FPlatformTime::Cycles64();
+        for(int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+        {
+            ClimbMath::ReduceClimbableSurfaces(Batch, 0, NumClimbers, Batch.Outputs);
+        }
+        const uint64 BatchCycles = FPlatformTime::Cycles64() - BatchStart;
+
+        // Both paths must agree, or the timings mean nothing
+        double MaxLocationError = 0.0;
+        double MaxNormalError = 0.0;
+        for(int32 Climber = 0; Climber < NumClimbers; ++Climber)
+        {
+            MaxLocationError = FMath::Max(MaxLocationError, (Batch.Outputs[Climber].SurfaceLocation - ScalarLocations[Climber]).GetAbsMax());
+            MaxNormalError = FMath::Max(MaxNormalError, (Batch.Outputs[Climber].SurfaceNormal - ScalarNormals[Climber]).GetAbsMax());
+        }
+
+        const double NumReductions = static_cast<double>(Iterations) * NumClimbers;
+        const double ScalarNs = FPlatformTime::ToSeconds64(ScalarCycles) * 1e9 / NumReductions;
+        const double BatchNs = FPlatformTime::ToSeconds64(BatchCycles) * 1e9 / NumReductions;
+        AddInfo(FString::Printf(TEXT("%d climbers with %d contacts: %.1f ns each one at a time, %.1f ns each batched, %.2fx"),
+            NumClimbers, ContactsPerClimber, ScalarNs, BatchNs, BatchNs > 0.0 ? ScalarNs / BatchNs : 0.0));
+
+        TestTrue(FString::Printf(TEXT("%d climbers: batched surface locations match, worst %g cm"), NumClimbers, MaxLocationError), MaxLocationError <= 1e-6);
+        TestTrue(FString::Printf(TEXT("%d climbers: batched surface normals match, worst %g"), NumClimbers, MaxNormalError), MaxNormalError <= 1e-6);
+    }
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbLODTierMixPerfTest, "ClimbingSystem.Perf.LODTierMix",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+// The climb script on a crowd of AI climbers split over the LOD tiers in different mixes, what the whole crowd costs in each
+bool FClimbLODTierMixPerfTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 NumClimbers = 64;
+    constexpr float ViewDistance = 3000.f;
+
+    // Percent Full, Reduced and SurfaceLocked
+    struct FTierMix
+    {
+        int32 FullPercent;
+        int32 ReducedPercent;
+    };
+    const FTierMix Mixes[] = {{100, 0}, {50, 25}, {25, 25}, {10, 20}, {0, 0}};
+
+    uint64 LastTracesIssued = TNumericLimits<uint64>::Max();
+    for(const FTierMix& Mix : Mixes)
+    {
+        FClimbTestWorld TestWorld;
+        TestWorld.SpawnTestWall();
+
+        USignificanceManager* SignificanceManager = USignificanceManager::Get(TestWorld.GetWorld());
+        if(!TestNotNull(TEXT("Significance manager"), SignificanceManager)) return false;
+
+        TArray<AClimbingSystemCharacter*> Climbers;
+        SpawnClimberRow(TestWorld, NumClimbers, Climbers);
+
+        // Everyone is about ViewDistance from the one viewpoint, the tier distances of each climber put it in its tier
+        const int32 NumFull = NumClimbers * Mix.FullPercent / 100;
+        const int32 NumReduced = NumClimbers * Mix.ReducedPercent / 100;
+        for(int32 Index = 0; Index < Climbers.Num(); ++Index)
+        {
+            UCustomMovementComponent* Movement = Climbers[Index]->GetCustomeMovementComponent();
+            FClimbTestAccess::EnableClimbLOD(*Movement, 0.f);
+            if(Index < NumFull)
+            {
+                FClimbTestAccess::SetClimbLODDistances(*Movement, ViewDistance * 3.f, ViewDistance * 6.f);
+            }
+            else if(Index < NumFull + NumReduced)
+            {
+                FClimbTestAccess::SetClimbLODDistances(*Movement, ViewDistance * 0.5f, ViewDistance * 3.f);
+            }
+            else
+            {
+                FClimbTestAccess::SetClimbLODDistances(*Movement, ViewDistance * 0.25f, ViewDistance * 0.5f);
+            }
+        }
+        SignificanceManager->Update(TArrayView<const FTransform>({FTransform(FVector(FClimbTestWorld::WallFaceX - ViewDistance, 0.f, 300.f))}));
+
+        int32 NumInTier[3] = {0, 0, 0};
+        for(const AClimbingSystemCharacter* Climber : Climbers)
+        {
+            const int32 Tier = static_cast<int32>(Climber->GetCustomeMovementComponent()->GetClimbLODTier());
+            NumInTier[FMath::Min(Tier, 2)] += 1;
+        }
+        const FString MixName = FString::Printf(TEXT("%d Full, %d Reduced, %d SurfaceLocked"), NumInTier[0], NumInTier[1], NumInTier[2]);
+        TestEqual(FString::Printf(TEXT("%s: Full climbers"), *MixName), NumInTier[0], NumFull);
+        TestEqual(FString::Printf(TEXT("%s: Reduced climbers"), *MixName), NumInTier[1], NumReduced);
+
+        const FClimbPerfRun Run = RunClimbPerfScript(TestWorld, Climbers);
+        AddInfo(FString::Printf(TEXT("%s: %s"), *MixName, *Run.ToString()));
+
+        // Every mix moves more climbers down the tiers than the one before it
+        TestTrue(FString::Printf(TEXT("%s probes less than the mix before"), *MixName), Run.TracesIssued < LastTracesIssued);
+        LastTracesIssued = Run.TracesIssued;
+    }
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,172 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Tests/ClimbTestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "ClimbingSystem/ClimbingSystemCharacter.h"
+#include "Climbing/ClimbSession.h"
+#include "Misc/AutomationTest.h"
+
+namespace
+{
+    /* One move as the client sends it */
+    struct FClimbTestMove
+    {
+        uint8 CompressedFlags = 0;
+        FVector Acceleration = FVector::ZeroVector;
+
+        /* Where the client ended up after running it */
+        FVector ClientLocation = FVector::ZeroVector;
+        bool bClientClimbing = false;
+    };
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbSavedMoveFlagsTest, "ClimbingSystem.Prediction.SavedMoveFlags",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+// The climb requests survive packing into a saved move and unpacking on the other end
+bool FClimbSavedMoveFlagsTest::RunTest(const FString& Parameters)
+{
+    FClimbTestWorld TestWorld;
+    TestWorld.SpawnTestWall();
+
+    AClimbingSystemCharacter* Climber = TestWorld.SpawnClimber(0.f, 300.f);
+    if(!TestNotNull(TEXT("Climber"), Climber)) return false;
+    UCustomMovementComponent* Movement = Climber->GetCustomeMovementComponent();
+    FNetworkPredictionData_Client_Character* ClientData = Movement->GetPredictionData_Client_Character();
+    if(!TestNotNull(TEXT("Client prediction data"), ClientData)) return false;
+
+    FSavedMove_Climb Move;
+    Move.Clear();
+
+    Movement->RequestClimbToggle();
+    Move.SetMoveFor(Climber, FClimbTestWorld::DeltaTime, FVector::ZeroVector, *ClientData);
+    TestEqual(TEXT("Toggle packs into FLAG_Custom_0 only"), Move.GetCompressedFlags() & (FSavedMove_Character::FLAG_Custom_0 | FSavedMove_Character::FLAG_Custom_1), static_cast<int32>(FSavedMove_Character::FLAG_Custom_0));
+
+    Move.Clear();
+    Movement->UpdateFromCompressedFlags(0);
+    Movement->RequestClimbHop();
+    Move.SetMoveFor(Climber, FClimbTestWorld::DeltaTime, FVector::ZeroVector, *ClientData);
+    TestEqual(TEXT("Hop packs into FLAG_Custom_1 only"), Move.GetCompressedFlags() & (FSavedMove_Character::FLAG_Custom_0 | FSavedMove_Character::FLAG_Custom_1), static_cast<int32>(FSavedMove_Character::FLAG_Custom_1));
+
+    // The other end only has the flags
+    AClimbingSystemCharacter* Receiver = TestWorld.SpawnClimber(600.f, 300.f);
+    if(!TestNotNull(TEXT("Receiver"), Receiver)) return false;
+    Receiver->GetCustomeMovementComponent()->UpdateFromCompressedFlags(FSavedMove_Character::FLAG_Custom_0);
+    FSavedMove_Climb ReceivedMove;
+    ReceivedMove.Clear();
+    ReceivedMove.SetMoveFor(Receiver, FClimbTestWorld::DeltaTime, FVector::ZeroVector, *Receiver->GetCustomeMovementComponent()->GetPredictionData_Client_Character());
+    TestTrue(TEXT("Unpacked toggle is a pending request again"), ReceivedMove.bSavedWantsToToggleClimb && !ReceivedMove.bSavedWantsToHop);
+
+    // Requests never ride along in a combined move
+    FSavedMovePtr PlainMove = ClientData->CreateSavedMove();
+    FSavedMovePtr RequestMove = ClientData->CreateSavedMove();
+    static_cast<FSavedMove_Climb*>(RequestMove.Get())->bSavedWantsToToggleClimb = true;
+    TestFalse(TEXT("A toggle move is not combined"), PlainMove->CanCombineWith(RequestMove, Climber, 1.f));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbLaggedServerTest, "ClimbingSystem.Prediction.LaggedServerAgrees",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+// A predicting client and a server getting its moves 150 ms late, side by side in one world
+// The server copy never ticks on its own, it only runs the client's moves once they arrive, like ServerMove.
+// This stands in for a listen server with Net PktLag=150: no net driver, packet loss or move combining, the lag is the move queue.
+// Its worst client/server divergence is the number to read in place of the corrections such a session would log
+bool FClimbLaggedServerTest::RunTest(const FString& Parameters)
+{
+    // 150 ms at 60 Hz
+    constexpr int32 LagFrames = 9;
+
+    // The server corrects a client further off than MAXPOSITIONERRORSQUARED, 3 cm squared
+    const float MaxDivergence = FMath::Sqrt(3.f);
+
+    FClimbTestWorld TestWorld;
+    TestWorld.SpawnTestWall();
+    TestWorld.SpawnWall(FVector(0.f, 0.f, -50.f), FVector(2000.f, 2000.f, 50.f));
+
+    AClimbingSystemCharacter* Client = TestWorld.SpawnClimber(-300.f, 300.f);
+    AClimbingSystemCharacter* Server = TestWorld.SpawnClimber(300.f, 300.f);
+    if(!TestNotNull(TEXT("Client"), Client) || !TestNotNull(TEXT("Server"), Server)) return false;
+
+    UCustomMovementComponent* ClientMovement = Client->GetCustomeMovementComponent();
+    UCustomMovementComponent* ServerMovement = Server->GetCustomeMovementComponent();
+    ServerMovement->SetComponentTickEnabled(false);
+    FNetworkPredictionData_Client_Character* ClientData = ClientMovement->GetPredictionData_Client_Character();
+
+    const FVector SideOffset = Server->GetActorLocation() - Client->GetActorLocation();
+
+    // Climb up and sideways, let go of the wall through the climb toggle, then fall to the ground
+    TArray<FClimbSessionFrame> Script;
+    for(int32 Frame = 0; Frame < 150; ++Frame)
+    {
+        FClimbSessionFrame& Input = Script.AddDefaulted_GetRef();
+        Input.ClimbMoveInput = Frame < 90 ? FVector2f(0.f, 1.f) : FVector2f(1.f, 0.f);
+        Input.Buttons = Frame == 120 ? EClimbSessionButton::Climb : EClimbSessionButton::None;
+    }
+    Script.AddDefaulted(60);
+
+    TArray<FClimbTestMove> Moves;
+    float WorstDivergence = 0.f;
+    int32 WorstMove = 0;
+    int32 FirstModeMismatch = INDEX_NONE;
+    int32 NextServerMove = 0;
+    const auto RunServerMove = [&]()
+    {
+        const FClimbTestMove& Move = Moves[NextServerMove];
+        FClimbTestAccess::MoveAutonomous(*ServerMovement, (NextServerMove + 1) * FClimbTestWorld::DeltaTime, FClimbTestWorld::DeltaTime, Move.CompressedFlags, Move.Acceleration);
+
+        const float Divergence = FVector::Dist(Move.ClientLocation + SideOffset, Server->GetActorLocation());
+        if(Divergence > WorstDivergence)
+        {
+            WorstDivergence = Divergence;
+            WorstMove = NextServerMove;
+        }
+        if(FirstModeMismatch == INDEX_NONE && Move.bClientClimbing != ServerMovement->IsClimbing())
+        {
+            FirstModeMismatch = NextServerMove;
+        }
+        ++NextServerMove;
+    };
+
+    for(const FClimbSessionFrame& Input : Script)
+    {
+        Client->ApplyClimbSessionInput(Input);
+
+        // What ReplicateMoveToServer saves before the client runs the move
+        FClimbTestMove& Move = Moves.AddDefaulted_GetRef();
+        FSavedMove_Climb SavedMove;
+        SavedMove.Clear();
+        SavedMove.SetMoveFor(Client, FClimbTestWorld::DeltaTime, FClimbTestAccess::GetInputAcceleration(*ClientMovement, Client->GetPendingMovementInputVector()), *ClientData);
+        Move.CompressedFlags = SavedMove.GetCompressedFlags();
+        Move.Acceleration = SavedMove.Acceleration;
+
+        TestWorld.Tick();
+        Move.ClientLocation = Client->GetActorLocation();
+        Move.bClientClimbing = ClientMovement->IsClimbing();
+
+        if(Moves.Num() > LagFrames)
+        {
+            RunServerMove();
+        }
+    }
+
+    // Whatever was still on the wire
+    while(NextServerMove < Moves.Num())
+    {
+        RunServerMove();
+    }
+
+    AddInfo(FString::Printf(TEXT("Worst divergence %.3f cm at move %d with the server %d frames behind, standing in for a PktLag=150 net session"), WorstDivergence, WorstMove, LagFrames));
+
+    TestFalse(TEXT("Client let go of the wall"), ClientMovement->IsClimbing());
+    TestEqual(TEXT("Move the server left or entered the climb on a different move than the client"), FirstModeMismatch, INDEX_NONE);
+    TestTrue(FString::Printf(TEXT("Server stays within %.2f cm of the client, no correction"), MaxDivergence), WorstDivergence <= MaxDivergence);
+
+    return true;
+}
+
+#endif
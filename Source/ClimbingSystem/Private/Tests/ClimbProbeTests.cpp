@@ -0,0 +1,141 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Tests/ClimbTestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "ClimbingSystem/ClimbingSystemCharacter.h"
+#include "Climbing/ClimbObstacle.h"
+#include "Misc/AutomationTest.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbAsyncProbeTrajectoryTest, "ClimbingSystem.Probes.AsyncMatchesSync",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+// Two climbers side by side on the same wall and script, one tracing right away and one reading its probes back a frame late
+bool FClimbAsyncProbeTrajectoryTest::RunTest(const FString& Parameters)
+{
+    // A frame late on a flat wall is at most one frame of climbing off, MaxClimbSpeed / 60 with the default profile
+    constexpr float MaxDivergence = 2.f;
+
+    FClimbTestWorld TestWorld;
+    TestWorld.SpawnTestWall();
+
+    AClimbingSystemCharacter* SyncClimber = TestWorld.SpawnClimber(-300.f, 300.f);
+    AClimbingSystemCharacter* AsyncClimber = TestWorld.SpawnClimber(300.f, 300.f);
+    if(!TestNotNull(TEXT("Sync climber"), SyncClimber) || !TestNotNull(TEXT("Async climber"), AsyncClimber)) return false;
+
+    UCustomMovementComponent* SyncMovement = SyncClimber->GetCustomeMovementComponent();
+    UCustomMovementComponent* AsyncMovement = AsyncClimber->GetCustomeMovementComponent();
+    SyncMovement->SetUseAsyncClimbProbes(false);
+    AsyncMovement->SetUseAsyncClimbProbes(true);
+
+    // Both start the same distance to the side of their own spawn point
+    const FVector SideOffset = AsyncClimber->GetActorLocation() - SyncClimber->GetActorLocation();
+
+    float WorstDivergence = 0.f;
+    int32 WorstFrame = 0;
+    int32 FirstModeMismatch = INDEX_NONE;
+    AClimbingSystemCharacter* const Climbers[] = {SyncClimber, AsyncClimber};
+    TestWorld.RunScript(Climbers, FClimbTestWorld::GetClimbScript(), [&](int32 Frame)
+    {
+        const float Divergence = FVector::Dist(SyncClimber->GetActorLocation() + SideOffset, AsyncClimber->GetActorLocation());
+        if(Divergence > WorstDivergence)
+        {
+            WorstDivergence = Divergence;
+            WorstFrame = Frame;
+        }
+        if(FirstModeMismatch == INDEX_NONE && SyncMovement->IsClimbing() != AsyncMovement->IsClimbing())
+        {
+            FirstModeMismatch = Frame;
+        }
+    });
+
+    AddInfo(FString::Printf(TEXT("Worst divergence %.3f cm at frame %d, %llu sync and %llu async climb traces"),
+        WorstDivergence, WorstFrame, SyncMovement->GetClimbTracesIssued(), AsyncMovement->GetClimbTracesIssued()));
+
+    TestTrue(TEXT("Sync climber still climbing"), SyncMovement->IsClimbing());
+    TestTrue(TEXT("Async climber still climbing"), AsyncMovement->IsClimbing());
+    TestEqual(TEXT("Frame the climbers left or entered the climb at different times"), FirstModeMismatch, INDEX_NONE);
+    TestTrue(FString::Printf(TEXT("Async trajectory within %.1f cm of the sync one"), MaxDivergence), WorstDivergence <= MaxDivergence);
+    TestTrue(TEXT("Surface normals agree"), SyncMovement->GetClimbableSurfaceNormal().Equals(AsyncMovement->GetClimbableSurfaceNormal(), 1e-3));
+
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbableChannelContactsTest, "ClimbingSystem.Probes.ClimbableChannelReportsEveryContact",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+// In an inside corner the surface sweep touches both walls, a blocking response on the channel would stop it at the first
+bool FClimbableChannelContactsTest::RunTest(const FString& Parameters)
+{
+    FClimbTestWorld TestWorld;
+    TestWorld.SpawnTestWall();
+
+    // Second wall facing -Y with its face at Y = 200, meeting the test wall's face
+    constexpr float SideWallFaceY = 200.f;
+    TestWorld.SpawnWall(FVector(FClimbTestWorld::WallFaceX - 150.f, SideWallFaceY + 100.f, FClimbTestWorld::WallHeight * 0.5f),
+        FVector(150.f, 100.f, FClimbTestWorld::WallHeight * 0.5f));
+
+    AClimbingSystemCharacter* Climber = TestWorld.SpawnClimber(SideWallFaceY - 50.f, 300.f, false);
+    if(!TestNotNull(TEXT("Climber"), Climber)) return false;
+    UCustomMovementComponent* Movement = Climber->GetCustomeMovementComponent();
+
+    FClimbTestAccess::SetTraceClimbableChannel(*Movement, false);
+    FClimbTestAccess::TraceSurfaces(*Movement);
+    const int32 NumObjectContacts = FClimbTestAccess::GetSurfaceHits(*Movement).Num();
+
+    FClimbTestAccess::SetTraceClimbableChannel(*Movement, true);
+    FClimbTestAccess::TraceSurfaces(*Movement);
+    const int32 NumChannelContacts = FClimbTestAccess::GetSurfaceHits(*Movement).Num();
+
+    TestTrue(TEXT("Object type sweep touches both walls"), NumObjectContacts >= 2);
+    TestEqual(TEXT("Climbable channel sweep reports the same contacts as the object type sweep"), NumChannelContacts, NumObjectContacts);
+
+    return true;
+}
+
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbAsyncObstacleScanTest, "ClimbingSystem.Probes.AsyncObstacleScanMatchesSync",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+// A character standing in front of a waist high box scans it right away and through the async batch read back a frame later
+bool FClimbAsyncObstacleScanTest::RunTest(const FString& Parameters)
+{
+    FClimbTestWorld TestWorld;
+
+    // Floor with its top at Z = 0 and a box 100 high and 100 deep with its near face at WallFaceX
+    TestWorld.SpawnWall(FVector(0.f, 0.f, -50.f), FVector(1000.f, 1000.f, 50.f));
+    TestWorld.SpawnWall(FVector(FClimbTestWorld::WallFaceX + 50.f, 0.f, 50.f), FVector(50.f, 200.f, 50.f));
+
+    AClimbingSystemCharacter* Climber = TestWorld.SpawnClimber(0.f, 100.f, false);
+    if(!TestNotNull(TEXT("Climber"), Climber)) return false;
+    UCustomMovementComponent* Movement = Climber->GetCustomeMovementComponent();
+
+    // Let it land
+    TestWorld.Tick(30);
+
+    FClimbObstacleProfile SyncProfile;
+    FClimbTestAccess::ScanObstacleProfile(*Movement, SyncProfile);
+
+    // Its own tick would act on the scan, read it back by hand instead
+    FClimbTestAccess::SubmitObstacleScan(*Movement);
+    Movement->SetComponentTickEnabled(false);
+    TestWorld.Tick();
+
+    FClimbObstacleProfile AsyncProfile;
+    if(!TestTrue(TEXT("Async scan read back on the next frame"), FClimbTestAccess::ConsumeObstacleScan(*Movement, AsyncProfile))) return false;
+
+    TestTrue(TEXT("Sync scan found the box"), SyncProfile.bHasObstacle);
+    TestEqual(TEXT("Obstacle found"), AsyncProfile.bHasObstacle, SyncProfile.bHasObstacle);
+    TestEqual(TEXT("Obstacle height"), AsyncProfile.Height, SyncProfile.Height, 0.1f);
+    TestEqual(TEXT("Obstacle distance"), AsyncProfile.Distance, SyncProfile.Distance, 0.1f);
+    TestEqual(TEXT("Obstacle depth"), AsyncProfile.Depth, SyncProfile.Depth, 0.1f);
+    TestEqual(TEXT("Clearance"), AsyncProfile.Clearance, SyncProfile.Clearance, 0.1f);
+    TestEqual(TEXT("Landing found"), AsyncProfile.bHasLanding, SyncProfile.bHasLanding);
+    TestEqual(TEXT("Drop found"), AsyncProfile.bHasDrop, SyncProfile.bHasDrop);
+
+    return true;
+}
+
+#endif
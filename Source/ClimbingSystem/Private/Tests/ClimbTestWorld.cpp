@@ -0,0 +1,383 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Tests/ClimbTestWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "ClimbingSystem/ClimbingStats.h"
+#include "ClimbingSystem/ClimbingSystem.h"
+#include "ClimbingSystem/ClimbingSystemCharacter.h"
+#include "Climbing/ClimbSession.h"
+#include "Components/BoxComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameFramework/WorldSettings.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTLS.h"
+
+namespace
+{
+    // Forwards to the real allocator, counting the allocations made on the game thread while it is installed
+    class FClimbCountingMalloc final : public FMalloc
+    {
+    public:
+        FMalloc* Inner = nullptr;
+        uint64 NumAllocations = 0;
+
+        virtual void* Malloc(SIZE_T Count, uint32 Alignment) override
+        {
+            CountAllocation();
+            return Inner->Malloc(Count, Alignment);
+        }
+
+        virtual void* TryMalloc(SIZE_T Count, uint32 Alignment) override
+        {
+            CountAllocation();
+            return Inner->TryMalloc(Count, Alignment);
+        }
+
+        virtual void* Realloc(void* Original, SIZE_T Count, uint32 Alignment) override
+        {
+            if(Count > 0)
+            {
+                CountAllocation();
+            }
+            return Inner->Realloc(Original, Count, Alignment);
+        }
+
+        virtual void* TryRealloc(void* Original, SIZE_T Count, uint32 Alignment) override
+        {
+            if(Count > 0)
+            {
+                CountAllocation();
+            }
+            return Inner->TryRealloc(Original, Count, Alignment);
+        }
+
+        virtual void Free(void* Original) override { Inner->Free(Original); }
+        virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+        virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+        virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+        virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+        virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+        virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+        virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+        virtual const TCHAR* GetDescriptiveName() override { return TEXT("ClimbCountingMalloc"); }
+
+    private:
+        void CountAllocation()
+        {
+            if(FPlatformTLS::GetCurrentThreadId() == GGameThreadId)
+            {
+                ++NumAllocations;
+            }
+        }
+    };
+
+    // Never destroyed, other threads may still be inside it right after it is uninstalled
+    FClimbCountingMalloc GClimbCountingMalloc;
+}
+
+FClimbAllocationCounter::~FClimbAllocationCounter()
+{
+    Stop();
+}
+
+bool FClimbAllocationCounter::IsAvailable()
+{
+#if PLATFORM_USES_FIXED_GMalloc_CLASS
+    return false;
+#else
+    return GMalloc && GMalloc != &GClimbCountingMalloc;
+#endif
+}
+
+void FClimbAllocationCounter::Start()
+{
+    if(bCounting || !IsAvailable()) return;
+
+    GClimbCountingMalloc.Inner = GMalloc;
+    GClimbCountingMalloc.NumAllocations = 0;
+    GMalloc = &GClimbCountingMalloc;
+    bCounting = true;
+}
+
+void FClimbAllocationCounter::Stop()
+{
+    if(!bCounting) return;
+
+    GMalloc = GClimbCountingMalloc.Inner;
+    NumAllocations += GClimbCountingMalloc.NumAllocations;
+    bCounting = false;
+}
+
+FClimbTickAllocationCounter::FClimbTickAllocationCounter(AClimbingSystemCharacter& InClimber)
+    : Movement(InClimber.GetCustomeMovementComponent())
+{
+    FTickFunction& MovementTick = Movement->PrimaryComponentTick;
+
+    for(FCounterTickFunction* TickFunction : {&StartTick, &StopTick})
+    {
+        TickFunction->Owner = this;
+        TickFunction->bCanEverTick = true;
+        TickFunction->TickGroup = MovementTick.TickGroup;
+        TickFunction->EndTickGroup = MovementTick.EndTickGroup;
+        TickFunction->RegisterTickFunction(InClimber.GetLevel());
+    }
+    StartTick.bStart = true;
+
+    // The counter's ticks have no object of their own, they live as long as the movement component they wrap
+    MovementTick.AddPrerequisite(Movement.Get(), StartTick);
+    StopTick.AddPrerequisite(Movement.Get(), MovementTick);
+    DependentTicks.Add({Movement.Get(), &MovementTick});
+
+    // The climber's other ticks in the movement's group run before the start, or after the stop when they wait on the movement,
+    // so the window holds the movement tick alone. Ticks in other groups never share it
+    TArray<TPair<UObject*, FTickFunction*>> OtherTicks = {{&InClimber, &InClimber.PrimaryActorTick}};
+    for(UActorComponent* Component : InClimber.GetComponents())
+    {
+        if(Component && Component != Movement.Get())
+        {
+            OtherTicks.Add({Component, &Component->PrimaryComponentTick});
+        }
+    }
+
+    for(const TPair<UObject*, FTickFunction*>& Other : OtherTicks)
+    {
+        FTickFunction& OtherTick = *Other.Value;
+        if(!OtherTick.IsTickFunctionRegistered() || OtherTick.TickGroup != MovementTick.TickGroup) continue;
+
+        const bool bWaitsOnMovement = OtherTick.GetPrerequisites().ContainsByPredicate([&MovementTick](const FTickPrerequisite& Prerequisite)
+        {
+            return Prerequisite.PrerequisiteTickFunction == &MovementTick;
+        });
+        if(bWaitsOnMovement)
+        {
+            OtherTick.AddPrerequisite(Movement.Get(), StopTick);
+            DependentTicks.Add({Other.Key, &OtherTick});
+        }
+        else
+        {
+            StartTick.AddPrerequisite(Other.Key, OtherTick);
+        }
+    }
+}
+
+FClimbTickAllocationCounter::~FClimbTickAllocationCounter()
+{
+    Counter.Stop();
+
+    // Nothing may keep waiting on the counter's ticks once they are gone
+    for(const TPair<TWeakObjectPtr<UObject>, FTickFunction*>& Dependent : DependentTicks)
+    {
+        if(Dependent.Key.IsValid() && Movement.IsValid())
+        {
+            Dependent.Value->RemovePrerequisite(Movement.Get(), StartTick);
+            Dependent.Value->RemovePrerequisite(Movement.Get(), StopTick);
+        }
+    }
+    StartTick.UnRegisterTickFunction();
+    StopTick.UnRegisterTickFunction();
+}
+
+void FClimbTickAllocationCounter::FCounterTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+    if(bStart)
+    {
+        if(Owner->bEnabled)
+        {
+            Owner->Counter.Start();
+        }
+        return;
+    }
+
+    if(Owner->Counter.IsCounting())
+    {
+        Owner->Counter.Stop();
+        ++Owner->NumTicks;
+    }
+}
+
+void FClimbPerfSamples::AddCycles(uint64 Cycles)
+{
+    Microseconds.Add(FPlatformTime::ToSeconds64(Cycles) * 1e6);
+}
+
+double FClimbPerfSamples::GetPercentile(float Fraction) const
+{
+    if(Microseconds.IsEmpty()) return 0.0;
+
+    TArray<double> Sorted = Microseconds;
+    Sorted.Sort();
+    return Sorted[FMath::Clamp(FMath::FloorToInt(Sorted.Num() * Fraction), 0, Sorted.Num() - 1)];
+}
+
+FString FClimbPerfSamples::ToString() const
+{
+    return FString::Printf(TEXT("p50 %.1f us, p95 %.1f us, max %.1f us over %d frames"), GetPercentile(0.5f), GetPercentile(0.95f), GetPercentile(1.f), Microseconds.Num());
+}
+
+FClimbTestWorld::FClimbTestWorld()
+{
+    World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("ClimbTestWorld"));
+
+    FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+    WorldContext.SetCurrentWorld(World);
+
+    World->InitializeActorsForPlay(FURL());
+    World->BeginPlay();
+
+    // No game mode to start play, so begin it through the world settings
+    if(!World->GetBegunPlay())
+    {
+        World->GetWorldSettings()->NotifyBeginPlay();
+    }
+}
+
+FClimbTestWorld::~FClimbTestWorld()
+{
+    if(!World) return;
+
+    // Climbers unregister from the world's subsystems in their EndPlay
+    for(const TWeakObjectPtr<AActor>& Actor : SpawnedActors)
+    {
+        if(Actor.IsValid())
+        {
+            Actor->Destroy();
+        }
+    }
+
+    GEngine->DestroyWorldContext(World);
+    World->DestroyWorld(false);
+    World = nullptr;
+}
+
+AActor* FClimbTestWorld::SpawnWall(const FVector& Center, const FVector& HalfExtent)
+{
+    AActor* Wall = World->SpawnActor<AActor>();
+
+    UBoxComponent* Box = NewObject<UBoxComponent>(Wall, TEXT("Wall"));
+    Box->SetBoxExtent(HalfExtent, false);
+    Box->SetCollisionProfileName(TEXT("ClimbableStatic"));
+    Box->SetWorldLocation(Center);
+    Wall->SetRootComponent(Box);
+    Box->RegisterComponent();
+
+    SpawnedActors.Add(Wall);
+    return Wall;
+}
+
+AActor* FClimbTestWorld::SpawnTestWall()
+{
+    const FVector HalfExtent(100.f, 1000.f, WallHeight * 0.5f);
+    return SpawnWall(FVector(WallFaceX + HalfExtent.X, 0.f, HalfExtent.Z), HalfExtent);
+}
+
+AActor* FClimbTestWorld::SpawnDecoration(const FVector& Center, const FVector& HalfExtent)
+{
+    AActor* Decoration = SpawnWall(Center, HalfExtent);
+
+    // Object type traces cannot tell it from a wall, the Climbable channel and pawns ignore it
+    UBoxComponent* Box = CastChecked<UBoxComponent>(Decoration->GetRootComponent());
+    Box->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+    Box->SetCollisionObjectType(ECC_WorldStatic);
+    Box->SetCollisionResponseToAllChannels(ECR_Overlap);
+    Box->SetCollisionResponseToChannel(ECC_Climbable, ECR_Ignore);
+    Box->SetCollisionResponseToChannel(ECC_Pawn, ECR_Ignore);
+
+    return Decoration;
+}
+
+AClimbingSystemCharacter* FClimbTestWorld::SpawnClimber(float Y, float Z, bool bStartClimbing)
+{
+    // Capsule radius away from the face, where the snap holds a climber
+    const FTransform SpawnTransform(FVector(WallFaceX - 42.f, Y, Z));
+
+    AClimbingSystemCharacter* Climber = World->SpawnActor<AClimbingSystemCharacter>(AClimbingSystemCharacter::StaticClass(), SpawnTransform);
+    if(!Climber) return nullptr;
+
+    // Nobody possesses it, the tests feed it input themselves
+    UCustomMovementComponent* Movement = Climber->GetCustomeMovementComponent();
+    Movement->bRunPhysicsWithNoController = true;
+    FClimbTestAccess::UseObjectTypes(*Movement, {ECC_WorldStatic});
+
+    if(bStartClimbing)
+    {
+        Movement->ForceStartClimbing();
+    }
+
+    SpawnedActors.Add(Climber);
+    return Climber;
+}
+
+void FClimbTestWorld::Tick(int32 NumFrames)
+{
+    for(int32 Frame = 0; Frame < NumFrames; ++Frame)
+    {
+        ++GFrameCounter;
+        World->Tick(LEVELTICK_All, DeltaTime);
+    }
+}
+
+void FClimbTestWorld::RunScript(TConstArrayView<AClimbingSystemCharacter*> Climbers, TConstArrayView<FClimbTestStep> Script, TFunctionRef<void(int32 Frame)> PerFrame)
+{
+    int32 Frame = 0;
+    for(const FClimbTestStep& Step : Script)
+    {
+        FClimbSessionFrame Input;
+        Input.ClimbMoveInput = FVector2f(Step.ClimbMoveInput);
+
+        for(int32 StepFrame = 0; StepFrame < Step.NumFrames; ++StepFrame, ++Frame)
+        {
+            for(AClimbingSystemCharacter* Climber : Climbers)
+            {
+                Climber->ApplyClimbSessionInput(Input);
+            }
+            Tick();
+            PerFrame(Frame);
+        }
+    }
+}
+
+TConstArrayView<FClimbTestStep> FClimbTestWorld::GetClimbScript()
+{
+    static const FClimbTestStep Script[] =
+    {
+        {FVector2D(0.f, 1.f), 120},
+        {FVector2D(1.f, 0.f), 60},
+        {FVector2D(-1.f, 0.f), 120},
+        {FVector2D(1.f, 1.f), 60},
+        {FVector2D(0.f, -1.f), 90},
+        {FVector2D::ZeroVector, 30}
+    };
+    return Script;
+}
+
+int32 FClimbTestWorld::GetNumScriptFrames(TConstArrayView<FClimbTestStep> Script)
+{
+    int32 NumFrames = 0;
+    for(const FClimbTestStep& Step : Script)
+    {
+        NumFrames += Step.NumFrames;
+    }
+    return NumFrames;
+}
+
+int64 FClimbTestWorld::GetClimbingTrackedBytes()
+{
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+    if(FLowLevelMemTracker::IsEnabled())
+    {
+        // Tag amounts are gathered from the threads once a frame, gather them now
+        FLowLevelMemTracker::Get().UpdateStatsPerFrame();
+        return FLowLevelMemTracker::Get().GetTagAmountForTracker(ELLMTracker::Default, LLM_TAG_NAME(Climbing).GetUniqueName(), ELLMTagSet::None);
+    }
+#endif
+    return INDEX_NONE;
+}
+
+#endif
@@ -0,0 +1,227 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Components/CustomMovementComponent.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Engine/EngineTypes.h"
+
+class AActor;
+class AClimbingSystemCharacter;
+class UWorld;
+
+/** One step of a scripted climb, the same climb move input held for a number of frames */
+struct FClimbTestStep
+{
+	FVector2D ClimbMoveInput = FVector2D::ZeroVector;
+	int32 NumFrames = 0;
+};
+
+/** Per frame timings of a perf test, reported as percentiles */
+struct FClimbPerfSamples
+{
+	TArray<double> Microseconds;
+
+	void AddCycles(uint64 Cycles);
+
+	double GetPercentile(float Fraction) const;
+
+	/** p50, p95 and max over the frames */
+	FString ToString() const;
+};
+
+/**
+ * Counts the allocations made on the game thread between Start and Stop, by putting a forwarding allocator in front of GMalloc.
+ * Platforms with a fixed GMalloc class call it directly and cannot be counted, and counters do not nest.
+ */
+class FClimbAllocationCounter
+{
+public:
+	~FClimbAllocationCounter();
+
+	/** False where allocations cannot be counted, Start does nothing then */
+	static bool IsAvailable();
+
+	void Start();
+	void Stop();
+
+	FORCEINLINE bool IsCounting() const { return bCounting; }
+	FORCEINLINE uint64 GetNumAllocations() const { return NumAllocations; }
+
+private:
+	uint64 NumAllocations = 0;
+	bool bCounting = false;
+};
+
+/**
+ * Counts the allocations made inside every tick of one climber's movement component, and nothing else the frame does.
+ * Tick functions right before and after it start and stop the count, the climber's other ticks are kept out of the window.
+ */
+class FClimbTickAllocationCounter
+{
+public:
+	explicit FClimbTickAllocationCounter(AClimbingSystemCharacter& Climber);
+	~FClimbTickAllocationCounter();
+
+	FORCEINLINE uint64 GetNumAllocations() const { return Counter.GetNumAllocations(); }
+
+	/** Movement ticks while disabled are not counted, for the frames a test spends setting up */
+	FORCEINLINE void SetEnabled(bool bInEnabled) { bEnabled = bInEnabled; }
+
+	/** Number of movement ticks counted so far */
+	FORCEINLINE int32 GetNumTicks() const { return NumTicks; }
+
+private:
+	struct FCounterTickFunction : public FTickFunction
+	{
+		FClimbTickAllocationCounter* Owner = nullptr;
+		bool bStart = false;
+
+		virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+		virtual FString DiagnosticMessage() override { return bStart ? TEXT("ClimbAllocationCounterStart") : TEXT("ClimbAllocationCounterStop"); }
+	};
+
+	FClimbAllocationCounter Counter;
+	FCounterTickFunction StartTick;
+	FCounterTickFunction StopTick;
+	TWeakObjectPtr<UCustomMovementComponent> Movement;
+
+	/* Ticks made to wait on the counter's, with the object that owns each */
+	TArray<TPair<TWeakObjectPtr<UObject>, FTickFunction*>> DependentTicks;
+
+	int32 NumTicks = 0;
+	bool bEnabled = true;
+};
+
+/**
+ * Headless game world for the climbing automation tests, with generated walls and climbers on them.
+ * It is ticked by hand one engine frame at a time, so climbers run the same tick functions they run in game.
+ */
+class FClimbTestWorld
+{
+public:
+	static constexpr float DeltaTime = 1.f / 60.f;
+
+	/* The wall every test climbs unless it builds its own, its climbing face looks down -X at X = WallFaceX */
+	static constexpr float WallFaceX = 50.f;
+	static constexpr float WallHeight = 1200.f;
+
+	FClimbTestWorld();
+	~FClimbTestWorld();
+
+	FORCEINLINE UWorld* GetWorld() const { return World; }
+
+	/** Box on the ClimbableStatic profile */
+	AActor* SpawnWall(const FVector& Center, const FVector& HalfExtent);
+
+	/** 2000 wide wall of WallHeight, standing on Z = 0 with its face at WallFaceX */
+	AActor* SpawnTestWall();
+
+	/** Query only WorldStatic box that climbing ignores, like foliage or decal volumes in front of a wall */
+	AActor* SpawnDecoration(const FVector& Center, const FVector& HalfExtent);
+
+	/** Climber facing +X at Y, hanging on the test wall at Z, on the test wall's object types */
+	AClimbingSystemCharacter* SpawnClimber(float Y, float Z, bool bStartClimbing = true);
+
+	/** One engine frame per step, GFrameCounter included since the async probes and LOD probe rates key off it */
+	void Tick(int32 NumFrames = 1);
+
+	/** Feed every climber the script's input through the character's own input handler, calling PerFrame after each tick */
+	void RunScript(TConstArrayView<AClimbingSystemCharacter*> Climbers, TConstArrayView<FClimbTestStep> Script, TFunctionRef<void(int32 Frame)> PerFrame);
+
+	/** Up, sideways both ways, down and a hold, everything a climber does on a plain wall */
+	static TConstArrayView<FClimbTestStep> GetClimbScript();
+
+	static int32 GetNumScriptFrames(TConstArrayView<FClimbTestStep> Script);
+
+	/** Bytes held under the Climbing LLM tag, INDEX_NONE unless the run has -llm */
+	static int64 GetClimbingTrackedBytes();
+
+private:
+	UWorld* World = nullptr;
+
+	TArray<TWeakObjectPtr<AActor>> SpawnedActors;
+};
+
+/** The tests' way into the movement component's private climb state */
+struct FClimbTestAccess
+{
+	static void UseObjectTypes(UCustomMovementComponent& Movement, std::initializer_list<ECollisionChannel> ObjectTypes)
+	{
+		Movement.ClimableSurfaceTraceTypes.Reset();
+		for(const ECollisionChannel ObjectType : ObjectTypes)
+		{
+			Movement.ClimableSurfaceTraceTypes.Add(UEngineTypes::ConvertToObjectType(ObjectType));
+		}
+		Movement.BuildClimbQueryParams();
+	}
+
+	static void SetTraceClimbableChannel(UCustomMovementComponent& Movement, bool bEnable)
+	{
+		Movement.bTraceClimbableChannel = bEnable;
+	}
+
+	/** Takes effect on the next climb enter, that is when climbers register with the batch */
+	static void SetUseBatchedClimbSimulation(UCustomMovementComponent& Movement, bool bEnable)
+	{
+		Movement.bUseBatchedClimbSimulation = bEnable;
+	}
+
+	/** Registers with the significance manager the way BeginPlay does when climb LOD is on */
+	static void EnableClimbLOD(UCustomMovementComponent& Movement, float FreezeAfterNotRenderedTime)
+	{
+		Movement.bEnableClimbLOD = true;
+		Movement.ClimbLODSettings.FreezeAfterNotRenderedTime = FreezeAfterNotRenderedTime;
+		Movement.RegisterClimbSignificance();
+	}
+
+	static FORCEINLINE const FClimbLODSettings& GetClimbLODSettings(const UCustomMovementComponent& Movement) { return Movement.ClimbLODSettings; }
+
+	/** Moves the tier distances, so climbers at the same distance from a viewpoint can land in different tiers */
+	static void SetClimbLODDistances(UCustomMovementComponent& Movement, float ReducedDistance, float SurfaceLockedDistance)
+	{
+		Movement.ClimbLODSettings.ReducedDistance = ReducedDistance;
+		Movement.ClimbLODSettings.SurfaceLockedDistance = SurfaceLockedDistance;
+	}
+
+	static FORCEINLINE float GetAnimBudgetSignificance(const UCustomMovementComponent& Movement) { return Movement.AnimBudgetSignificance; }
+
+	/** The acceleration the next tick will build from this input, what a client puts in its saved move */
+	static FVector GetInputAcceleration(UCustomMovementComponent& Movement, const FVector& InputVector)
+	{
+		return Movement.ScaleInputAcceleration(Movement.ConstrainInputAcceleration(InputVector));
+	}
+
+	/** Run one received move the way the server runs a ServerMove */
+	static void MoveAutonomous(UCustomMovementComponent& Movement, float TimeStamp, float DeltaTime, uint8 CompressedFlags, const FVector& Acceleration)
+	{
+		Movement.MoveAutonomous(TimeStamp, DeltaTime, CompressedFlags, Acceleration);
+	}
+
+	static FORCEINLINE bool TraceSurfaces(UCustomMovementComponent& Movement) { return Movement.TraceClimableSurfaces(); }
+
+	static FORCEINLINE bool CanStartClimbing(UCustomMovementComponent& Movement) { return Movement.CanStartClimbing(); }
+	static FORCEINLINE void ScanObstacleProfile(UCustomMovementComponent& Movement, FClimbObstacleProfile& OutProfile) { Movement.ScanObstacleProfile(OutProfile); }
+	static FORCEINLINE void SubmitObstacleScan(UCustomMovementComponent& Movement) { Movement.SubmitObstacleScan(); }
+	static FORCEINLINE bool ConsumeObstacleScan(UCustomMovementComponent& Movement, FClimbObstacleProfile& OutProfile) { return Movement.ConsumeObstacleScan(OutProfile); }
+	static FORCEINLINE bool CheckCanHopUp(UCustomMovementComponent& Movement, FVector& OutTarget) { return Movement.CheckCanHopUp(OutTarget); }
+	static FORCEINLINE bool CheckCanHopDown(UCustomMovementComponent& Movement, FVector& OutTarget) { return Movement.CheckCanHopDown(OutTarget); }
+	static FORCEINLINE bool CheckHasReachedLedge(UCustomMovementComponent& Movement) { return Movement.CheckHasReachedLedge(); }
+
+	/** Data of every buffer the climb tick reuses, once grown none of them may move */
+	static void GetReusedBuffers(const UCustomMovementComponent& Movement, TArray<const void*>& OutBuffers)
+	{
+		OutBuffers = {Movement.ClimbableSurfacesTracedResults.GetData(), Movement.FloorTracedResults.GetData(), Movement.ClimbLineTraceHits.GetData(),
+			Movement.SurfaceTraceDatum.OutHits.GetData(), Movement.FloorTraceDatum.OutHits.GetData(), Movement.LimbTraceDatum.OutHits.GetData(),
+			Movement.HangSleepAnchors.GetData()};
+	}
+
+	static FORCEINLINE const TArray<FHitResult>& GetSurfaceHits(const UCustomMovementComponent& Movement) { return Movement.ClimbableSurfacesTracedResults; }
+	static FORCEINLINE FVector GetSurfaceLocation(const UCustomMovementComponent& Movement) { return Movement.CurrentClimbableSurfaceLocation; }
+};
+
+#endif
@@ -4,28 +4,26 @@
 
 #include "CoreMinimal.h"
 #include "Animation/AnimInstance.h"
+#include "AnimInstance/ClimbAnimProxy.h"
 #include "CharacterAnimInstance.generated.h"
 
 /**
- * 
+ * Updates from the proxy the movement component hands it each tick, never from the component itself.
+ * Usually on an animation worker thread, on the game thread inside the move while root motion ticks the pose.
  */
-class AClimbingSystemCharacter;
-class UCustomMovementComponent;
 UCLASS()
 class CLIMBINGSYSTEM_API UCharacterAnimInstance : public UAnimInstance
 {
 	GENERATED_BODY()
 
 public:
-	virtual void NativeInitializeAnimation() override;
+	virtual void NativeThreadSafeUpdateAnimation(float DeltaSeconds) override;
 
-	virtual void NativeUpdateAnimation(float DeltaSeconds) override;
-private:
-	UPROPERTY()
-	AClimbingSystemCharacter* ClimbingSystemCharacter;
+	/* Called by the movement component on the game thread, before this instance updates */
+	FORCEINLINE void SetClimbAnimProxy(const FClimbAnimProxy& InProxy) { ClimbAnimProxy = InProxy; }
 
-	UPROPERTY()
-	UCustomMovementComponent* CustomMovementComponent;
+private:
+	FClimbAnimProxy ClimbAnimProxy;
 
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Reference, meta = (AllowPrivateAccess = "true"));
 	float GroundSpeed;
@@ -51,4 +49,21 @@ private:
 	FVector ClimbVelocity;
 	void GetClimbVelocity();
 
+	/* World space limb IK targets on the climbed wall, blend them in by LimbIKAlpha */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Reference, meta = (AllowPrivateAccess = "true"));
+	FVector LeftHandIKTarget;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Reference, meta = (AllowPrivateAccess = "true"));
+	FVector RightHandIKTarget;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Reference, meta = (AllowPrivateAccess = "true"));
+	FVector LeftFootIKTarget;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Reference, meta = (AllowPrivateAccess = "true"));
+	FVector RightFootIKTarget;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Reference, meta = (AllowPrivateAccess = "true"));
+	float LimbIKAlpha;
+	void GetLimbIKTargets();
+
 };
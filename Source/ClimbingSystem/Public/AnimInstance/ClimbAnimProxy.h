@@ -0,0 +1,25 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Climbing/ClimbLimbs.h"
+
+/**
+ * Everything the character anim instance reads from the character, copied out by the movement component once per tick.
+ * Plain data so the anim update can run on worker threads without touching any UObject.
+ */
+struct FClimbAnimProxy
+{
+	FVector Velocity = FVector::ZeroVector;
+	FVector Acceleration = FVector::ZeroVector;
+
+	/* Climb velocity in component space, see UCustomMovementComponent::GetUnrotatedClimbVelocity */
+	FVector UnrotatedClimbVelocity = FVector::ZeroVector;
+
+	bool bIsFalling = false;
+	bool bIsClimbing = false;
+
+	/* Hand and foot placement on the wall, invalid when not climbing or limb IK is off */
+	FClimbLimbTargets LimbTargets;
+};
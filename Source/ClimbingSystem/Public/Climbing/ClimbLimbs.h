@@ -0,0 +1,47 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Limbs placed on the wall while climbing, indexes into FClimbLimbTargets */
+enum class EClimbLimb : uint8
+{
+	LeftHand,
+	RightHand,
+	LeftFoot,
+	RightFoot,
+	Num
+};
+
+/** World space hand and foot placement on the climbed surface */
+struct FClimbLimbTargets
+{
+	FVector Locations[static_cast<int32>(EClimbLimb::Num)];
+	FVector Normals[static_cast<int32>(EClimbLimb::Num)];
+
+	/* False while not climbing or before the first placement of a climb */
+	bool bValid = false;
+
+	FClimbLimbTargets()
+	{
+		for(int32 Index = 0; Index < static_cast<int32>(EClimbLimb::Num); ++Index)
+		{
+			Locations[Index] = FVector::ZeroVector;
+			Normals[Index] = FVector::ZeroVector;
+		}
+	}
+};
+
+namespace ClimbMath
+{
+	/**
+	 * Fit one plane through the traced surface contacts.
+	 * False when a normal is more than MinNormalDot off the mean or a contact sits further than MaxPlaneDistance from the plane.
+	 * OutPlane is all zero when no contact faces the climber.
+	 */
+	CLIMBINGSYSTEM_API bool FitSurfacePatch(TConstArrayView<FHitResult> Hits, float MinNormalDot, float MaxPlaneDistance, FPlane& OutPlane);
+
+	/** Drop each rest point onto the plane along its normal */
+	CLIMBINGSYSTEM_API void PlaceLimbsOnPatch(TConstArrayView<FVector> RestPoints, const FPlane& Plane, FClimbLimbTargets& OutTargets);
+}
@@ -0,0 +1,53 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Pure climb math shared by the movement component and the baked climb data.
+ * Nothing in here touches UObjects, so it is safe to call from any thread.
+ */
+namespace ClimbMath
+{
+	/**
+	 * Intersect the horizontal ray Location + Forward * T with a vertical edge facing FacingNormal.
+	 * Only rays coming at the front of the edge within ~60 degrees count.
+	 * Returns the point on the edge, with its height interpolated along it, and the distance T.
+	 */
+	CLIMBINGSYSTEM_API bool FindEdgeAhead(const FVector& Location, const FVector& Forward, const FVector& EdgeStart, const FVector& EdgeEnd, const FVector& FacingNormal, float MaxDistance, FVector& OutEdgePoint, float& OutDistance);
+
+	/** Average impact point and normalized sum of impact normals of the traced climbable surfaces, zero if there are none */
+	CLIMBINGSYSTEM_API void ReduceClimbableSurface(TConstArrayView<FHitResult> Hits, FVector& OutSurfaceLocation, FVector& OutSurfaceNormal);
+
+	/* Weight of a contact seen edge on, so a lone side wall still gives a surface */
+	inline constexpr double MinClimbContactWeight = 0.1;
+
+	/** Weight of one contact of a climber at ClimberLocation facing ClimberForward. Zero when the contact faces away from the climber, the back side of thin geometry */
+	CLIMBINGSYSTEM_API double GetClimbContactWeight(const FVector& ImpactPoint, const FVector& ImpactNormal, const FVector& ClimberLocation, const FVector& ClimberForward);
+
+	/**
+	 * Weighted average impact point and normal of the surface the climber is facing. Contacts facing away from it are dropped
+	 * and the rest weigh by how squarely they face it times their grip, zero if none are left. Empty Grips grip everything fully.
+	 * The batched solve uses the same rules.
+	 */
+	CLIMBINGSYSTEM_API void ReduceClimbableSurface(TConstArrayView<FHitResult> Hits, TConstArrayView<float> Grips, const FVector& ClimberLocation, const FVector& ClimberForward, FVector& OutSurfaceLocation, FVector& OutSurfaceNormal);
+
+	/** True once the surface normal has at least TooFlatUpDot with up, too flat to keep climbing */
+	CLIMBINGSYSTEM_API bool IsSurfaceTooFlat(const FVector& SurfaceNormal, float TooFlatUpDot);
+
+	/** True if a floor hit with this normal ends the climb while climbing down at UnrotatedVelocity */
+	CLIMBINGSYSTEM_API bool IsFloorReached(const FVector& FloorNormal, const FVector& UnrotatedVelocity, float MinVerticalSpeed);
+
+	/** True if a hit with this normal above the wall is a walkable top to climb onto */
+	CLIMBINGSYSTEM_API bool IsLedgeTop(const FVector& TopNormal);
+
+	/** True once a ledge top LedgeHeight above the eyes is within ReachHeight while climbing up at UnrotatedVelocity */
+	CLIMBINGSYSTEM_API bool IsLedgeReached(float LedgeHeight, float ReachHeight, const FVector& UnrotatedVelocity, float MinVerticalSpeed);
+
+	/** Rotation turning to face into the surface, blended from Current at InterpSpeed */
+	CLIMBINGSYSTEM_API FQuat GetClimbRotation(const FQuat& Current, const FVector& SurfaceNormal, float DeltaTime, float InterpSpeed);
+
+	/** Vector pulling a climber at Location onto the surface, scale it by the time step and climb speed to move. Forward must be normalized */
+	CLIMBINGSYSTEM_API FVector GetSnapVector(const FVector& Location, const FVector& Forward, const FVector& SurfaceLocation, const FVector& SurfaceNormal);
+}
@@ -0,0 +1,83 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** What to do about the obstacle profile in front of a standing character */
+enum class EClimbObstacleAction : uint8
+{
+	None,
+	StepOver,
+	Vault,
+	Mantle,
+	ClimbDown
+};
+
+/** One downward column of the obstacle scan */
+struct FClimbObstacleSample
+{
+	/* Along the facing direction from the character */
+	float Distance = 0.f;
+
+	/* Of the impact point above the feet, only meaningful when bHit */
+	float Height = 0.f;
+
+	FVector ImpactPoint = FVector::ZeroVector;
+
+	/* False when the column found nothing all the way down to the scan depth */
+	bool bHit = false;
+};
+
+/** Shape of what is in front of the character, heights are relative to the feet */
+struct FClimbObstacleProfile
+{
+	bool bHasObstacle = false;
+
+	/* Highest obstacle column, its near edge and how far it runs along the facing direction */
+	float Height = 0.f;
+	float Distance = 0.f;
+	float Depth = 0.f;
+
+	/* Free height above the obstacle up to the top of the scan, zero when something overhead blocks it */
+	float Clearance = 0.f;
+
+	/* Ground at the far end of the scan past the obstacle */
+	bool bHasLanding = false;
+	float LandingHeight = 0.f;
+
+	/* Edge of a drop deeper than the scan reaches, on the way to or instead of an obstacle */
+	bool bHasDrop = false;
+	float DropDistance = 0.f;
+
+	/* Warp targets, the near top of the obstacle and where to land */
+	FVector TopPoint = FVector::ZeroVector;
+	FVector LandingPoint = FVector::ZeroVector;
+};
+
+/** Limits telling the traversal actions apart, baked from the climb profile */
+struct FClimbObstacleRules
+{
+	float MinObstacleHeight = 10.f;
+	float MaxStepOverHeight = 60.f;
+	float MaxVaultHeight = 150.f;
+	float MaxVaultDepth = 150.f;
+	float MaxMantleHeight = 180.f;
+	float MinClearance = 20.f;
+
+	/* A drop whose edge is this far ahead can be climbed down */
+	float MinClimbDownDistance = 100.f;
+	float MaxClimbDownDistance = 150.f;
+};
+
+namespace ClimbMath
+{
+	/**
+	 * Reduce the scan columns, nearest first, to a profile.
+	 * Columns at or past CeilingDistance sit under whatever the top trace hit and count as full height obstacles.
+	 */
+	CLIMBINGSYSTEM_API void BuildObstacleProfile(TConstArrayView<FClimbObstacleSample> Samples, float ScanHeight, float CeilingDistance, float MinObstacleHeight, FClimbObstacleProfile& OutProfile);
+
+	/** Pick the traversal action for the profile, None if nothing fits */
+	CLIMBINGSYSTEM_API EClimbObstacleAction ChooseObstacleAction(const FClimbObstacleProfile& Profile, const FClimbObstacleRules& Rules);
+}
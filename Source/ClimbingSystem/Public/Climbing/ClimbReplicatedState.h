@@ -0,0 +1,72 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ClimbReplicatedState.generated.h"
+
+/* What a climber is doing beyond moving along the wall, for simulated proxies */
+UENUM(BlueprintType)
+enum class EClimbSubState : uint8
+{
+	None,
+	Climbing,
+	/* Hanging still, asleep on the surface */
+	Hanging,
+	Hopping,
+	/* Entering, leaving or vaulting through a montage */
+	Transitioning
+};
+
+/**
+ * Climb state sent to simulated proxies on top of the stock replicated movement, 7 bytes on the wire:
+ * an octahedral surface normal in 16 bits, the climb velocity in surface space as two int16 and the sub state.
+ */
+USTRUCT()
+struct CLIMBINGSYSTEM_API FClimbReplicatedState
+{
+	GENERATED_BODY()
+
+	/* Octahedral surface normal, 8 bits per axis. Zero means no surface, it would decode to straight down which is never climbable */
+	UPROPERTY()
+	uint16 PackedNormal = 0;
+
+	/* Climb velocity along the surface's right and up axes, in tenths of cm/s */
+	UPROPERTY()
+	int16 SurfaceVelocityRight = 0;
+
+	UPROPERTY()
+	int16 SurfaceVelocityUp = 0;
+
+	UPROPERTY()
+	EClimbSubState SubState = EClimbSubState::None;
+
+	void SetSurfaceNormal(const FVector& SurfaceNormal);
+	FVector GetSurfaceNormal() const;
+
+	/* Velocity unrotated into the climber's frame, as GetUnrotatedClimbVelocity returns it */
+	void SetUnrotatedClimbVelocity(const FVector& UnrotatedClimbVelocity);
+	FVector GetUnrotatedClimbVelocity() const;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+	bool operator==(const FClimbReplicatedState& Other) const
+	{
+		return PackedNormal == Other.PackedNormal &&
+			SurfaceVelocityRight == Other.SurfaceVelocityRight &&
+			SurfaceVelocityUp == Other.SurfaceVelocityUp &&
+			SubState == Other.SubState;
+	}
+
+	bool operator!=(const FClimbReplicatedState& Other) const { return !(*this == Other); }
+};
+
+template<>
+struct TStructOpsTypeTraits<FClimbReplicatedState> : public TStructOpsTypeTraitsBase2<FClimbReplicatedState>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true
+	};
+};
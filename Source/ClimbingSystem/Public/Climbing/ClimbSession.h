@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Buttons pressed during a recorded frame */
+enum class EClimbSessionButton : uint8
+{
+	None = 0,
+	/* ClimbAction started */
+	Climb = 1 << 0,
+	/* ClimbHopAction started */
+	Hop = 1 << 1,
+	/* Jump held */
+	Jump = 1 << 2
+};
+ENUM_CLASS_FLAGS(EClimbSessionButton)
+
+/** Input of one frame and the movement state it ended in, 72 bytes on disk */
+struct FClimbSessionFrame
+{
+	float DeltaTime = 0.f;
+
+	/* MoveAction and ClimbMoveAction values, zero when not triggered */
+	FVector2f MoveInput = FVector2f::ZeroVector;
+	FVector2f ClimbMoveInput = FVector2f::ZeroVector;
+
+	/* Ground movement follows the control rotation */
+	FRotator3f ControlRotation = FRotator3f::ZeroRotator;
+
+	EClimbSessionButton Buttons = EClimbSessionButton::None;
+
+	FVector3f Location = FVector3f::ZeroVector;
+	FVector3f Velocity = FVector3f::ZeroVector;
+	FRotator3f Rotation = FRotator3f::ZeroRotator;
+
+	uint8 MovementMode = 0;
+	uint8 CustomMovementMode = 0;
+	uint8 ClimbSubState = 0;
+
+	friend FArchive& operator<<(FArchive& Ar, FClimbSessionFrame& Frame);
+};
+
+/** A recorded climb session, the start pose plus every frame after it */
+struct FClimbSession
+{
+	static constexpr uint32 Magic = 0x424D4C43; // "CLMB"
+	static constexpr uint32 Version = 1;
+
+	FString MapName;
+
+	FVector StartLocation = FVector::ZeroVector;
+	FRotator StartRotation = FRotator::ZeroRotator;
+	FRotator StartControlRotation = FRotator::ZeroRotator;
+	uint8 StartMovementMode = 0;
+	uint8 StartCustomMovementMode = 0;
+
+	TArray<FClimbSessionFrame> Frames;
+
+	bool SaveToFile(const FString& FileName) const;
+
+	/** False if the file is missing, not a climb session or of another version */
+	bool LoadFromFile(const FString& FileName);
+
+private:
+	bool Serialize(FArchive& Ar);
+};
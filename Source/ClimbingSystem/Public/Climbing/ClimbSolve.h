@@ -0,0 +1,75 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FClimbProfileConstants;
+
+/** Everything the climb decisions need from one climber, gathered on the game thread */
+struct FClimbSolveInput
+{
+	FVector Location = FVector::ZeroVector;
+	FQuat Rotation = FQuat::Identity;
+	FVector UnrotatedVelocity = FVector::ZeroVector;
+	float DeltaTime = 0.f;
+
+	/* Thresholds of the climber's profile, profiles are not changed while the batch is solved */
+	const FClimbProfileConstants* Profile = nullptr;
+
+	/* Ranges of this climber's hits in the batch's contact and floor arrays */
+	int32 ContactStart = 0;
+	int32 ContactNum = 0;
+	int32 FloorStart = 0;
+	int32 FloorNum = 0;
+
+	/* Answered by the baked ledge data or the tracked ledge while gathering, both are already a height compare */
+	bool bLedgeReached = false;
+};
+
+/** Climb decisions for one climber, applied by its PhysClimb on the same frame */
+struct FClimbSolveOutput
+{
+	FVector SurfaceLocation = FVector::ZeroVector;
+	FVector SurfaceNormal = FVector::ZeroVector;
+	FQuat ClimbRotation = FQuat::Identity;
+	bool bShouldStop = false;
+	bool bReachedLedge = false;
+
+	/* GFrameCounter value of the frame this was solved on, zero if never */
+	uint64 SolveFrame = 0;
+};
+
+/** Inputs of every climber in a frame, with their hits flattened into shared arrays so the buffers are reused */
+struct FClimbSolveBatch
+{
+	TArray<FClimbSolveInput> Inputs;
+	TArray<FClimbSolveOutput> Outputs;
+	TArray<FVector> ContactPoints;
+	TArray<FVector> ContactNormals;
+	/* Grip of each contact from the climb surface rules, 1 without any */
+	TArray<float> ContactGrips;
+	TArray<FVector> FloorNormals;
+
+	void Reset()
+	{
+		Inputs.Reset();
+		Outputs.Reset();
+		ContactPoints.Reset();
+		ContactNormals.Reset();
+		ContactGrips.Reset();
+		FloorNormals.Reset();
+	}
+};
+
+namespace ClimbMath
+{
+	/**
+	 * Reduce the contacts of the Num batch entries from First to their surfaces in OutResults, with the rules of the weighted
+	 * ReduceClimbableSurface. Four climbers at a time, one per register lane, only writes the surface of those entries.
+	 */
+	CLIMBINGSYSTEM_API void ReduceClimbableSurfaces(const FClimbSolveBatch& Batch, int32 First, int32 Num, TArrayView<FClimbSolveOutput> OutResults);
+
+	/** Run the climb decisions of the batch entry at Index on the surface ReduceClimbableSurfaces left in OutResult. Only reads the batch, so entries can be solved in parallel */
+	CLIMBINGSYSTEM_API void SolveClimb(const FClimbSolveBatch& Batch, int32 Index, FClimbSolveOutput& OutResult);
+}
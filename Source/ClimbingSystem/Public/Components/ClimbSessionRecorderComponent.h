@@ -0,0 +1,88 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Climbing/ClimbSession.h"
+#include "ClimbSessionRecorderComponent.generated.h"
+
+class AClimbingSystemCharacter;
+
+/**
+ * Records the climb input and movement state of its character frame by frame, and replays a recording
+ * at the recorded time steps, reporting how far the replay drifts and what each frame's climb tick cost.
+ * Drive it with Climb.Record and Climb.Replay, or -ClimbReplay=<File> for a headless run that exits when done.
+ */
+UCLASS()
+class CLIMBINGSYSTEM_API UClimbSessionRecorderComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UClimbSessionRecorderComponent();
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	void StartRecording();
+
+	/** Write the recording to Saved/ClimbSessions, returns the file written or an empty string */
+	FString StopRecording();
+
+	bool StartReplay(const FString& FileName);
+
+	FORCEINLINE bool IsRecording() const { return bRecording; }
+	FORCEINLINE bool IsReplaying() const { return bReplaying; }
+
+	/** Called by the character when it is possessed or unpossessed */
+	void OnCharacterControllerChanged();
+
+	/* Called by the character's input handlers while recording */
+	void CaptureMoveInput(const FVector2D& Value);
+	void CaptureClimbMoveInput(const FVector2D& Value);
+	void CaptureButton(EClimbSessionButton Button);
+
+private:
+	void UpdateCommandLineReplayTick();
+
+	void RecordFrame(float DeltaTime);
+
+	void AdvanceReplay();
+
+	void ApplyReplayFrame(const FClimbSessionFrame& Frame);
+
+	void FinishReplay();
+
+	UPROPERTY()
+	AClimbingSystemCharacter* ClimbingCharacter;
+
+	/* Replays further off the recorded location than this are reported as divergent */
+	UPROPERTY(EditDefaultsOnly, Category = "Climb Session", meta = (ClampMin = "0.0"))
+	float DivergenceTolerance = 1.f;
+
+	bool bRecording = false;
+	bool bReplaying = false;
+
+	/* Set by -ClimbReplay, the replay starts once the character is possessed and the game exits after it */
+	FString CommandLineReplayFile;
+	bool bExitAfterReplay = false;
+
+	FClimbSession Session;
+
+	/* Input of the frame being recorded */
+	FClimbSessionFrame PendingFrame;
+
+	/* Frame of the session the last applied input belongs to */
+	int32 ReplayFrameIndex = INDEX_NONE;
+
+	/* Per replayed frame, distance from the recorded location and cycles of the movement component tick */
+	TArray<float> ReplayDivergence;
+	TArray<uint64> ReplayTickCycles;
+	int32 ReplayModeMismatches = 0;
+
+	/* Fixed time step settings to restore after the replay */
+	bool bWasUsingFixedTimeStep = false;
+	double PreviousFixedDeltaTime = 0.0;
+};
@@ -0,0 +1,31 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SkeletalMeshComponentBudgeted.h"
+#include "ClimbingMeshComponent.generated.h"
+
+/**
+ * Budgeted mesh of a climber that keeps the game thread time it hands the animation budget allocator,
+ * its tick plus the completion of its parallel evaluation, so tests and tools can read what the budget is spent on.
+ */
+UCLASS()
+class CLIMBINGSYSTEM_API UClimbingMeshComponent : public USkeletalMeshComponentBudgeted
+{
+	GENERATED_BODY()
+
+public:
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual void CompleteParallelAnimationEvaluation(bool bDoPostAnimEvaluation) override;
+
+	/** Game thread milliseconds of the last frame it ticked in, zero if it has not ticked this frame */
+	float GetAnimationGameThreadMs() const;
+
+private:
+	/* GFrameCounter of the last tick, the times below belong to it */
+	uint64 LastTickFrame = 0;
+
+	float LastTickMs = 0.f;
+	float LastCompletionMs = 0.f;
+};
@@ -4,6 +4,11 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "WorldCollision.h"
+#include "Engine/StreamableManager.h"
+#include "Climbing/ClimbSolve.h"
+#include "Climbing/ClimbReplicatedState.h"
+#include "Climbing/ClimbLimbs.h"
 #include "CustomMovementComponent.generated.h"
 
 DECLARE_DELEGATE(FOnEnterClimbState)
@@ -11,8 +16,15 @@ DECLARE_DELEGATE(FOnExitClimbState)
 
 class UAnimMontage;
 class UAnimInstance;
+class UCharacterAnimInstance;
 class UKismetMathLibrary;
 class AClimbingSystemCharacter; 
+class UClimbLedgeGraph;
+class UClimbProfile;
+struct FClimbObstacleProfile;
+class UClimbLedgeGraphSubsystem;
+class UClimbingSimulationSubsystem;
+class UClimbSurfaceSubsystem;
 
 UENUM(BlueprintType)
 namespace ECustomMovementMode
@@ -23,6 +35,93 @@ namespace ECustomMovementMode
 	};
 }
 
+/* One frame worth of asynchronous climb probes, submitted together and read back the next frame */
+struct FClimbProbeFrame
+{
+	FTraceHandle SurfaceHandle;
+	FTraceHandle FloorHandle;
+
+	/* GFrameCounter value of the frame these probes were submitted on */
+	uint64 SubmitFrame = 0;
+};
+
+/* Obstacle scan traces submitted together when a traversal is requested, acted on the next frame */
+struct FClimbObstacleScan
+{
+	FTraceHandle CeilingHandle;
+	TArray<FTraceHandle, TInlineAllocator<8>> ColumnHandles;
+
+	/* Where the scan was traced from, heights in the profile are relative to these feet */
+	FVector FeetLocation = FVector::ZeroVector;
+	FVector UpVector = FVector::UpVector;
+
+	/* GFrameCounter value of the frame the scan was submitted on, zero when none is pending */
+	uint64 SubmitFrame = 0;
+};
+
+/* Ledge top found by looking ahead once, climbing then only compares heights against it */
+struct FClimbLedgeTrack
+{
+	/* Surface the lookahead was made on, any other one can have its top anywhere */
+	TWeakObjectPtr<UPrimitiveComponent> SurfaceComponent;
+	FVector SurfaceNormal = FVector::ZeroVector;
+
+	/* Where the lookahead was made from, moving sideways away from it looks again */
+	FVector ProbeLocation = FVector::ZeroVector;
+
+	/* Halfway up the lookahead, climbing past it without a ledge looks again */
+	FVector RefreshLocation = FVector::ZeroVector;
+
+	FVector LedgePoint = FVector::ZeroVector;
+	bool bHasLedge = false;
+	bool bValid = false;
+};
+
+/* How much work a climber gets per frame, picked by the significance manager */
+UENUM(BlueprintType)
+enum class EClimbLODTier : uint8
+{
+	/* Probe, rotate and snap every frame */
+	Full,
+	/* Probe every few frames and extrapolate along the last surface in between */
+	Reduced,
+	/* Slide along the last surface plane without sweeps, rotation or snap, probing rarely */
+	SurfaceLocked,
+	/* Not rendered, the climb does not tick at all */
+	Frozen
+};
+
+/* Per character class climb LOD distances and rates */
+USTRUCT(BlueprintType)
+struct FClimbLODSettings
+{
+	GENERATED_BODY()
+
+	/* Closer than this to any viewpoint climbs at full rate */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float ReducedDistance = 2000.f;
+
+	/* Further than this from every viewpoint climbs surface locked */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float SurfaceLockedDistance = 5000.f;
+
+	/* Frames between probes in the Reduced tier */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "1"))
+	int32 ReducedProbeInterval = 4;
+
+	/* Frames between probes in the SurfaceLocked tier, enough to notice the wall ending */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "1"))
+	int32 SurfaceLockedProbeInterval = 15;
+
+	/* Freeze climbers nobody has seen for this long, zero never freezes */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0"))
+	float FreezeAfterNotRenderedTime = 0.5f;
+
+	/* Animation budget significance of climbers hanging still, as a fraction of what their LOD tier gives */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float HangingAnimSignificanceScale = 0.1f;
+};
+
 /*
 
  */
@@ -31,36 +130,89 @@ class CLIMBINGSYSTEM_API UCustomMovementComponent : public UCharacterMovementCom
 {
 	GENERATED_BODY()
 
+	friend struct FClimbTestAccess;
+
 public:
 	FOnEnterClimbState OnEnterClimbStateDelegate;
 	FOnExitClimbState OnExitClimbStateDelegate;
 
 #pragma region OverridenFunctions
 protected:
+	virtual void PostLoad() override;
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction) override;
+	virtual void PerformMovement(float DeltaTime) override;
+	virtual void SimulatedTick(float DeltaSeconds) override;
 	virtual void OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode) override;
 	virtual void PhysCustom(float deltaTime, int32 Iterations) override;
 	virtual float GetMaxSpeed() const override;
 	virtual float GetMaxAcceleration() const override;
 	virtual FVector ConstrainAnimRootMotionVelocity(const FVector& RootMotionVelocity, const FVector& CurrentVelocity) const override;
+	virtual void UpdateFromCompressedFlags(uint8 Flags) override;
+	virtual void UpdateCharacterStateBeforeMovement(float DeltaSeconds) override;
+
+public:
+	virtual FNetworkPredictionData_Client* GetPredictionData_Client() const override;
 #pragma endregion
 
 #pragma region ClimbTraces
 private:
-	TArray<FHitResult> DoCapsuleTraceMultiByObject(const FVector& Start, const FVector& End, bool bShowDebugShape = false, bool bDrawPresistantShapes = false);
+	void DoCapsuleTraceMultiByObject(const FVector& Start, const FVector& End, TArray<FHitResult>& OutHits, bool bShowDebugShape = false, bool bDrawPresistantShapes = false);
 	
 	FHitResult DoLineTraceSingleByObject(const FVector& Start, const FVector& End, bool bShowDebugShape = false, bool bDrawPresistantShapes = false);
 
 	FHitResult TraceFromEyeHeight(float TraceDistance, float TraceStartOffset = 0.f,bool bShowDebugShape = false, bool bDrawPresistantShapes = false);
+
+	void InitClimbProfile();
+
+	void MigrateDeprecatedClimbTuning();
+
+	void BuildClimbQueryParams();
+
+	void ApplyClimbSurfaceRules();
+
+	void RecordClimbTraces(int32 NumTraces, int32 NumHits);
+
+	FTraceHandle SubmitAsyncClimbSweep(UWorld* World, const FVector& Start, const FVector& End) const;
+
+	FTraceHandle SubmitAsyncClimbLineTrace(UWorld* World, const FVector& Start, const FVector& End) const;
+
+	void SubmitAsyncClimbProbes();
+
+	bool ConsumeAsyncClimbProbes();
+
+	void ResetAsyncClimbProbes();
 #pragma endregion
 
 #pragma region ClimbCore
 	bool TraceClimableSurfaces();
 
-	bool CanStartClimbing();
+	void TraceClimbFloor();
+
+	void UpdateLedgeTrack();
+
+	bool NeedsLedgeLookahead(const FHitResult& SurfaceHit, const FVector& EyeLocation) const;
+
+	void RunClimbProbes();
+
+	FORCEINLINE bool HasClimbSolve() const { return ClimbSolve.SolveFrame == GFrameCounter; }
+
+	void RegisterClimbSignificance();
 
-	bool CanClimbDownLedge();
+	void UnregisterClimbSignificance();
+
+	EClimbLODTier CalculateClimbLODTier(const FTransform& Viewpoint) const;
+
+	bool ShouldProbeThisFrame() const;
+
+	EClimbSubState EvaluateClimbSubState() const;
+
+	FClimbReplicatedState BuildReplicatedClimbState() const;
+
+	void SmoothReplicatedClimbState(float DeltaTime);
+
+	bool CanStartClimbing();
 
 	void StartClimbing();
 
@@ -76,15 +228,59 @@ private:
 
 	bool CheckHasReachedLedge();
 
-	void TryStartVaulting();
+	UPrimitiveComponent* GetClimbedSurfaceComponent() const;
+
+	const UClimbLedgeGraph* GetLedgeGraphFor(const UPrimitiveComponent* Component) const;
+
+	bool QueryLedgeGraphForLedge(bool& bOutReachedLedge);
 
-	bool CanStartVaulting(FVector& OutVaultStartPos,FVector& OutVaultEndPos);
+	bool QueryMeshLedgeEdgesForLedge(bool& bOutReachedLedge);
+
+	bool ConfirmBakedLedge();
+
+	void TryStartObstacleTraversal();
+
+	void FinishObstacleTraversal();
+
+	void StartObstacleTraversal(const FClimbObstacleProfile& Obstacle);
+
+	void ScanObstacleProfile(FClimbObstacleProfile& OutProfile);
+
+	void SubmitObstacleScan();
+
+	bool ConsumeObstacleScan(FClimbObstacleProfile& OutProfile);
+
+	bool QueryLedgeGraphForObstacle(FClimbObstacleProfile& OutProfile) const;
 
 	FQuat GetClimbRotation(float DeltaTime);
 
 	void SnapMovementToClimableSurfaces(float DeltaTime);
+
+	void UpdateHangSleep(float DeltaTime);
+
+	bool ShouldWakeFromHangSleep(float DeltaTime);
+
+	void EnterHangSleep();
+
+	void WakeFromHangSleep();
 	
-	void PlayClimbMontage(UAnimMontage* MontageToPlay);
+	void PlayClimbMontage(const TSoftObjectPtr<UAnimMontage>& MontageToPlay);
+
+	void UpdateClimbMontageStreaming(float DeltaTime);
+
+	bool IsNearClimbableGeometry() const;
+
+	void RequestClimbMontages();
+
+	void ReleaseClimbMontages();
+
+	void UpdateClimbAnimProxy();
+
+	void UpdateClimbLimbs();
+
+	void ConsumeLimbTraces();
+
+	void UpdateAnimBudgetSignificance();
 
 	UFUNCTION()
 	void OnClimbMontageEnded(UAnimMontage* Montage, bool bInterrupted);
@@ -105,68 +301,295 @@ private:
 
 	TArray<FHitResult> ClimbableSurfacesTracedResults;
 
+	/* Grip of each hit in ClimbableSurfacesTracedResults from the surface rules, empty without rules */
+	TArray<float> ClimbableSurfaceGrips;
+
+	/* Speed multiplier of the surface rules under the climber, averaged over its hits */
+	float ClimbSurfaceSpeedMultiplier = 1.f;
+
 	FVector CurrentClimbableSurfaceLocation;
 
 	FVector CurrentClimbableSurfaceNormal;
 
+	/* Built once in BeginPlay, ignores the owner */
+	FCollisionQueryParams ClimbQueryParams;
+	FCollisionObjectQueryParams ClimbObjectQueryParams;
+	FCollisionShape ClimbCapsuleShape;
+
+	/* Cycles the last TickComponent spent, movement included */
+	uint64 LastTickCycles = 0;
+
+	/* Running totals of every climb trace this component issued and the hits they returned */
+	uint64 ClimbTracesIssued = 0;
+	uint64 ClimbTraceHitsReturned = 0;
+
+	/* Double buffer of async probes, indexed by frame parity */
+	FClimbProbeFrame AsyncProbeFrames[2];
+
+	bool bHasAsyncProbeResults = false;
+
+	/* Floor probe of the current climb tick, traced or read back from the async probes */
+	TArray<FHitResult> FloorTracedResults;
+
+	/* Overlaps of the last line trace on the Climbable channel, kept so its buffer is reused */
+	TArray<FHitResult> ClimbLineTraceHits;
+
+	/* Async trace results are copied out through these, kept so their buffers are reused */
+	FTraceDatum SurfaceTraceDatum;
+	FTraceDatum FloorTraceDatum;
+	FTraceDatum LimbTraceDatum;
+	FTraceDatum ObstacleTraceDatum;
+
+	/* Traversal request waiting on its obstacle scan */
+	FClimbObstacleScan ObstacleScan;
+
+	/* Hand and foot placement, refreshed every LimbRefreshInterval frames from the surface patch */
+	FClimbLimbTargets LimbTargets;
+
+	/* Per limb traces on uneven surfaces, submitted together on LimbTraceFrame and read back on a later one */
+	FTraceHandle LimbTraceHandles[static_cast<int32>(EClimbLimb::Num)];
+	uint64 LimbTraceFrame = 0;
+
+	/* Ledge ahead of the climb, looked for again only when the surface changes */
+	FClimbLedgeTrack LedgeTrack;
+
+	/* Set when the baked ledge data answered the ledge check and the ledge traces were skipped */
+	bool bLedgeAnsweredByBakedData = false;
+	bool bBakedLedgeReached = false;
+
+	/* Decisions the simulation subsystem solved for this frame, used once by PhysClimb */
+	FClimbSolveOutput ClimbSolve;
+
+	/* Current climb LOD, written by the significance manager's post significance callback */
+	EClimbLODTier ClimbLODTier = EClimbLODTier::Full;
+
+	/* Spreads the probe frames of reduced climbers so they do not all probe on the same frame */
+	uint32 ClimbLODFrameOffset = 0;
+
+	bool bRegisteredClimbSignificance = false;
+
+	/* Last significance handed to the animation budget allocator, only changes are sent */
+	float AnimBudgetSignificance = -1.f;
+	bool bAnimBudgetNeverSkip = false;
+
+	/* GFrameCounter value of the last probe, zero until the first probe of this climb */
+	uint64 LastClimbProbeFrame = 0;
+
+	/* Evaluated locally on the server and owner, replicated to simulated proxies */
+	EClimbSubState ClimbSubState = EClimbSubState::None;
+
+	/* Simulated proxies ease toward the last replicated climb state instead of tracing */
+	FVector ProxyTargetSurfaceNormal = FVector::ZeroVector;
+	FVector ProxyTargetClimbVelocity = FVector::ZeroVector;
+	FVector ProxyUnrotatedClimbVelocity = FVector::ZeroVector;
+
+	/* Anchored hang sleep, no probing while the climber hangs still */
+	bool bHangSleeping = false;
+	float HangStillTime = 0.f;
+	float HangSleepElapsed = 0.f;
+
+	/* Every primitive the climb was touching when it fell asleep, moving any of them wakes it */
+	struct FHangSleepAnchor
+	{
+		TWeakObjectPtr<UPrimitiveComponent> Component;
+		FTransform Transform;
+	};
+	TArray<FHangSleepAnchor, TInlineAllocator<4>> HangSleepAnchors;
+
 	UPROPERTY()
 	UAnimInstance* OwningPlayerAnimInstance;
 
+	/* OwningPlayerAnimInstance when it is ours, handed a fresh anim proxy every tick */
+	UPROPERTY()
+	UCharacterAnimInstance* CharacterAnimInstance;
+
 	UPROPERTY()
 	AClimbingSystemCharacter* OwningPlayerCharacter;
 
+	UPROPERTY()
+	UClimbLedgeGraphSubsystem* LedgeGraphSubsystem;
+
+	UPROPERTY()
+	UClimbingSimulationSubsystem* SimulationSubsystem;
+
+	/* Null when the project has no climb surface rules */
+	UPROPERTY()
+	UClimbSurfaceSubsystem* SurfaceSubsystem;
+
+	/* ClimbProfile, or the profile defaults when none is set */
+	UPROPERTY(Transient)
+	const UClimbProfile* ActiveClimbProfile;
+
+	/* Keeps the climb montages loaded while it lives, reset to let them go */
+	TSharedPtr<FStreamableHandle> ClimbMontageHandle;
+
+	/* Seconds until the next proximity check and of the release cooldown left */
+	float ClimbMontageProximityCheckTime = 0.f;
+	float ClimbMontageReleaseTime = 0.f;
+
 
 #pragma endregion
 
 #pragma region ClimbBPVariables
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"));
 	TArray<TEnumAsByte<EObjectTypeQuery>>ClimableSurfaceTraceTypes;
+
+	/* Shared climb tuning, the UClimbProfile defaults are used when none is set */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
+	UClimbProfile* ClimbProfile;
+
+	/* Tuning from before UClimbProfile, moved into a profile on load by MigrateDeprecatedClimbTuning */
+	UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Set it on ClimbProfile instead"))
+	float ClimbCapsuleTraceRadius_DEPRECATED = 50.f;
+
+	UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Set it on ClimbProfile instead"))
+	float ClimbCapsuleTraceHalfHeight_DEPRECATED = 72.f;
+
+	UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Set it on ClimbProfile instead"))
+	float MaxBreakClimbDeceleration_DEPRECATED = 400.f;
+
+	UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Set it on ClimbProfile instead"))
+	float MaxClimbSpeed_DEPRECATED = 100.f;
+
+	UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Set it on ClimbProfile instead"))
+	float MaxClimbAcceleration_DEPRECATED = 100.f;
+
+	UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Set it on ClimbProfile instead"))
+	float ClimbDownWalkableSurfaceTraceOffset_DEPRECATED = 100.f;
+
+	UPROPERTY(meta = (DeprecatedProperty, DeprecationMessage = "Set it on ClimbProfile instead"))
+	float ClimbDownLedgeTraceOffset_DEPRECATED = 50.f;
 	
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"));
-	float ClimbCapsuleTraceRadius = 50.f;
+	/* Trace the Climbable channel so only geometry that opted in is tested, instead of ClimableSurfaceTraceTypes */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
+	bool bTraceClimbableChannel = false;
 
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"));
-	float ClimbCapsuleTraceHalfHeight = 72.f;
+	/* Stop probing while hanging still with no input until input arrives or the surface moves */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
+	bool bEnableHangSleep = true;
 
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"));
-	float MaxBreakClimbDeceleration = 400.f;
+	/* Seconds of hanging still before going to sleep */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", EditCondition = "bEnableHangSleep", ClampMin = "0.0"))
+	float HangSleepDelay = 0.25f;
 
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"));
-	float MaxClimbSpeed = 100.f;
+	/* Seconds asleep before one full climb tick revalidates the surface */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", EditCondition = "bEnableHangSleep", ClampMin = "0.0"))
+	float HangSleepRevalidateInterval = 2.f;
 
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"));
-	float MaxClimbAcceleration = 100.f;
+	/* Submit climb probes asynchronously and consume them one frame late instead of tracing on the game thread */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
+	bool bUseAsyncClimbProbes = false;
 
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"));
-	float ClimbDownWalkableSurfaceTraceOffset = 100.f;
+	/* Solve the climb decisions in the world's batched simulation instead of one climber at a time */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
+	bool bUseBatchedClimbSimulation = false;
 
-	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"));
-	float ClimbDownLedgeTraceOffset = 50.f;
+	/* Place hands and feet on the wall for limb IK in the anim instance */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
+	bool bEnableClimbLimbIK = true;
+
+	/* Let the significance manager lower the climb rate of distant and unseen climbers, the game mode feeds it the player views */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
+	bool bEnableClimbLOD = false;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", EditCondition = "bEnableClimbLOD"))
+	FClimbLODSettings ClimbLODSettings;
+
+	/* How fast simulated proxies blend toward a newly replicated surface normal and climb velocity */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", ClampMin = "0.0"))
+	float ProxyClimbSmoothingSpeed = 12.f;
+
+	/* Start loading the climb montages when geometry on the Climbable channel is this close */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", ClampMin = "0.0"))
+	float ClimbMontagePreloadDistance = 1500.f;
+
+	/* Seconds between checks for climbable geometry nearby */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", ClampMin = "0.0"))
+	float ClimbMontageProximityCheckInterval = 0.5f;
+
+	/* Seconds away from climbable geometry before the climb montages are released */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", ClampMin = "0.0"))
+	float ClimbMontageReleaseDelay = 10.f;
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"));
-	UAnimMontage* IdleToClimbMontage;
+	TSoftObjectPtr<UAnimMontage> IdleToClimbMontage;
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"));
-	UAnimMontage* ClimbToTopMontage;
+	TSoftObjectPtr<UAnimMontage> ClimbToTopMontage;
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"));
-	UAnimMontage* ClimbDownLedgeMontage;
+	TSoftObjectPtr<UAnimMontage> ClimbDownLedgeMontage;
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"));
-	UAnimMontage* VaultMontage;
+	TSoftObjectPtr<UAnimMontage> VaultMontage;
+
+	/* Played over obstacles too low to vault, warped like VaultMontage. The vault montage is used when not set */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
+	TSoftObjectPtr<UAnimMontage> StepOverMontage;
+
+	/* Played to climb onto obstacles too deep to vault, warped to MantleTopPos. Mantling is off when not set */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
+	TSoftObjectPtr<UAnimMontage> MantleMontage;
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"));
-	UAnimMontage* HopUpMontage;
+	TSoftObjectPtr<UAnimMontage> HopUpMontage;
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"));
-	UAnimMontage* HopDownMontage;
+	TSoftObjectPtr<UAnimMontage> HopDownMontage;
 
 #pragma endregion
 
 public:
+	/* Climb toggle and hop requests from input, sent with the next saved move and run inside the move on client and server */
+	bool bWantsToToggleClimb = false;
+	bool bWantsToHop = false;
+
+	void RequestClimbToggle();
+	void RequestClimbHop();
 	void ToggleClimbing(bool bEnableClimb);
+	/* Enter the climb state right away, without the idle to climb montage */
+	void ForceStartClimbing();
 	void RequestHopping();
 	bool IsClimbing() const;
+	FORCEINLINE bool IsUsingAsyncClimbProbes() const {return bUseAsyncClimbProbes;}
+	FORCEINLINE bool IsHangSleeping() const {return bHangSleeping;}
+	FORCEINLINE EClimbLODTier GetClimbLODTier() const {return ClimbLODTier;}
+	FORCEINLINE EClimbSubState GetClimbSubState() const {return ClimbSubState;}
+	FORCEINLINE uint64 GetClimbTracesIssued() const {return ClimbTracesIssued;}
+	FORCEINLINE uint64 GetClimbTraceHitsReturned() const {return ClimbTraceHitsReturned;}
+	FORCEINLINE uint64 GetLastTickCycles() const {return LastTickCycles;}
+	const UClimbProfile* GetClimbProfile() const;
+	void ApplyReplicatedClimbState(const FClimbReplicatedState& State);
+	void SetUseAsyncClimbProbes(bool bEnable);
+	/* Probe and append this climber to the batch, returns false if it has nothing to solve this frame */
+	bool GatherClimbSolveInput(FClimbSolveBatch& Batch, float DeltaTime);
+	void SetClimbSolveOutput(const FClimbSolveOutput& Output);
 	FORCEINLINE FVector GetClimbableSurfaceNormal() const {return CurrentClimbableSurfaceNormal;}
 	FVector GetUnrotatedClimbVelocity() const;
 };
+
+/* Saved move carrying the climb toggle and hop requests, so they are predicted and replayed */
+class CLIMBINGSYSTEM_API FSavedMove_Climb : public FSavedMove_Character
+{
+public:
+	typedef FSavedMove_Character Super;
+
+	uint8 bSavedWantsToToggleClimb : 1;
+	uint8 bSavedWantsToHop : 1;
+
+	virtual void Clear() override;
+	virtual uint8 GetCompressedFlags() const override;
+	virtual bool CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* InCharacter, float MaxDelta) const override;
+	virtual void SetMoveFor(ACharacter* C, float InDeltaTime, FVector const& NewAccel, FNetworkPredictionData_Client_Character& ClientData) override;
+	virtual void PrepMoveFor(ACharacter* C) override;
+};
+
+class CLIMBINGSYSTEM_API FNetworkPredictionData_Client_Climb : public FNetworkPredictionData_Client_Character
+{
+public:
+	typedef FNetworkPredictionData_Client_Character Super;
+
+	FNetworkPredictionData_Client_Climb(const UCharacterMovementComponent& ClientMovement);
+
+	virtual FSavedMovePtr AllocateNewMove() override;
+};
@@ -0,0 +1,55 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/AssetUserData.h"
+#include "ClimbLedgeEdgeUserData.generated.h"
+
+class UStaticMesh;
+
+/** Convex edge between a walkable top face and a wall face, in mesh space */
+USTRUCT()
+struct FClimbMeshLedgeEdge
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FVector3f Start = FVector3f::ZeroVector;
+
+	UPROPERTY()
+	FVector3f End = FVector3f::ZeroVector;
+
+	/** Outward normal of the wall face below the edge */
+	UPROPERTY()
+	FVector3f WallNormal = FVector3f::ZeroVector;
+
+	/** Normal of the walkable top face */
+	UPROPERTY()
+	FVector3f TopNormal = FVector3f::ZeroVector;
+};
+
+/**
+ * Ledge edges extracted from a static mesh's simple collision, stored on the mesh so every
+ * component and instance of it shares one cache. Built by UClimbLedgeEdgeCommandlet.
+ */
+UCLASS()
+class CLIMBINGSYSTEM_API UClimbLedgeEdgeUserData : public UAssetUserData
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(VisibleAnywhere, Category = "Climbing")
+	TArray<FClimbMeshLedgeEdge> Edges;
+
+	/**
+	 * Closest edge within MaxDistance ahead with its top in [MinZ, MaxZ], edges are moved by MeshToWorld first.
+	 * Everything but Edges is in world space.
+	 */
+	bool FindLedge(const FTransform& MeshToWorld, const FVector& Location, const FVector& Forward, float MaxDistance, float MinZ, float MaxZ, FVector& OutLedgePoint) const;
+
+#if WITH_EDITOR
+	/** Extract the ledge edges of a mesh's box and convex collision, returns false if it has none */
+	bool BuildFromStaticMesh(const UStaticMesh* StaticMesh);
+#endif
+};
@@ -0,0 +1,140 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "ClimbLedgeGraph.generated.h"
+
+/** Walkable top edge of a climbable wall */
+USTRUCT()
+struct FClimbLedgeSegment
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FVector3f Start = FVector3f::ZeroVector;
+
+	UPROPERTY()
+	FVector3f End = FVector3f::ZeroVector;
+
+	/** Outward normal of the wall below the edge */
+	UPROPERTY()
+	FVector3f WallNormal = FVector3f::ZeroVector;
+
+	/** Height of the wall face below the edge */
+	UPROPERTY()
+	float Drop = 0.f;
+};
+
+/** Vertical climbable rectangle */
+USTRUCT()
+struct FClimbWallPatch
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FVector3f Center = FVector3f::ZeroVector;
+
+	/** Outward normal, always horizontal */
+	UPROPERTY()
+	FVector3f Normal = FVector3f::ZeroVector;
+
+	/** Half width along the wall and half height */
+	UPROPERTY()
+	FVector2f HalfExtents = FVector2f::ZeroVector;
+};
+
+/** Thin obstacle that can be vaulted from the side facing Normal */
+USTRUCT()
+struct FClimbVaultSpan
+{
+	GENERATED_BODY()
+
+	/** Top edge on the approach side */
+	UPROPERTY()
+	FVector3f Start = FVector3f::ZeroVector;
+
+	UPROPERTY()
+	FVector3f End = FVector3f::ZeroVector;
+
+	/** Outward normal of the approach side */
+	UPROPERTY()
+	FVector3f Normal = FVector3f::ZeroVector;
+
+	/** Thickness of the obstacle along -Normal */
+	UPROPERTY()
+	float Depth = 0.f;
+
+	/** Ground height behind the obstacle */
+	UPROPERTY()
+	float LandingZ = 0.f;
+};
+
+/**
+ * Level-wide climb geometry baked by UClimbLedgeGraphCommandlet.
+ * Elements live in flat arrays and a uniform XY grid maps each cell to every element within query reach,
+ * so a query only ever walks the items of the single cell the climber stands in.
+ */
+UCLASS()
+class CLIMBINGSYSTEM_API UClimbLedgeGraph : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	enum class EItemKind : uint32
+	{
+		Ledge = 0,
+		Wall = 1,
+		Vault = 2
+	};
+
+	UPROPERTY()
+	TArray<FClimbLedgeSegment> Ledges;
+
+	UPROPERTY()
+	TArray<FClimbWallPatch> WallPatches;
+
+	UPROPERTY()
+	TArray<FClimbVaultSpan> VaultSpans;
+
+	/** Primitives this graph was baked from, see UClimbLedgeGraphSubsystem::GetBakedComponentKey */
+	UPROPERTY()
+	TArray<FName> BakedComponentPaths;
+
+	/** Rebuild the grid from the element arrays, every element is registered in each cell within QueryReach of it */
+	void BuildSpatialIndex(float InCellSize, float QueryReach);
+
+	/** Ledge edge within MaxDistance ahead with its top in [MinZ, MaxZ], approached from the wall or from the walkable top */
+	const FClimbLedgeSegment* FindLedge(const FVector& Location, const FVector& Forward, float MaxDistance, float MinZ, float MaxZ, bool bFromWallSide, FVector& OutLedgePoint) const;
+
+	/** Wall patch ahead within MaxDistance covering the height range [MinZ, MaxZ] */
+	const FClimbWallPatch* FindWall(const FVector& Location, const FVector& Forward, float MaxDistance, float MinZ, float MaxZ, FVector& OutWallPoint) const;
+
+	/** Vault span ahead within MaxDistance with its top in [MinZ, MaxZ] */
+	const FClimbVaultSpan* FindVault(const FVector& Location, const FVector& Forward, float MaxDistance, float MinZ, float MaxZ, FVector& OutTopPoint) const;
+
+private:
+	UPROPERTY()
+	FVector2f GridOrigin = FVector2f::ZeroVector;
+
+	UPROPERTY()
+	FIntPoint GridDims = FIntPoint::ZeroValue;
+
+	UPROPERTY()
+	float CellSize = 200.f;
+
+	/** Offsets into CellItems, one per cell plus a terminator */
+	UPROPERTY()
+	TArray<int32> CellOffsets;
+
+	/** Packed element references, kind in the top two bits and index in the rest */
+	UPROPERTY()
+	TArray<uint32> CellItems;
+
+	TArrayView<const uint32> GetCellItems(const FVector& Location) const;
+
+	static uint32 PackItem(EItemKind Kind, int32 Index) { return (static_cast<uint32>(Kind) << 30) | static_cast<uint32>(Index); }
+	static EItemKind UnpackKind(uint32 Item) { return static_cast<EItemKind>(Item >> 30); }
+	static int32 UnpackIndex(uint32 Item) { return static_cast<int32>(Item & 0x3FFFFFFF); }
+};
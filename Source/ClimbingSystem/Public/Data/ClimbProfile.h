@@ -0,0 +1,225 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Climbing/ClimbObstacle.h"
+#include "Climbing/ClimbLimbs.h"
+#include "ClimbProfile.generated.h"
+
+/**
+ * What the climb tick reads from a profile, derived once when the profile is loaded or edited.
+ * Plain data so the batched solve can read it from worker threads.
+ */
+struct FClimbProfileConstants
+{
+	/* A surface whose normal has at least this dot with up is too flat to climb */
+	float TooFlatSurfaceUpDot = 0.5f;
+
+	float MinVerticalClimbSpeed = 10.f;
+	float RotationInterpSpeed = 5.f;
+
+	/* Probe shapes in component space, rotate by the component rotation and add to its location */
+	FVector SurfaceSweepStart = FVector::ZeroVector;
+	FVector SurfaceSweepEnd = FVector::ZeroVector;
+	FVector FloorSweepStart = FVector::ZeroVector;
+	FVector FloorSweepEnd = FVector::ZeroVector;
+
+	/* A tracked ledge top at most this far above the eyes is reached */
+	float LedgeReachHeight = 50.f;
+
+	/* Ledge lookahead trace in component space relative to eye height, the start is raised by the lookahead height */
+	FVector LedgeLookaheadStart = FVector::ZeroVector;
+	FVector LedgeLookaheadEnd = FVector::ZeroVector;
+
+	/* The tracked ledge is looked for again once the surface normal turns to less than this dot with the one it was found on */
+	float LedgeTrackSurfaceDot = 0.966f;
+
+	FClimbObstacleRules ObstacleRules;
+
+	/* Where each limb rests in component space, indexed by EClimbLimb */
+	FVector LimbRestOffsets[static_cast<int32>(EClimbLimb::Num)];
+
+	/* Surface contacts within this dot of their mean normal and LimbPatchMaxOffset of their plane count as one flat patch */
+	float LimbPatchNormalDot = 0.985f;
+};
+
+/**
+ * Climb tuning shared by every character that climbs the same way.
+ * Movement components and crowd configs without one climb with the class defaults.
+ */
+UCLASS(BlueprintType)
+class CLIMBINGSYSTEM_API UClimbProfile : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Surface", meta = (ClampMin = "0.0"))
+	float ClimbCapsuleTraceRadius = 50.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Surface", meta = (ClampMin = "0.0"))
+	float ClimbCapsuleTraceHalfHeight = 72.f;
+
+	/* How far in front of the character the surface sweep starts */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Surface")
+	float SurfaceTraceForwardOffset = 30.f;
+
+	/* Surfaces closer to flat than this many degrees from straight up end the climb */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Surface", meta = (ClampMin = "0.0", ClampMax = "90.0", Units = "Degrees"))
+	float MinClimbableSurfaceAngle = 60.f;
+
+	/* How far below the character the floor sweep starts */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Surface")
+	float FloorTraceDownOffset = 50.f;
+
+	/* Vertical climb speed the floor and ledge checks need before they end the climb */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Surface", meta = (ClampMin = "0.0"))
+	float MinVerticalClimbSpeed = 10.f;
+
+	/* How far ahead of the eyes the climb start, ledge and hop traces look */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ledge", meta = (ClampMin = "0.0"))
+	float EyeTraceDistance = 100.f;
+
+	/* Height above the eyes a ledge has to be below before it can be climbed onto */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ledge")
+	float LedgeTraceHeight = 50.f;
+
+	/* How far below the reach height a walkable top is still taken as the ledge */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ledge", meta = (ClampMin = "0.0"))
+	float LedgeWalkableTraceDepth = 100.f;
+
+	/* Seconds of climbing up the ledge lookahead covers, it looks again halfway through */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ledge", meta = (ClampMin = "0.0", Units = "Seconds"))
+	float LedgeLookaheadTime = 2.f;
+
+	/* The lookahead covers at least this much height above the reach height, even when not climbing up */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ledge", meta = (ClampMin = "1.0"))
+	float LedgeLookaheadMinHeight = 100.f;
+
+	/* Moving this far sideways along the wall looks for the ledge again */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ledge", meta = (ClampMin = "0.0"))
+	float LedgeTrackRefreshDistance = 50.f;
+
+	/* Turning onto a surface this many degrees off the one the ledge was found on looks for it again */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ledge", meta = (ClampMin = "0.0", ClampMax = "90.0", Units = "Degrees"))
+	float LedgeTrackMaxSurfaceTurn = 15.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Climb Down")
+	float ClimbDownWalkableSurfaceTraceOffset = 100.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Climb Down")
+	float ClimbDownLedgeTraceOffset = 50.f;
+
+	/* A drop that the ledge trace does not reach the bottom of can be climbed down */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Climb Down", meta = (ClampMin = "0.0"))
+	float ClimbDownLedgeTraceDepth = 200.f;
+
+	/* How far ahead of the character the obstacle scan reaches */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Obstacle", meta = (ClampMin = "0.0"))
+	float ObstacleScanDistance = 250.f;
+
+	/* Height above the feet the obstacle scan starts at, anything taller is a wall */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Obstacle", meta = (ClampMin = "0.0"))
+	float ObstacleScanHeight = 200.f;
+
+	/* Downward traces spread evenly over the scan distance */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Obstacle", meta = (ClampMin = "2", ClampMax = "32"))
+	int32 ObstacleScanColumns = 8;
+
+	/* Bumps lower than this do not count as an obstacle */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Obstacle", meta = (ClampMin = "0.0"))
+	float MinObstacleHeight = 10.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Obstacle", meta = (ClampMin = "0.0"))
+	float MaxStepOverHeight = 60.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Obstacle", meta = (ClampMin = "0.0"))
+	float MaxVaultHeight = 150.f;
+
+	/* Longer obstacles are mantled onto instead of vaulted over */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Obstacle", meta = (ClampMin = "0.0"))
+	float MaxVaultDepth = 150.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Obstacle", meta = (ClampMin = "0.0"))
+	float MaxMantleHeight = 180.f;
+
+	/* Free height needed above an obstacle to get over or onto it */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Obstacle", meta = (ClampMin = "0.0"))
+	float MinObstacleClearance = 20.f;
+
+	/* Hands rest this far to each side of the capsule center and this high above it */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Limbs", meta = (ClampMin = "0.0"))
+	float HandSpread = 25.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Limbs")
+	float HandHeight = 60.f;
+
+	/* Feet rest this far to each side of the capsule center and this high above it */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Limbs", meta = (ClampMin = "0.0"))
+	float FootSpread = 15.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Limbs")
+	float FootHeight = -70.f;
+
+	/* How far into the wall the limb traces reach on uneven surfaces */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Limbs", meta = (ClampMin = "0.0"))
+	float LimbTraceDepth = 100.f;
+
+	/* Frames between limb placements, the body still moves every frame */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Limbs", meta = (ClampMin = "1"))
+	int32 LimbRefreshInterval = 3;
+
+	/* Surface contacts turned further apart than this are not one flat patch and get a trace per limb */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Limbs", meta = (ClampMin = "0.0", ClampMax = "90.0", Units = "Degrees"))
+	float LimbPatchMaxAngle = 10.f;
+
+	/* Surface contacts further than this off their common plane are not one flat patch */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Limbs", meta = (ClampMin = "0.0"))
+	float LimbPatchMaxOffset = 5.f;
+
+	/* Height relative to the eyes of the wall a hop up lands on */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hop")
+	float HopUpTargetHeight = -20.f;
+
+	/* Height relative to the eyes the wall has to reach above a hop up */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hop")
+	float HopUpClearanceHeight = 150.f;
+
+	/* Height relative to the eyes of the wall a hop down lands on */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Hop")
+	float HopDownTargetHeight = -300.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement", meta = (ClampMin = "0.0"))
+	float MaxClimbSpeed = 100.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement", meta = (ClampMin = "0.0"))
+	float MaxClimbAcceleration = 100.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement", meta = (ClampMin = "0.0"))
+	float MaxBreakClimbDeceleration = 400.f;
+
+	/* How fast the character turns to face a new surface */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement", meta = (ClampMin = "0.0"))
+	float RotationInterpSpeed = 5.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Capsule", meta = (ClampMin = "0.0"))
+	float ClimbingCapsuleHalfHeight = 48.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Capsule", meta = (ClampMin = "0.0"))
+	float StandingCapsuleHalfHeight = 96.f;
+
+	virtual void PostInitProperties() override;
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	/** Derive the constants from the tuning above, call again after changing it at runtime */
+	void BakeConstants();
+
+	FORCEINLINE const FClimbProfileConstants& GetConstants() const { return Constants; }
+
+private:
+	FClimbProfileConstants Constants;
+};
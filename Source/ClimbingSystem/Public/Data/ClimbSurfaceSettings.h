@@ -0,0 +1,56 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "ClimbSurfaceSettings.generated.h"
+
+class UPhysicalMaterial;
+
+UENUM(BlueprintType)
+enum class EClimbSurfaceClass : uint8
+{
+	Climbable,
+	/* Glass, ice and the like, hits on it are dropped before the climb looks at them */
+	NotClimbable
+};
+
+/** How a surface climbs, resolved once per primitive and physical material by UClimbSurfaceSubsystem */
+USTRUCT(BlueprintType)
+struct FClimbSurfaceRule
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Climb Surface")
+	EClimbSurfaceClass SurfaceClass = EClimbSurfaceClass::Climbable;
+
+	/* Scales the max climb speed while on it, above 1 for ladders and the like */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Climb Surface", meta = (ClampMin = "0.0"))
+	float SpeedMultiplier = 1.f;
+
+	/* Scales how much its contacts count towards the surface the climber holds on to */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Climb Surface", meta = (ClampMin = "0.0"))
+	float GripMultiplier = 1.f;
+};
+
+/**
+ * Project wide climb surface rules, found under Project Settings as Climb Surfaces.
+ * A component tag rule wins over the physical material rule, anything without a rule climbs as before.
+ */
+UCLASS(config = Game, defaultconfig, meta = (DisplayName = "Climb Surfaces"))
+class CLIMBINGSYSTEM_API UClimbSurfaceSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	/* Rules by the physical material of the hit face, needs the climb traces to return physical materials */
+	UPROPERTY(Config, EditAnywhere, Category = "Rules")
+	TMap<TSoftObjectPtr<UPhysicalMaterial>, FClimbSurfaceRule> PhysicalMaterialRules;
+
+	/* Rules by a tag on the hit primitive, for one off surfaces such as a ladder mesh */
+	UPROPERTY(Config, EditAnywhere, Category = "Rules")
+	TMap<FName, FClimbSurfaceRule> ComponentTagRules;
+
+	FORCEINLINE bool HasRules() const { return !PhysicalMaterialRules.IsEmpty() || !ComponentTagRules.IsEmpty(); }
+};
@@ -0,0 +1,86 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTypes.h"
+#include "WorldCollision.h"
+#include "Engine/EngineTypes.h"
+#include "Data/ClimbProfile.h"
+#include "ClimbingCrowdFragments.generated.h"
+
+class AClimbingSystemCharacter;
+
+/** Marks entities simulated by UClimbingCrowdProcessor */
+USTRUCT()
+struct CLIMBINGSYSTEM_API FClimbingCrowdTag : public FMassTag
+{
+	GENERATED_BODY()
+};
+
+/** Averaged normal of the climbable surface in front of the entity */
+USTRUCT()
+struct CLIMBINGSYSTEM_API FClimbSurfaceNormalFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FVector Normal = FVector::ZeroVector;
+};
+
+/** Averaged impact point of the climbable surface in front of the entity */
+USTRUCT()
+struct CLIMBINGSYSTEM_API FClimbSurfacePointFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FVector Point = FVector::ZeroVector;
+};
+
+/** Desired climb velocity along the wall, X to the right and Y up */
+USTRUCT()
+struct CLIMBINGSYSTEM_API FClimbVelocityFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FVector2f SurfaceVelocity = FVector2f::ZeroVector;
+};
+
+/** Surface probe submitted last frame, read back on the next one */
+USTRUCT()
+struct CLIMBINGSYSTEM_API FClimbProbeFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	FTraceHandle PendingHandle;
+
+	uint64 SubmitFrame = 0;
+};
+
+/** Climb tuning shared by every entity of a crowd config, mirrors UCustomMovementComponent */
+USTRUCT()
+struct CLIMBINGSYSTEM_API FClimbCrowdParameters : public FMassSharedFragment
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Climbing")
+	TArray<TEnumAsByte<EObjectTypeQuery>> ClimableSurfaceTraceTypes;
+
+	UPROPERTY(EditAnywhere, Category = "Climbing")
+	bool bTraceClimbableChannel = false;
+
+	/* Same tuning the characters climb with, the UClimbProfile defaults are used when none is set */
+	UPROPERTY(EditAnywhere, Category = "Climbing")
+	TObjectPtr<const UClimbProfile> ClimbProfile;
+
+	/** Character spawned in place of the entity once a player comes within PromotionDistance */
+	UPROPERTY(EditAnywhere, Category = "Promotion")
+	TSubclassOf<AClimbingSystemCharacter> PromotedCharacterClass;
+
+	UPROPERTY(EditAnywhere, Category = "Promotion")
+	float PromotionDistance = 3000.f;
+
+	const UClimbProfile* GetClimbProfile() const { return ClimbProfile ? ClimbProfile.Get() : GetDefault<UClimbProfile>(); }
+};
@@ -0,0 +1,48 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassProcessor.h"
+#include "MassEntityQuery.h"
+#include "ClimbingCrowdProcessor.generated.h"
+
+/**
+ * Runs the PhysClimb rules over every crowd climber: surface averaging, the slope stop, the rotation and the snap.
+ * Surface probes go out as one batch of async sweeps and are read back the next frame.
+ * An entity whose probe comes back without a climbable surface is destroyed, the crowd has no falling.
+ */
+UCLASS()
+class CLIMBINGSYSTEM_API UClimbingCrowdProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	UClimbingCrowdProcessor();
+
+protected:
+	virtual void ConfigureQueries() override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+	FMassEntityQuery EntityQuery;
+};
+
+/**
+ * Swaps crowd climbers near a player for full AClimbingSystemCharacter actors.
+ */
+UCLASS()
+class CLIMBINGSYSTEM_API UClimbingCrowdPromotionProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	UClimbingCrowdPromotionProcessor();
+
+protected:
+	virtual void ConfigureQueries() override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+	FMassEntityQuery EntityQuery;
+};
@@ -0,0 +1,27 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTraitBase.h"
+#include "Mass/ClimbingCrowdFragments.h"
+#include "ClimbingCrowdTrait.generated.h"
+
+/**
+ * Makes a Mass entity a lightweight climber, add it to an entity config used by a Mass spawner.
+ */
+UCLASS(meta = (DisplayName = "Climbing Crowd"))
+class CLIMBINGSYSTEM_API UClimbingCrowdTrait : public UMassEntityTraitBase
+{
+	GENERATED_BODY()
+
+protected:
+	virtual void BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, const UWorld& World) const override;
+
+	UPROPERTY(EditAnywhere, Category = "Climbing")
+	FClimbCrowdParameters Parameters;
+
+	/** Initial climb velocity along the wall, X to the right and Y up */
+	UPROPERTY(EditAnywhere, Category = "Climbing")
+	FVector2f InitialSurfaceVelocity = FVector2f(0.f, 100.f);
+};
@@ -0,0 +1,43 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ClimbLedgeGraphSubsystem.generated.h"
+
+class UClimbLedgeGraph;
+class UPrimitiveComponent;
+
+/**
+ * Loads the baked ledge graph of the current map and tells climbers which primitives it covers.
+ * Graphs live at /Game/Climbing/LedgeGraphs/<MapName>_LedgeGraph, see UClimbLedgeGraphCommandlet.
+ */
+UCLASS()
+class CLIMBINGSYSTEM_API UClimbLedgeGraphSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	FORCEINLINE const UClimbLedgeGraph* GetLedgeGraph() const { return LedgeGraph; }
+
+	/** True if the graph was baked from this primitive, so climbers ask the graph before tracing it */
+	bool IsComponentBaked(const UPrimitiveComponent* Component) const;
+
+	static FString GetLedgeGraphPackageName(const FString& MapName);
+
+	/** Package of the primitive's level plus its path inside that level, the same in the editor, in PIE and for streamed levels */
+	static FName GetBakedComponentKey(const UPrimitiveComponent* Component);
+
+private:
+	UPROPERTY()
+	UClimbLedgeGraph* LedgeGraph;
+
+	TSet<FName> BakedComponentPaths;
+
+	/** Per primitive answer of IsComponentBaked, the path lookup only happens once per primitive */
+	mutable TMap<TObjectKey<UPrimitiveComponent>, bool> BakedComponentCache;
+};
@@ -0,0 +1,53 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Data/ClimbSurfaceSettings.h"
+#include "ClimbSurfaceSubsystem.generated.h"
+
+class UActorComponent;
+class UPhysicalMaterial;
+class UPrimitiveComponent;
+struct FHitResult;
+
+/**
+ * Answers which climb surface rule a trace hit falls under, see UClimbSurfaceSettings.
+ * Rules are derived from tags and physical materials once per primitive and material and cached,
+ * a primitive's entries are dropped whenever its physics state is created or destroyed.
+ * Only exists when the project has rules, so climbers without it skip the lookup entirely.
+ */
+UCLASS()
+class CLIMBINGSYSTEM_API UClimbSurfaceSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** Rule of the primitive and face physical material the hit is on */
+	FClimbSurfaceRule GetSurfaceRule(const FHitResult& Hit);
+
+private:
+	FClimbSurfaceRule ResolveSurfaceRule(const UPrimitiveComponent* Component, const UPhysicalMaterial* PhysMaterial) const;
+
+	void InvalidateComponent(UActorComponent* Component);
+
+	struct FCachedSurfaceRule
+	{
+		TObjectKey<UPhysicalMaterial> PhysMaterial;
+		FClimbSurfaceRule Rule;
+	};
+
+	/* Per primitive, one entry per face material seen on it, usually just the one */
+	TMap<TObjectKey<UPrimitiveComponent>, TArray<FCachedSurfaceRule, TInlineAllocator<2>>> SurfaceRuleCache;
+
+	/* The settings' material rules with their materials loaded */
+	TMap<TObjectKey<UPhysicalMaterial>, FClimbSurfaceRule> PhysicalMaterialRules;
+
+	FDelegateHandle CreatePhysicsHandle;
+	FDelegateHandle DestroyPhysicsHandle;
+};
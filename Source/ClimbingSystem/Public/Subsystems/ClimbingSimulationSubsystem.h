@@ -0,0 +1,77 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Climbing/ClimbSolve.h"
+#include "ClimbingSimulationSubsystem.generated.h"
+
+class UCustomMovementComponent;
+class UClimbingSimulationSubsystem;
+
+/** Pre physics tick of the simulation subsystem, registered climbers tick after it */
+USTRUCT()
+struct FClimbingSimulationTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	UClimbingSimulationSubsystem* Subsystem = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+	virtual FName DiagnosticContext(bool bDetailed) override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FClimbingSimulationTickFunction> : public TStructOpsTypeTraitsBase2<FClimbingSimulationTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+/**
+ * Runs the climb decisions of every registered climber as one batch before their movement ticks.
+ * Probes are gathered serially, the surface reduction, stop/floor/ledge decisions and rotation run in a ParallelFor,
+ * and each climber's PhysClimb applies the results in its own serial MoveComponent pass, snapping from where it moved to.
+ */
+UCLASS()
+class CLIMBINGSYSTEM_API UClimbingSimulationSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+
+	/** Solve this climber in the batch from now on, called when it enters the climb */
+	void RegisterClimber(UCustomMovementComponent* Climber);
+
+	void UnregisterClimber(UCustomMovementComponent* Climber);
+
+	FORCEINLINE int32 GetNumClimbers() const { return Climbers.Num(); }
+
+	/** Cycles the last Simulate spent in its serial gather and hand out, and in the parallel solve */
+	FORCEINLINE uint64 GetLastSerialCycles() const { return LastSerialCycles; }
+	FORCEINLINE uint64 GetLastParallelCycles() const { return LastParallelCycles; }
+
+	void Simulate(float DeltaTime);
+
+private:
+	UPROPERTY()
+	TArray<UCustomMovementComponent*> Climbers;
+
+	/* Climbers that made it into this frame's batch, in batch order */
+	TArray<UCustomMovementComponent*> BatchClimbers;
+
+	/* Kept between frames so the batch does not reallocate */
+	FClimbSolveBatch Batch;
+
+	FClimbingSimulationTickFunction SimulationTickFunction;
+
+	uint64 LastSerialCycles = 0;
+	uint64 LastParallelCycles = 0;
+};
@@ -11,5 +11,7 @@ public class ClimbingSystemEditorTarget : TargetRules
 		DefaultBuildSettings = BuildSettingsVersion.V2;
 		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_1;
 		ExtraModuleNames.Add("ClimbingSystem");
+		ExtraModuleNames.Add("ClimbingSystemEditor");
+		ExtraModuleNames.Add("ClimbingSystemSoak");
 	}
 }
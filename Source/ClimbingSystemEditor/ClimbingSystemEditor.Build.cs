@@ -0,0 +1,22 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class ClimbingSystemEditor : ModuleRules
+{
+	public ClimbingSystemEditor(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(new string[] { 
+			"Core", 
+			"CoreUObject", 
+			"Engine", 
+			"ClimbingSystem" });
+
+		PrivateDependencyModuleNames.AddRange(new string[] { 
+			"UnrealEd",
+			"AssetRegistry",
+			"PhysicsCore" });
+	}
+}
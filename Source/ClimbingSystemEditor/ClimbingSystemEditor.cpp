@@ -0,0 +1,6 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Modules/ModuleManager.h"
+
+// Editor only tooling for the climbing system, the bake commandlets live here so cooked builds never carry them
+IMPLEMENT_MODULE(FDefaultModuleImpl, ClimbingSystemEditor);
@@ -0,0 +1,114 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Commandlets/ClimbLedgeEdgeCommandlet.h"
+#include "Data/ClimbLedgeEdgeUserData.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/StaticMesh.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogClimbLedgeEdge, Log, All);
+
+namespace
+{
+    // Whether the edges already stored on a mesh match a fresh build, no stored data and no edges match as well
+    bool HaveSameEdges(const UClimbLedgeEdgeUserData* Stored, const UClimbLedgeEdgeUserData* Built)
+    {
+        const TArray<FClimbMeshLedgeEdge> NoEdges;
+        const TArray<FClimbMeshLedgeEdge>& StoredEdges = Stored ? Stored->Edges : NoEdges;
+        if(StoredEdges.Num() != Built->Edges.Num()) return false;
+
+        for(int32 Index = 0; Index < StoredEdges.Num(); ++Index)
+        {
+            const FClimbMeshLedgeEdge& A = StoredEdges[Index];
+            const FClimbMeshLedgeEdge& B = Built->Edges[Index];
+            if(A.Start != B.Start || A.End != B.End || A.WallNormal != B.WallNormal || A.TopNormal != B.TopNormal) return false;
+        }
+        return true;
+    }
+}
+
+UClimbLedgeEdgeCommandlet::UClimbLedgeEdgeCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UClimbLedgeEdgeCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+    FString RootPath = TEXT("/Game");
+    FParse::Value(*Params, TEXT("Path="), RootPath);
+
+    IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    AssetRegistry.SearchAllAssets(true);
+
+    FARFilter Filter;
+    Filter.ClassPaths.Add(UStaticMesh::StaticClass()->GetClassPathName());
+    Filter.PackagePaths.Add(FName(*RootPath));
+    Filter.bRecursivePaths = true;
+
+    TArray<FAssetData> MeshAssets;
+    AssetRegistry.GetAssets(Filter, MeshAssets);
+
+    int32 NumMeshesWithEdges = 0;
+    int32 NumSavedMeshes = 0;
+    int32 NumFailedSaves = 0;
+    for(const FAssetData& MeshAsset : MeshAssets)
+    {
+        UStaticMesh* StaticMesh = Cast<UStaticMesh>(MeshAsset.GetAsset());
+        if(!StaticMesh) continue;
+
+        // Always rebuild from scratch so meshes that lost their ledges lose the cache as well
+        UClimbLedgeEdgeUserData* BuiltEdges = NewObject<UClimbLedgeEdgeUserData>(GetTransientPackage());
+        const bool bHasEdges = BuiltEdges->BuildFromStaticMesh(StaticMesh);
+        if(bHasEdges)
+        {
+            ++NumMeshesWithEdges;
+        }
+
+        // Rebuilding is deterministic, so a mesh whose collision did not change gets the same edges and its package is left alone
+        UClimbLedgeEdgeUserData* UserData = StaticMesh->GetAssetUserData<UClimbLedgeEdgeUserData>();
+        if(HaveSameEdges(UserData, BuiltEdges)) continue;
+
+        StaticMesh->Modify();
+        if(!bHasEdges)
+        {
+            StaticMesh->RemoveUserDataOfClass(UClimbLedgeEdgeUserData::StaticClass());
+        }
+        else if(UserData)
+        {
+            UserData->Edges = MoveTemp(BuiltEdges->Edges);
+        }
+        else
+        {
+            UserData = NewObject<UClimbLedgeEdgeUserData>(StaticMesh);
+            UserData->Edges = MoveTemp(BuiltEdges->Edges);
+            StaticMesh->AddAssetUserData(UserData);
+        }
+
+        UPackage* Package = StaticMesh->GetOutermost();
+        const FString FileName = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+        FSavePackageArgs SaveArgs;
+        SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+        if(UPackage::SavePackage(Package, StaticMesh, *FileName, SaveArgs))
+        {
+            ++NumSavedMeshes;
+        }
+        else
+        {
+            UE_LOG(LogClimbLedgeEdge, Error, TEXT("Failed to save %s"), *FileName);
+            ++NumFailedSaves;
+        }
+    }
+
+    UE_LOG(LogClimbLedgeEdge, Display, TEXT("%d of %d static meshes under %s have ledge edges, %d changed and were saved"), NumMeshesWithEdges, MeshAssets.Num(), *RootPath, NumSavedMeshes);
+    return NumFailedSaves > 0 ? 1 : 0;
+#else
+    return 0;
+#endif
+}
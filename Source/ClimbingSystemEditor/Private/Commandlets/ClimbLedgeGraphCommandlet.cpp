@@ -0,0 +1,263 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Commandlets/ClimbLedgeGraphCommandlet.h"
+#include "ClimbingSystem/ClimbingSystem.h"
+#include "Data/ClimbLedgeGraph.h"
+#include "Subsystems/ClimbLedgeGraphSubsystem.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogClimbLedgeGraph, Log, All);
+
+namespace ClimbLedgeGraphBake
+{
+    // Faces lower than this are not worth climbing
+    static constexpr float MinWallHeight = 60.f;
+
+    // Obstacles this thin and this low above the ground in front can be vaulted, the runtime query narrows the height further
+    static constexpr float MaxVaultDepth = 150.f;
+    static constexpr float MinVaultHeight = 30.f;
+    static constexpr float MaxVaultHeight = 150.f;
+
+    // Furthest any climb query looks from the character
+    static constexpr float QueryReach = 300.f;
+    static constexpr float CellSize = 200.f;
+
+    // Ground further below a ledge than this is reported as this deep
+    static constexpr float GroundTraceDepth = 1000.f;
+
+    // Top edges are checked for neighbours this often, and a neighbour counts when it is within the probe offset of the face
+    static constexpr float CoverageSampleSpacing = 25.f;
+    static constexpr float CoverageProbeOffset = 5.f;
+    static constexpr float CoverageProbeRadius = 2.f;
+}
+
+UClimbLedgeGraphCommandlet::UClimbLedgeGraphCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UClimbLedgeGraphCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+    FString MapPackageName;
+    if(!FParse::Value(*Params, TEXT("Map="), MapPackageName))
+    {
+        UE_LOG(LogClimbLedgeGraph, Error, TEXT("Usage: -run=ClimbLedgeGraph -Map=/Game/Path/To/Map [-ClimbableOnly]"));
+        return 1;
+    }
+    bClimbableOnly = FParse::Param(*Params, TEXT("ClimbableOnly"));
+
+    UPackage* MapPackage = LoadPackage(nullptr, *MapPackageName, LOAD_None);
+    UWorld* World = MapPackage ? UWorld::FindWorldInPackage(MapPackage) : nullptr;
+    if(!World)
+    {
+        UE_LOG(LogClimbLedgeGraph, Error, TEXT("Could not load map %s"), *MapPackageName);
+        return 1;
+    }
+
+    // A loaded map has no physics scene until it is initialized, the bake needs traces for ground heights and neighbours
+    World->AddToRoot();
+    World->WorldType = EWorldType::Editor;
+    if(!World->bIsWorldInitialized)
+    {
+        UWorld::InitializationValues InitValues;
+        InitValues.RequiresHitProxies(false)
+            .ShouldSimulatePhysics(false)
+            .EnableTraceCollision(true)
+            .CreateNavigation(false)
+            .CreateAISystem(false)
+            .AllowAudioPlayback(false)
+            .CreatePhysicsScene(true);
+        World->InitWorld(InitValues);
+    }
+    World->UpdateWorldComponents(true, false);
+
+    const FString PackageName = UClimbLedgeGraphSubsystem::GetLedgeGraphPackageName(FPackageName::GetShortName(MapPackageName));
+    const FString AssetName = FPackageName::GetShortName(PackageName);
+    UPackage* GraphPackage = CreatePackage(*PackageName);
+    UClimbLedgeGraph* Graph = NewObject<UClimbLedgeGraph>(GraphPackage, *AssetName, RF_Public | RF_Standalone);
+
+    for(TActorIterator<AActor> ActorIt(World); ActorIt; ++ActorIt)
+    {
+        ActorIt->ForEachComponent<UPrimitiveComponent>(false, [&](UPrimitiveComponent* Component)
+        {
+            if(IsClimbableComponent(Component))
+            {
+                BakeComponent(World, Component, Graph);
+            }
+        });
+    }
+
+    Graph->BuildSpatialIndex(ClimbLedgeGraphBake::CellSize, ClimbLedgeGraphBake::QueryReach);
+
+    UE_LOG(LogClimbLedgeGraph, Display, TEXT("Baked %d ledges, %d wall patches and %d vault spans from %d primitives"),
+        Graph->Ledges.Num(), Graph->WallPatches.Num(), Graph->VaultSpans.Num(), Graph->BakedComponentPaths.Num());
+
+    const FString FileName = FPackageName::LongPackageNameToFilename(PackageName, FPackageName::GetAssetPackageExtension());
+    FSavePackageArgs SaveArgs;
+    SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+    const bool bSaved = UPackage::SavePackage(GraphPackage, Graph, *FileName, SaveArgs);
+
+    // The map was only loaded for the bake, tear its world down again
+    World->RemoveFromRoot();
+    World->DestroyWorld(false);
+
+    if(!bSaved)
+    {
+        UE_LOG(LogClimbLedgeGraph, Error, TEXT("Failed to save %s"), *FileName);
+        return 1;
+    }
+#endif
+    return 0;
+}
+
+bool UClimbLedgeGraphCommandlet::IsClimbableComponent(const UPrimitiveComponent* Component) const
+{
+    // Only static geometry is baked, everything else is traced at runtime
+    if(!Component || Component->Mobility != EComponentMobility::Static) return false;
+    if(!Component->IsQueryCollisionEnabled()) return false;
+
+    if(bClimbableOnly && Component->GetCollisionResponseToChannel(ECC_Climbable) == ECR_Ignore) return false;
+    if(!bClimbableOnly && Component->GetCollisionObjectType() != ECC_WorldStatic) return false;
+
+    return true;
+}
+
+void UClimbLedgeGraphCommandlet::BakeComponent(UWorld* World, UPrimitiveComponent* Component, UClimbLedgeGraph* Graph) const
+{
+    // The bake reads the simple collision as boxes, so only primitives whose collision is nothing but boxes qualify
+    const UBodySetup* BodySetup = Component->GetBodySetup();
+    if(!BodySetup || BodySetup->AggGeom.BoxElems.IsEmpty() || BodySetup->AggGeom.GetElementCount() != BodySetup->AggGeom.BoxElems.Num()) return;
+
+    const FTransform ComponentTransform = Component->GetComponentTransform();
+
+    // Anything tilted is left to runtime traces
+    if(!ComponentTransform.GetUnitAxis(EAxis::Z).Equals(FVector::UpVector, 0.01f)) return;
+
+    const FVector Scale = ComponentTransform.GetScale3D().GetAbs();
+    for(const FKBoxElem& BoxElem : BodySetup->AggGeom.BoxElems)
+    {
+        if(!BoxElem.Rotation.IsNearlyZero()) return;
+    }
+
+    for(const FKBoxElem& BoxElem : BodySetup->AggGeom.BoxElems)
+    {
+        const FVector Extent = FVector(BoxElem.X, BoxElem.Y, BoxElem.Z) * 0.5f * Scale;
+        const FTransform BoxTransform(ComponentTransform.GetRotation(), ComponentTransform.TransformPosition(BoxElem.Center));
+        BakeBox(World, BoxTransform, Extent, Graph);
+    }
+
+    Graph->BakedComponentPaths.Add(UClimbLedgeGraphSubsystem::GetBakedComponentKey(Component));
+}
+
+void UClimbLedgeGraphCommandlet::BakeBox(UWorld* World, const FTransform& BoxTransform, const FVector& Extent, UClimbLedgeGraph* Graph) const
+{
+    if(Extent.Z * 2.f < ClimbLedgeGraphBake::MinWallHeight) return;
+
+    const FVector Center = BoxTransform.GetLocation();
+    const FVector AxisX = BoxTransform.GetUnitAxis(EAxis::X);
+    const FVector AxisY = BoxTransform.GetUnitAxis(EAxis::Y);
+    const double TopZ = Center.Z + Extent.Z;
+
+    // Ground height in front of a face, found by tracing down just outside it
+    const FCollisionQueryParams GroundParams(SCENE_QUERY_STAT(ClimbLedgeGraphBake), false);
+    const auto FindGroundZ = [&](const FVector& Point, double& OutGroundZ)
+    {
+        FHitResult GroundHit;
+        const FVector Start(Point.X, Point.Y, TopZ);
+        if(!World->LineTraceSingleByObjectType(GroundHit, Start, Start - FVector::UpVector * ClimbLedgeGraphBake::GroundTraceDepth, FCollisionObjectQueryParams(ECC_WorldStatic), GroundParams)) return false;
+        OutGroundZ = GroundHit.ImpactPoint.Z;
+        return true;
+    };
+
+    // Four side faces, each run of a top edge no neighbour covers is a wall patch with that run as its ledge
+    const FVector FaceNormals[4] = { AxisX, -AxisX, AxisY, -AxisY };
+    const double FaceDepths[4] = { Extent.X, Extent.X, Extent.Y, Extent.Y };
+    const double FaceHalfWidths[4] = { Extent.Y, Extent.Y, Extent.X, Extent.X };
+    for(int32 Face = 0; Face < 4; ++Face)
+    {
+        const FVector& Normal = FaceNormals[Face];
+        const FVector Along = FVector::CrossProduct(FVector::UpVector, Normal);
+        const FVector FaceCenter = Center + Normal * FaceDepths[Face];
+        const FVector EdgeStart = FVector(FaceCenter.X, FaceCenter.Y, TopZ) - Along * FaceHalfWidths[Face];
+
+        const auto AddFaceRun = [&](double RunStart, double RunEnd)
+        {
+            const FVector RunCenter = EdgeStart + Along * ((RunStart + RunEnd) * 0.5);
+
+            FClimbWallPatch& Patch = Graph->WallPatches.AddDefaulted_GetRef();
+            Patch.Center = FVector3f(FVector(RunCenter.X, RunCenter.Y, Center.Z));
+            Patch.Normal = FVector3f(Normal);
+            Patch.HalfExtents = FVector2f(static_cast<float>((RunEnd - RunStart) * 0.5), static_cast<float>(Extent.Z));
+
+            // Drop is down to whatever is in front of the face, which is not the box's own bottom on a slope or a shelf
+            double ApproachGroundZ;
+            const bool bHasApproachGround = FindGroundZ(RunCenter + Normal * 50.f, ApproachGroundZ);
+
+            FClimbLedgeSegment& Ledge = Graph->Ledges.AddDefaulted_GetRef();
+            Ledge.Start = FVector3f(EdgeStart + Along * RunStart);
+            Ledge.End = FVector3f(EdgeStart + Along * RunEnd);
+            Ledge.WallNormal = FVector3f(Normal);
+            Ledge.Drop = bHasApproachGround ? static_cast<float>(TopZ - ApproachGroundZ) : ClimbLedgeGraphBake::GroundTraceDepth;
+
+            // Thin and low enough to vault over from this side, landing on the ground behind the opposite face
+            const double Depth = FaceDepths[Face] * 2.f;
+            double LandingGroundZ;
+            if(bHasApproachGround && Depth <= ClimbLedgeGraphBake::MaxVaultDepth &&
+               FindGroundZ(RunCenter - Normal * (Depth + 50.f), LandingGroundZ))
+            {
+                const double Height = TopZ - ApproachGroundZ;
+                if(Height >= ClimbLedgeGraphBake::MinVaultHeight && Height <= ClimbLedgeGraphBake::MaxVaultHeight)
+                {
+                    FClimbVaultSpan& Span = Graph->VaultSpans.AddDefaulted_GetRef();
+                    Span.Start = Ledge.Start;
+                    Span.End = Ledge.End;
+                    Span.Normal = Ledge.WallNormal;
+                    Span.Depth = static_cast<float>(Depth);
+                    Span.LandingZ = static_cast<float>(LandingGroundZ);
+                }
+            }
+        };
+
+        // Boxes placed side by side or stacked share faces, their edges are seams and not ledges, covered runs are left to runtime traces
+        const double EdgeLength = FaceHalfWidths[Face] * 2.0;
+        const int32 NumSamples = FMath::Max(1, FMath::CeilToInt(EdgeLength / ClimbLedgeGraphBake::CoverageSampleSpacing));
+        const double SampleWidth = EdgeLength / NumSamples;
+        int32 RunStartSample = INDEX_NONE;
+        for(int32 Sample = 0; Sample <= NumSamples; ++Sample)
+        {
+            const bool bCovered = Sample == NumSamples || IsFaceCoveredAt(World, EdgeStart + Along * (SampleWidth * (Sample + 0.5)), Normal);
+            if(!bCovered && RunStartSample == INDEX_NONE)
+            {
+                RunStartSample = Sample;
+            }
+            else if(bCovered && RunStartSample != INDEX_NONE)
+            {
+                AddFaceRun(SampleWidth * RunStartSample, SampleWidth * Sample);
+                RunStartSample = INDEX_NONE;
+            }
+        }
+    }
+}
+
+bool UClimbLedgeGraphCommandlet::IsFaceCoveredAt(UWorld* World, const FVector& FacePoint, const FVector& Normal) const
+{
+    // One probe just in front of the face below the edge and one just on top of the box behind the edge, neither touches the box itself
+    // The baked box is not ignored, another box of the same compound collision covers it just as well as another primitive
+    const FCollisionQueryParams Params(SCENE_QUERY_STAT(ClimbLedgeGraphCoverage), false);
+    const FCollisionObjectQueryParams ObjectParams(ECC_WorldStatic);
+    const FCollisionShape Probe = FCollisionShape::MakeSphere(ClimbLedgeGraphBake::CoverageProbeRadius);
+    const float Offset = ClimbLedgeGraphBake::CoverageProbeOffset;
+
+    return World->OverlapAnyTestByObjectType(FacePoint + Normal * Offset - FVector::UpVector * Offset, FQuat::Identity, ObjectParams, Probe, Params) ||
+           World->OverlapAnyTestByObjectType(FacePoint - Normal * Offset + FVector::UpVector * Offset, FQuat::Identity, ObjectParams, Probe, Params);
+}
@@ -0,0 +1,22 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ClimbLedgeEdgeCommandlet.generated.h"
+
+/**
+ * Stores the ledge edges of every static mesh under a path as UClimbLedgeEdgeUserData on the mesh.
+ * UnrealEditor-Cmd ClimbingSystem.uproject -run=ClimbLedgeEdge [-Path=/Game/LevelPrototyping] -nullrhi
+ */
+UCLASS()
+class CLIMBINGSYSTEMEDITOR_API UClimbLedgeEdgeCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UClimbLedgeEdgeCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,40 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ClimbLedgeGraphCommandlet.generated.h"
+
+class UClimbLedgeGraph;
+class UPrimitiveComponent;
+
+/**
+ * Bakes the ledge graph of a map.
+ * UnrealEditor-Cmd ClimbingSystem.uproject -run=ClimbLedgeGraph -Map=/Game/ThirdPerson/Maps/ThirdPersonMap [-ClimbableOnly] -nullrhi
+ */
+UCLASS()
+class CLIMBINGSYSTEMEDITOR_API UClimbLedgeGraphCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UClimbLedgeGraphCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	/** Adds ledges, walls and vault spans of every box in the primitive's collision */
+	void BakeComponent(UWorld* World, UPrimitiveComponent* Component, UClimbLedgeGraph* Graph) const;
+
+	/** Adds the parts of the four side faces of one upright box whose top edge no neighbour covers */
+	void BakeBox(UWorld* World, const FTransform& BoxTransform, const FVector& Extent, UClimbLedgeGraph* Graph) const;
+
+	/** True if static geometry sits right outside the face or right on top of it at this edge point, so the edge there is a seam inside a bigger shape */
+	bool IsFaceCoveredAt(UWorld* World, const FVector& FacePoint, const FVector& Normal) const;
+
+	bool IsClimbableComponent(const UPrimitiveComponent* Component) const;
+
+	/** Only bake geometry that does not ignore the Climbable channel, the climbable profiles overlap it */
+	bool bClimbableOnly = false;
+};
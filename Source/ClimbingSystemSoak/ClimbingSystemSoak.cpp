@@ -0,0 +1,6 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "Modules/ModuleManager.h"
+
+// Gauntlet soak of the climbing, only built into non-shipping targets so shipped games never carry Gauntlet
+IMPLEMENT_MODULE(FDefaultModuleImpl, ClimbingSystemSoak);
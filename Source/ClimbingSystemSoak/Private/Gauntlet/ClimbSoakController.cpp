@@ -0,0 +1,405 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Gauntlet/ClimbSoakController.h"
+#include "Components/BoxComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/CustomMovementComponent.h"
+#include "ClimbingSystem/ClimbingSystem.h"
+#include "ClimbingSystem/ClimbingSystemCharacter.h"
+#include "Engine/World.h"
+#include "GameFramework/GameModeBase.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Policies/PrettyJsonPrintPolicy.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "RenderCore.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+    float GetPercentile(TArray<float> Samples, float Fraction)
+    {
+        if(Samples.IsEmpty()) return 0.f;
+
+        Samples.Sort();
+        return Samples[FMath::Clamp(FMath::FloorToInt(Samples.Num() * Fraction), 0, Samples.Num() - 1)];
+    }
+
+    // Writes p50, p95 and p99 of the samples under Name
+    void WritePercentiles(TJsonWriter<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>& Writer, const TCHAR* Name, const TArray<float>& Samples)
+    {
+        Writer.WriteObjectStart(Name);
+        Writer.WriteValue(TEXT("P50"), GetPercentile(Samples, 0.5f));
+        Writer.WriteValue(TEXT("P95"), GetPercentile(Samples, 0.95f));
+        Writer.WriteValue(TEXT("P99"), GetPercentile(Samples, 0.99f));
+        Writer.WriteObjectEnd();
+    }
+
+    // Sums every Climbing column over the rows of a CSV capture, false if it cannot be read
+    bool ReadCsvClimbingTotals(const FString& CsvFile, TMap<FString, double>& OutTotals)
+    {
+        TArray<FString> Lines;
+        if(!FFileHelper::LoadFileToStringArray(Lines, *CsvFile) || Lines.IsEmpty()) return false;
+
+        TArray<FString> Columns;
+        Lines[0].ParseIntoArray(Columns, TEXT(","), false);
+
+        TArray<FString> Values;
+        for(int32 Row = 1; Row < Lines.Num(); ++Row)
+        {
+            // The header is repeated after the last frame, followed by the capture metadata
+            if(Lines[Row] == Lines[0] || Lines[Row].StartsWith(TEXT("["))) break;
+
+            Lines[Row].ParseIntoArray(Values, TEXT(","), false);
+            for(int32 Column = 0; Column < FMath::Min(Columns.Num(), Values.Num()); ++Column)
+            {
+                if(Columns[Column].StartsWith(TEXT("Climbing/")))
+                {
+                    OutTotals.FindOrAdd(Columns[Column].RightChop(9)) += FCString::Atod(*Values[Column]);
+                }
+            }
+        }
+        return true;
+    }
+}
+
+void UClimbSoakController::OnInit()
+{
+    Super::OnInit();
+
+    const TCHAR* CommandLine = FCommandLine::Get();
+    FParse::Value(CommandLine, TEXT("ClimbSoakSession="), SessionFile);
+    FParse::Value(CommandLine, TEXT("ClimbSoakBots="), NumBots);
+    FParse::Value(CommandLine, TEXT("ClimbSoakDuration="), Duration);
+    FParse::Value(CommandLine, TEXT("ClimbSoakWarmup="), WarmupTime);
+    FParse::Value(CommandLine, TEXT("ClimbSoakFrameBudgetMs="), FrameBudgetMs);
+    FParse::Value(CommandLine, TEXT("ClimbSoakMemoryBudgetMB="), MemoryBudgetMB);
+    FParse::Value(CommandLine, TEXT("ClimbSoakClimbTickBudgetUs="), ClimbTickBudgetUs);
+    NumBots = FMath::Max(NumBots, 1);
+
+    // Without a session the bots play the built-in course, built once the map is up
+    if(!SessionFile.IsEmpty() && (!Session.LoadFromFile(SessionFile) || Session.Frames.IsEmpty()))
+    {
+        UE_LOG(LogClimbing, Error, TEXT("Climb soak -ClimbSoakSession=%s is not a recorded climb session"), *SessionFile);
+        Session.Frames.Reset();
+    }
+}
+
+void UClimbSoakController::OnTick(float TimeDelta)
+{
+    Super::OnTick(TimeDelta);
+
+    if(bFinished) return;
+
+    if(!SessionFile.IsEmpty() && Session.Frames.IsEmpty())
+    {
+        bFinished = true;
+        EndTest(1);
+        return;
+    }
+
+    // The CSV is written on its own thread after the capture ends, the report needs its totals
+    if(bStopped)
+    {
+        if(!CsvFile.IsSet() || CsvFile->IsReady() || FPlatformTime::Seconds() - StartSeconds >= WarmupTime + Duration + 60.0)
+        {
+            FinishSoak();
+        }
+        return;
+    }
+
+    // Wait for the map to be playing, the soak starts with its bots
+    UWorld* World = GetWorld();
+    if(!World || !World->HasBegunPlay()) return;
+    if(Bots.IsEmpty())
+    {
+        if(SessionFile.IsEmpty())
+        {
+            BuildScriptedSession(*World);
+        }
+        SpawnBots(*World);
+        StartSeconds = FPlatformTime::Seconds();
+        return;
+    }
+
+    DriveBots();
+
+    const double NowSeconds = FPlatformTime::Seconds();
+    if(!bSampling && NowSeconds - StartSeconds > WarmupTime)
+    {
+        bSampling = true;
+
+#if CSV_PROFILER
+        // Captures the sampled frames only, unless a capture from the command line already runs
+        if(FCsvProfiler::Get() && !FCsvProfiler::Get()->IsCapturing())
+        {
+            FCsvProfiler::Get()->BeginCapture();
+            bCapturingCsv = true;
+        }
+#endif
+    }
+    if(bSampling)
+    {
+        SampleFrame();
+    }
+
+    if(NowSeconds - StartSeconds >= WarmupTime + Duration)
+    {
+        StopSoak();
+    }
+}
+
+void UClimbSoakController::BuildScriptedSession(UWorld& World)
+{
+    // High above the map so nothing of it gets in the way, a floor with a 300 high wall on it whose top is deep enough to walk on
+    const FVector CourseOrigin(0.f, 0.f, 20000.f);
+    const auto SpawnBox = [&World](const FVector& Center, const FVector& HalfExtent)
+    {
+        AActor* Box = World.SpawnActor<AActor>();
+        UBoxComponent* BoxComponent = NewObject<UBoxComponent>(Box, TEXT("Box"));
+        BoxComponent->SetBoxExtent(HalfExtent, false);
+        BoxComponent->SetCollisionProfileName(TEXT("ClimbableStatic"));
+        BoxComponent->SetWorldLocation(Center);
+        Box->SetRootComponent(BoxComponent);
+        BoxComponent->RegisterComponent();
+    };
+    SpawnBox(CourseOrigin, FVector(1500.f, 1500.f, 50.f));
+    SpawnBox(CourseOrigin + FVector(600.f, 0.f, 200.f), FVector(300.f, 1000.f, 150.f));
+
+    Session = FClimbSession();
+    Session.MapName = World.GetMapName();
+    Session.StartLocation = CourseOrigin + FVector(0.f, 0.f, 150.f);
+    Session.StartMovementMode = MOVE_Falling;
+
+    const auto AddFrames = [this](int32 NumFrames, const FVector2f& MoveInput, const FVector2f& ClimbMoveInput, float Yaw, EClimbSessionButton Buttons = EClimbSessionButton::None)
+    {
+        for(int32 Index = 0; Index < NumFrames; ++Index)
+        {
+            FClimbSessionFrame& Frame = Session.Frames.AddDefaulted_GetRef();
+            Frame.DeltaTime = 1.f / 60.f;
+            Frame.MoveInput = MoveInput;
+            Frame.ClimbMoveInput = ClimbMoveInput;
+            Frame.ControlRotation = FRotator3f(0.f, Yaw, 0.f);
+
+            // Buttons are pressed on the first frame only
+            Frame.Buttons = Index == 0 ? Buttons : EClimbSessionButton::None;
+        }
+    };
+
+    // Land and walk into the wall, then climb on. The wall face is 300 ahead along +X
+    const FVector2f Forward(0.f, 1.f);
+    AddFrames(60, FVector2f::ZeroVector, FVector2f::ZeroVector, 0.f);
+    AddFrames(60, Forward, FVector2f::ZeroVector, 0.f);
+    AddFrames(30, FVector2f::ZeroVector, FVector2f::ZeroVector, 0.f, EClimbSessionButton::Climb);
+
+    // Along the wall both ways, a hop up and on up to the ledge
+    AddFrames(90, FVector2f::ZeroVector, FVector2f(1.f, 0.f), 0.f);
+    AddFrames(90, FVector2f::ZeroVector, FVector2f(-1.f, 0.f), 0.f);
+    AddFrames(30, FVector2f::ZeroVector, FVector2f(0.f, 1.f), 0.f, EClimbSessionButton::Hop);
+    AddFrames(240, FVector2f::ZeroVector, FVector2f(0.f, 1.f), 0.f);
+
+    // Wait out the ledge up, walk in, turn back towards the edge and climb down it
+    AddFrames(120, FVector2f::ZeroVector, FVector2f::ZeroVector, 0.f);
+    AddFrames(20, Forward, FVector2f::ZeroVector, 0.f);
+    AddFrames(10, Forward, FVector2f::ZeroVector, 180.f);
+    AddFrames(120, FVector2f::ZeroVector, FVector2f::ZeroVector, 180.f, EClimbSessionButton::Climb);
+
+    UE_LOG(LogClimbing, Display, TEXT("Climb soak has no -ClimbSoakSession, looping the built-in course of %d frames"), Session.Frames.Num());
+}
+
+void UClimbSoakController::SpawnBots(UWorld& World)
+{
+    if(Session.MapName != World.GetMapName())
+    {
+        UE_LOG(LogClimbing, Warning, TEXT("Climb soak session was recorded on %s, soaking %s"), *Session.MapName, *World.GetMapName());
+    }
+
+    // The game's own pawn class has the montages the climb transitions play
+    UClass* BotClass = AClimbingSystemCharacter::StaticClass();
+    if(const AGameModeBase* GameMode = World.GetAuthGameMode())
+    {
+        if(GameMode->DefaultPawnClass && GameMode->DefaultPawnClass->IsChildOf(AClimbingSystemCharacter::StaticClass()))
+        {
+            BotClass = GameMode->DefaultPawnClass;
+        }
+    }
+
+    FActorSpawnParameters SpawnParameters;
+    SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+    // Every bot plays the same session from the same spot, staggered so they spread over it
+    const int32 StaggerFrames = FMath::Max(Session.Frames.Num() / NumBots, 1);
+    for(int32 Index = 0; Index < NumBots; ++Index)
+    {
+        AClimbingSystemCharacter* Bot = World.SpawnActor<AClimbingSystemCharacter>(BotClass, Session.StartLocation, Session.StartRotation, SpawnParameters);
+        if(!Bot) continue;
+
+        // They share the path, so they pass through each other
+        Bot->GetCapsuleComponent()->SetCollisionResponseToChannel(ECC_Pawn, ECR_Ignore);
+        Bot->SpawnDefaultController();
+
+        Bots.Add(Bot);
+        BotFrames.Add(-Index * StaggerFrames);
+    }
+
+    UE_LOG(LogClimbing, Display, TEXT("Climb soak of %d bots for %.0f s after %.0f s warmup"), Bots.Num(), Duration, WarmupTime);
+}
+
+void UClimbSoakController::DriveBots()
+{
+    for(int32 Index = 0; Index < Bots.Num(); ++Index)
+    {
+        AClimbingSystemCharacter* Bot = Bots[Index];
+        if(!Bot) continue;
+
+        int32& Frame = BotFrames[Index];
+        if(Frame < 0)
+        {
+            ++Frame;
+            continue;
+        }
+
+        if(Frame >= Session.Frames.Num())
+        {
+            RestartBot(*Bot);
+            Frame = 0;
+        }
+        Bot->ApplyClimbSessionInput(Session.Frames[Frame++]);
+    }
+}
+
+// Same start pose StartReplay puts a replaying character in
+void UClimbSoakController::RestartBot(AClimbingSystemCharacter& Bot) const
+{
+    Bot.TeleportTo(Session.StartLocation, Session.StartRotation, false, true);
+    if(AController* Controller = Bot.GetController())
+    {
+        Controller->SetControlRotation(Session.StartControlRotation);
+    }
+
+    if(UCustomMovementComponent* Movement = Bot.GetCustomeMovementComponent())
+    {
+        Movement->StopMovementImmediately();
+        Movement->SetMovementMode(static_cast<EMovementMode>(Session.StartMovementMode), Session.StartCustomMovementMode);
+    }
+}
+
+void UClimbSoakController::SampleFrame()
+{
+    // Last frame's game thread time, what stat unit shows as Game, without the wait for the render thread the wall clock frame has
+    GameThreadTimesMs.Add(static_cast<float>(FPlatformTime::ToMilliseconds(GGameThreadTime)));
+    UsedMemoryMB.Add(static_cast<float>(FPlatformMemory::GetStats().UsedPhysical / (1024.0 * 1024.0)));
+
+    for(const AClimbingSystemCharacter* Bot : Bots)
+    {
+        const UCustomMovementComponent* Movement = Bot ? Bot->GetCustomeMovementComponent() : nullptr;
+        if(!Movement) continue;
+
+        ClimbTickUs.Add(static_cast<float>(FPlatformTime::ToSeconds64(Movement->GetLastTickCycles()) * 1e6));
+        if(Movement->IsClimbing())
+        {
+            ++ClimbingBotFrames;
+        }
+    }
+}
+
+void UClimbSoakController::StopSoak()
+{
+    bStopped = true;
+
+#if CSV_PROFILER
+    if(bCapturingCsv && FCsvProfiler::Get() && FCsvProfiler::Get()->IsCapturing())
+    {
+        CsvFile = FCsvProfiler::Get()->EndCapture();
+    }
+#endif
+}
+
+void UClimbSoakController::FinishSoak()
+{
+    bFinished = true;
+
+    if(CsvFile.IsSet())
+    {
+        if(!CsvFile->IsReady() || !ReadCsvClimbingTotals(CsvFile->Get(), CsvClimbingTotals))
+        {
+            UE_LOG(LogClimbing, Warning, TEXT("Climb soak could not read its CSV capture, the report has no CSV climbing totals"));
+        }
+    }
+
+    for(const AClimbingSystemCharacter* Bot : Bots)
+    {
+        if(const UCustomMovementComponent* Movement = Bot ? Bot->GetCustomeMovementComponent() : nullptr)
+        {
+            ClimbTracesIssued += Movement->GetClimbTracesIssued();
+            ClimbTraceHits += Movement->GetClimbTraceHitsReturned();
+        }
+    }
+
+    const float GameThreadP95 = GetPercentile(GameThreadTimesMs, 0.95f);
+    const float MemoryP99 = GetPercentile(UsedMemoryMB, 0.99f);
+    const float ClimbTickP95 = GetPercentile(ClimbTickUs, 0.95f);
+
+    TArray<FString> Failures;
+    if(FrameBudgetMs > 0.f && GameThreadP95 > FrameBudgetMs)
+    {
+        Failures.Add(FString::Printf(TEXT("p95 game thread %.2f ms over the %.2f ms budget"), GameThreadP95, FrameBudgetMs));
+    }
+    if(MemoryBudgetMB > 0.f && MemoryP99 > MemoryBudgetMB)
+    {
+        Failures.Add(FString::Printf(TEXT("p99 used memory %.0f MB over the %.0f MB budget"), MemoryP99, MemoryBudgetMB));
+    }
+    if(ClimbTickBudgetUs > 0.f && ClimbTickP95 > ClimbTickBudgetUs)
+    {
+        Failures.Add(FString::Printf(TEXT("p95 climb tick %.1f us over the %.1f us budget"), ClimbTickP95, ClimbTickBudgetUs));
+    }
+
+    FString Json;
+    TSharedRef<TJsonWriter<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&Json);
+    Writer->WriteObjectStart();
+    Writer->WriteValue(TEXT("Map"), GetWorld() ? GetWorld()->GetMapName() : FString());
+    Writer->WriteValue(TEXT("Session"), SessionFile.IsEmpty() ? FString(TEXT("BuiltInCourse")) : SessionFile);
+    Writer->WriteValue(TEXT("Bots"), Bots.Num());
+    Writer->WriteValue(TEXT("Frames"), GameThreadTimesMs.Num());
+    WritePercentiles(*Writer, TEXT("GameThreadMs"), GameThreadTimesMs);
+    WritePercentiles(*Writer, TEXT("UsedMemoryMB"), UsedMemoryMB);
+    WritePercentiles(*Writer, TEXT("ClimbTickUs"), ClimbTickUs);
+    Writer->WriteValue(TEXT("ClimbTracesIssued"), static_cast<int64>(ClimbTracesIssued));
+    Writer->WriteValue(TEXT("ClimbTraceHits"), static_cast<int64>(ClimbTraceHits));
+    Writer->WriteValue(TEXT("ClimbingBotFrames"), ClimbingBotFrames);
+    Writer->WriteObjectStart(TEXT("CsvClimbingTotals"));
+    for(const TPair<FString, double>& Total : CsvClimbingTotals)
+    {
+        Writer->WriteValue(Total.Key, Total.Value);
+    }
+    Writer->WriteObjectEnd();
+    Writer->WriteArrayStart(TEXT("Failures"));
+    for(const FString& Failure : Failures)
+    {
+        Writer->WriteValue(Failure);
+    }
+    Writer->WriteArrayEnd();
+    Writer->WriteObjectEnd();
+    Writer->Close();
+
+    const FString FileName = FPaths::ProfilingDir() / TEXT("ClimbSoak") / FString::Printf(TEXT("ClimbSoak-%s.json"), *FDateTime::Now().ToString());
+    FFileHelper::SaveStringToFile(Json, *FileName);
+
+    UE_LOG(LogClimbing, Display, TEXT("Climb soak of %d bots over %d frames: game thread p50 %.2f p95 %.2f p99 %.2f ms, used memory p99 %.0f MB, climb tick p95 %.1f us. Report in %s"),
+        Bots.Num(), GameThreadTimesMs.Num(), GetPercentile(GameThreadTimesMs, 0.5f), GameThreadP95, GetPercentile(GameThreadTimesMs, 0.99f), MemoryP99, ClimbTickP95, *FileName);
+    for(const TPair<FString, double>& Total : CsvClimbingTotals)
+    {
+        UE_LOG(LogClimbing, Display, TEXT("Climb soak CSV total %s: %.2f"), *Total.Key, Total.Value);
+    }
+    for(const FString& Failure : Failures)
+    {
+        UE_LOG(LogClimbing, Error, TEXT("Climb soak failed: %s"), *Failure);
+    }
+
+    EndTest(Failures.IsEmpty() ? 0 : 1);
+}
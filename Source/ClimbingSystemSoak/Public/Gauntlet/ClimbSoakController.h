@@ -0,0 +1,94 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "Misc/Optional.h"
+#include "GauntletTestController.h"
+#include "Climbing/ClimbSession.h"
+#include "ClimbSoakController.generated.h"
+
+class AClimbingSystemCharacter;
+
+/**
+ * Gauntlet soak of the climbing on a real map. Spawns bot climbers that loop a recorded climb session,
+ * runs for a fixed time, then reports game thread time, memory and climb stats and fails the run over budget.
+ * Start it with -gauntlet=ClimbSoakController, add -ClimbSoakSession=<File> to loop a recorded session
+ * instead of the built-in course. The README lists every option.
+ */
+UCLASS()
+class CLIMBINGSYSTEMSOAK_API UClimbSoakController : public UGauntletTestController
+{
+	GENERATED_BODY()
+
+protected:
+	virtual void OnInit() override;
+	virtual void OnTick(float TimeDelta) override;
+
+private:
+	/** Put a wall with a walkable top high above the map and script a climb around it, for runs without a recorded session */
+	void BuildScriptedSession(UWorld& World);
+
+	void SpawnBots(UWorld& World);
+
+	/** Feed every bot its next frame of the session, bots at the end start it over from the recorded start pose */
+	void DriveBots();
+
+	void RestartBot(AClimbingSystemCharacter& Bot) const;
+
+	void SampleFrame();
+
+	/** Stop sampling and the CSV capture, the report waits for the capture to be written */
+	void StopSoak();
+
+	/** Write the report and end the test, failed if any budget was exceeded */
+	void FinishSoak();
+
+	/* -ClimbSoakSession, a Climb.Record session recorded on the soak map. Empty plays the built-in course */
+	FString SessionFile;
+
+	/* -ClimbSoakBots */
+	int32 NumBots = 32;
+
+	/* -ClimbSoakDuration and -ClimbSoakWarmup in seconds, nothing is sampled during the warmup */
+	float Duration = 300.f;
+	float WarmupTime = 10.f;
+
+	/* -ClimbSoakFrameBudgetMs on the p95 frame, -ClimbSoakMemoryBudgetMB on the p99 used physical memory and
+	   -ClimbSoakClimbTickBudgetUs on the p95 climb tick of one bot, zero leaves a budget unchecked */
+	float FrameBudgetMs = 33.3f;
+	float MemoryBudgetMB = 0.f;
+	float ClimbTickBudgetUs = 0.f;
+
+	FClimbSession Session;
+
+	UPROPERTY()
+	TArray<AClimbingSystemCharacter*> Bots;
+
+	/* Session frame each bot plays next, negative while it waits for its staggered start */
+	TArray<int32> BotFrames;
+
+	double StartSeconds = 0.0;
+
+	/* One entry per sampled frame, and per bot on each for the climb tick */
+	TArray<float> GameThreadTimesMs;
+	TArray<float> UsedMemoryMB;
+	TArray<float> ClimbTickUs;
+
+	/* Climb traces over the whole run, bot frames spent climbing over the sampled ones */
+	uint64 ClimbTracesIssued = 0;
+	uint64 ClimbTraceHits = 0;
+	int32 ClimbingBotFrames = 0;
+
+	/* Set while the CSV capture started at the end of the warmup runs, then the file it is written to */
+	bool bCapturingCsv = false;
+	TOptional<TSharedFuture<FString>> CsvFile;
+
+	/* Sum over the captured frames of every stat in the CSV's Climbing category */
+	TMap<FString, double> CsvClimbingTotals;
+
+	bool bSampling = false;
+	bool bStopped = false;
+	bool bFinished = false;
+};